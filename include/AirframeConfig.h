@@ -0,0 +1,96 @@
+#ifndef AIRFRAME_CONFIG_H
+#define AIRFRAME_CONFIG_H
+
+#include <stdint.h>
+#include "Mixer.h"
+#include "OutputShaping.h"
+#include "Parameters.h"
+#include "config.h"
+
+// Configuración fija de un marco, con tipos, para FlightPipeline. Todo es
+// constexpr: el compilador pliega las constantes del lazo en cada build.
+// Los valores ajustables en vuelo parten de `parameters`, que es también el
+// defecto del registro (ParameterRegistry).
+
+struct LoopConfig {
+    uint32_t rateHz;        // Lazo interno de velocidad
+    uint8_t angleDivider;   // Estimador y lazo de ángulo a rateHz / angleDivider
+};
+
+struct ImuConfig {
+    uint8_t dlpfConfig;
+    uint16_t sampleRateHz;
+    uint16_t samplesPerLoop;  // Muestras del FIFO que forman un tick
+    uint16_t burstSamples;    // Máximo de muestras drenadas por tick
+    float gyroSensitivity;    // LSB/(grados/s)
+    float accelSensitivity;   // LSB/g
+    float filterRateHz;       // Frecuencia a la que corren los filtros de los sensores
+};
+
+struct GyroCalConfig {
+    uint16_t blockSamples;
+    uint16_t blocks;
+    int32_t stillRange;     // Cuentas pico a pico
+    float toleranceDps;
+};
+
+struct DynamicNotchConfig {
+    bool enable;
+    uint8_t count;          // Muescas por eje
+    float minHz;
+    float maxHz;            // Por debajo de Nyquist de imu.filterRateHz
+    float threshold;        // Un pico debe superar la media del rango por este factor
+    float smoothing;        // Seguimiento de la frecuencia por análisis (0-1]
+};
+
+struct EscConfig {
+    uint8_t motorCount;
+    int minPulse;           // us
+    int maxPulse;           // us
+    int armPulse;           // us
+    uint32_t armTimeUs;     // Pulso mínimo antes de permitir armar
+    uint8_t pins[MIXER_MAX_MOTORS];
+};
+
+struct FailsafeConfig {
+    uint32_t holdUs;
+    uint32_t landUs;
+    uint32_t rampUs;
+};
+
+struct InterpolationConfig {
+    uint32_t minUs;
+    uint32_t maxUs;
+};
+
+struct AirframeConfig {
+    int frame;              // FRAME_*
+    LoopConfig loop;
+    ImuConfig imu;
+    GyroCalConfig gyroCal;
+    DynamicNotchConfig dynamicNotch;
+    EscConfig esc;
+    FailsafeConfig failsafe;
+    InterpolationConfig interpolation;
+    OutputShapingConfig shaping;
+    FlightParameters parameters;
+};
+
+// Marco de config.h
+constexpr AirframeConfig DEFAULT_AIRFRAME_CONFIG = {
+    FRAME_TYPE,
+    { LOOP_FREQUENCY, ANGLE_LOOP_DIVIDER },
+    { IMU_DLPF_CONFIG, IMU_SAMPLE_RATE_HZ, IMU_SAMPLES_PER_LOOP, IMU_FIFO_BURST_SAMPLES,
+      GYRO_SENSITIVITY, ACCEL_SENSITIVITY, GYRO_FILTER_RATE_HZ },
+    { GYRO_CAL_BLOCK_SAMPLES, GYRO_CAL_BLOCKS, GYRO_CAL_STILL_RANGE, GYRO_CAL_TOLERANCE_DPS },
+    { DYN_NOTCH_ENABLE != 0, DYN_NOTCH_COUNT, DYN_NOTCH_MIN_HZ, DYN_NOTCH_MAX_HZ,
+      DYN_NOTCH_THRESHOLD, DYN_NOTCH_SMOOTHING },
+    { NUM_MOTORS, ESC_MIN_PULSE, ESC_MAX_PULSE, ESC_ARM_PULSE, ESC_ARM_TIME_US,
+      { PIN_ESC_1, PIN_ESC_2, PIN_ESC_3, PIN_ESC_4, PIN_ESC_5, PIN_ESC_6, PIN_ESC_7, PIN_ESC_8 } },
+    { FAILSAFE_HOLD_US, FAILSAFE_LAND_US, FAILSAFE_RAMP_US },
+    { INPUT_INTERPOLATION_MIN_US, INPUT_INTERPOLATION_MAX_US },
+    { THROTTLE_CURVE_MID, THROTTLE_CURVE_EXPO, THRUST_LINEARIZATION },
+    DEFAULT_FLIGHT_PARAMETERS
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "config.h"
+
+#if ENABLE_BENCHMARKS
+
+#if TARGET_BOARD
+#include <Arduino.h>
+typedef Print BenchmarkStream;
+#else
+#include <stdio.h>
+typedef FILE BenchmarkStream;
+#endif
+
+// Microbenchmarks de los núcleos del lazo de control sobre trazas de entrada
+// generadas con semilla fija. Cada núcleo escribe una línea JSON con el coste
+// por llamada (ver tools/bench_compare.py): ciclos de CPU en la placa, ns en
+// el host (pio run -e native_bench -t exec). Usa sus propias instancias, así
+// que puede ejecutarse con el controlador en marcha, pero ocupa la tarea que
+// lo llama durante unas decenas de ms.
+void runBenchmarks(BenchmarkStream& out);
+
+#endif
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef BLACKBOX_H
+#define BLACKBOX_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "BlackboxEncoder.h"
+#include "BlackboxWriter.h"
+#include "FlashStore.h"
+#include "FlightController.h"
+#include "SpscRing.h"
+#include "config.h"
+
+// Registro de vuelo. La tarea de control codifica un registro por iteración
+// en un buffer circular en PSRAM mientras está armado; la tarea de
+// comunicaciones lo vuelca a la flash en segundo plano (BlackboxWriter).
+// Cada armado abre una sesión nueva a continuación de las anteriores hasta
+// llenar la partición.
+class Blackbox {
+private:
+    SpscByteRing ring;
+    BlackboxEncoder encoder;
+    BlackboxWriter writer;
+    bool ready;
+
+    // Tarea de control
+    bool recording;
+    uint32_t seenEraseCount;
+    std::atomic<uint32_t> recordCount;
+    std::atomic<uint32_t> droppedRecords;
+
+public:
+    Blackbox();
+
+    // Reserva el buffer en PSRAM y localiza el final del registro en la flash
+    bool init(FlashStore& flash);
+    bool isReady() const { return ready; }
+
+    // Tarea de control: llamar a LOOP_FREQUENCY / BLACKBOX_RATE_DIVIDER
+    void sample(const FlightController& controller, uint32_t timestampUs);
+
+    // Tarea de comunicaciones: volcar una página a la flash
+    void flush(bool armed);
+
+    // Tarea de comunicaciones (crítica): avanzar un sector del borrado
+    void continueErase(bool armed) { writer.eraseStep(armed); }
+
+    // Borra la partición completa en segundo plano (sólo desarmado)
+    void requestErase() { writer.requestErase(); }
+    bool isErasing() const { return writer.isErasing(); }
+
+    size_t getUsedBytes() const { return writer.getUsedBytes(); }
+    size_t getCapacity() const { return writer.getCapacity(); }
+    size_t getBufferedBytes() const { return ring.size(); }
+    bool isFull() const { return writer.isFull(); }
+    uint32_t getRecordCount() const { return recordCount.load(std::memory_order_relaxed); }
+    uint32_t getDroppedRecords() const { return droppedRecords.load(std::memory_order_relaxed); }
+    uint32_t getWriteErrors() const { return writer.getWriteErrors(); }
+};
+
+extern Blackbox blackbox;
+
+#endif
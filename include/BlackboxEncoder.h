@@ -0,0 +1,107 @@
+#ifndef BLACKBOX_ENCODER_H
+#define BLACKBOX_ENCODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Formato del registro de vuelo (ver tools/blackbox_decode.py):
+//
+//   Cabecera de sesión: "BBX1", versión, nº de campos, frecuencia (u16 LE)
+//                       y por cada campo "nombre:escala\0"
+//   Registro:           'I' (keyframe) o 'P' (delta) + un varint zigzag
+//                       por campo; los 'P' guardan la diferencia con el
+//                       registro anterior y los 'I' el valor absoluto.
+//
+// Los campos son enteros en punto fijo; valor real = campo / escala.
+
+#define BLACKBOX_MAGIC          "BBX1"
+#define BLACKBOX_VERSION        1
+#define BLACKBOX_KEYFRAME       'I'
+#define BLACKBOX_DELTA          'P'
+
+// X(identificador, nombre en el CSV, escala)
+#define BLACKBOX_FIELD_LIST(X) \
+    X(TIME,        "time_us",      1)   \
+    X(GYRO_RAW_X,  "gyro_raw_x",   1)   \
+    X(GYRO_RAW_Y,  "gyro_raw_y",   1)   \
+    X(GYRO_RAW_Z,  "gyro_raw_z",   1)   \
+    X(ACC_RAW_X,   "acc_raw_x",    1)   \
+    X(ACC_RAW_Y,   "acc_raw_y",    1)   \
+    X(ACC_RAW_Z,   "acc_raw_z",    1)   \
+    X(ROLL,        "roll",         100) \
+    X(PITCH,       "pitch",        100) \
+    X(YAW,         "yaw",          100) \
+    X(ROLL_RATE,   "roll_rate",    10)  \
+    X(PITCH_RATE,  "pitch_rate",   10)  \
+    X(YAW_RATE,    "yaw_rate",     10)  \
+    X(ACCEL_X,     "accel_x",      100) \
+    X(ACCEL_Y,     "accel_y",      100) \
+    X(ACCEL_Z,     "accel_z",      100) \
+    X(THROTTLE,    "throttle",     10)  \
+    X(ROLL_CMD,    "roll_cmd",     10)  \
+    X(PITCH_CMD,   "pitch_cmd",    10)  \
+    X(YAW_CMD,     "yaw_cmd",      10)  \
+    X(FLAGS,       "flags",        1)   \
+    X(ROLL_P,      "roll_p",       10)  \
+    X(ROLL_I,      "roll_i",       10)  \
+    X(ROLL_D,      "roll_d",       10)  \
+    X(PITCH_P,     "pitch_p",      10)  \
+    X(PITCH_I,     "pitch_i",      10)  \
+    X(PITCH_D,     "pitch_d",      10)  \
+    X(YAW_P,       "yaw_p",        10)  \
+    X(YAW_I,       "yaw_i",        10)  \
+    X(YAW_D,       "yaw_d",        10)  \
+    X(MOTOR_1,     "motor1",       1)   \
+    X(MOTOR_2,     "motor2",       1)   \
+    X(MOTOR_3,     "motor3",       1)   \
+    X(MOTOR_4,     "motor4",       1)   \
+    X(MOTOR_5,     "motor5",       1)   \
+    X(MOTOR_6,     "motor6",       1)   \
+    X(MOTOR_7,     "motor7",       1)   \
+    X(MOTOR_8,     "motor8",       1)
+
+#define BLACKBOX_FIELD_ENUM(id, name, scale) BLACKBOX_##id,
+enum BlackboxField {
+    BLACKBOX_FIELD_LIST(BLACKBOX_FIELD_ENUM)
+    BLACKBOX_FIELD_COUNT
+};
+#undef BLACKBOX_FIELD_ENUM
+
+// Bits del campo FLAGS
+#define BLACKBOX_FLAG_ARMED     0x01
+#define BLACKBOX_FLAG_ARM_CMD   0x02
+#define BLACKBOX_FLAG_DISARM_CMD 0x04
+#define BLACKBOX_FLAG_ACRO      0x08
+#define BLACKBOX_FLAG_FAILSAFE_SHIFT 4  // Bits 4-5: FailsafeState
+
+// Peor caso de un registro: tipo + 5 bytes por varint de 32 bits
+#define BLACKBOX_MAX_RECORD     (1 + BLACKBOX_FIELD_COUNT * 5)
+
+// Código puro, sin dependencias del hardware
+class BlackboxEncoder {
+private:
+    int32_t previous[BLACKBOX_FIELD_COUNT];
+    uint16_t keyframeInterval;
+    uint16_t sinceKeyframe;
+    bool keyframePending;
+
+public:
+    explicit BlackboxEncoder(uint16_t keyframeInterval);
+
+    // Cabecera de sesión; devuelve su longitud (0 si no cabe en maxLength)
+    static size_t writeHeader(uint8_t* output, size_t maxLength, uint16_t loopFrequencyHz);
+
+    // Codifica un registro en `output` (BLACKBOX_MAX_RECORD bytes)
+    size_t encode(const int32_t fields[BLACKBOX_FIELD_COUNT], uint8_t* output);
+
+    // El siguiente registro será un keyframe (inicio de sesión o registro perdido)
+    void forceKeyframe() { keyframePending = true; }
+};
+
+// Varint LEB128 y zigzag (los valores pequeños de cualquier signo ocupan 1 byte)
+size_t writeVarint(uint32_t value, uint8_t* output);
+static inline uint32_t zigzagEncode(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+#endif
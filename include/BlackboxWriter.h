@@ -0,0 +1,71 @@
+#ifndef BLACKBOX_WRITER_H
+#define BLACKBOX_WRITER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "FlashStore.h"
+#include "SpscRing.h"
+
+#define BLACKBOX_PAGE_SIZE      256   // Página de programación de la flash SPI
+
+// Lado de la flash del registro de vuelo: consume el buffer circular y lo
+// escribe en la partición a continuación de las sesiones anteriores. El
+// trabajo va en pasos cortos para el planificador de comunicaciones:
+//
+//   writeStep  programa como mucho una página (sin cruzar su límite), unos
+//              cientos de us: cabe en un tick
+//   eraseStep  borra un sector; tarda decenas de ms, así que sólo avanza
+//              desarmado y se registra como tarea crítica (sin aplazar)
+//
+// Código puro, sin dependencias del hardware: se prueba con una flash en
+// fichero (test/helpers/FileFlashStore.h).
+class BlackboxWriter {
+private:
+    enum State {
+        STATE_IDLE,
+        STATE_ERASING,
+    };
+
+    FlashStore* store;
+    SpscByteRing* ring;
+    State state;
+    size_t writeOffset;
+    size_t eraseOffset;
+    uint32_t writeErrors;
+    std::atomic<bool> storeFull;
+    std::atomic<bool> eraseRequested;
+    std::atomic<uint32_t> eraseCount;
+    uint8_t page[BLACKBOX_PAGE_SIZE];
+
+    bool isSectorBlank(size_t offset);
+    size_t findWriteOffset();
+
+public:
+    BlackboxWriter();
+
+    // Localiza el final del registro en la flash; `ring` es el buffer del que
+    // este objeto es el único consumidor
+    bool begin(FlashStore& flash, SpscByteRing& buffer);
+
+    // Una página del buffer a la flash; false si no había nada que hacer
+    bool writeStep();
+
+    // Un sector del borrado pedido con requestErase; false si no había nada
+    bool eraseStep(bool armed);
+
+    // Borra la partición completa en segundo plano (sólo desarmado)
+    void requestErase() { eraseRequested.store(true); }
+
+    // Leídos también desde la tarea de control
+    bool isFull() const { return storeFull.load(std::memory_order_relaxed); }
+    bool isErasePending() const { return eraseRequested.load(std::memory_order_relaxed); }
+    uint32_t getEraseCount() const { return eraseCount.load(std::memory_order_acquire); }
+
+    bool isErasing() const { return state == STATE_ERASING || isErasePending(); }
+    size_t getUsedBytes() const { return writeOffset; }
+    size_t getCapacity() const { return store ? store->size() : 0; }
+    uint32_t getWriteErrors() const { return writeErrors; }
+};
+
+#endif
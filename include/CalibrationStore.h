@@ -0,0 +1,21 @@
+#ifndef CALIBRATION_STORE_H
+#define CALIBRATION_STORE_H
+
+#include <stdint.h>
+
+// Offsets del giroscopio persistidos en NVS (Preferences). Se guardan con
+// una versión de formato: si cambia la escala o el punto fijo, los offsets
+// antiguos se ignoran y se recalibra.
+class CalibrationStore {
+private:
+    const char* nvsNamespace;
+
+public:
+    explicit CalibrationStore(const char* name) : nvsNamespace(name) {}
+
+    // Devuelve false si no hay offsets válidos guardados
+    bool load(int32_t offsets[3]);
+    bool save(const int32_t offsets[3]);
+};
+
+#endif
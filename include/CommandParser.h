@@ -0,0 +1,102 @@
+#ifndef COMMAND_PARSER_H
+#define COMMAND_PARSER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "Framing.h"
+
+#define COMMAND_FRAME_STICKS    0x10
+
+// Bits de `flags` de la trama de mandos
+#define COMMAND_FLAG_ARM        0x01  // Interruptor de armado: flanco de subida arma, bajo desarma
+#define COMMAND_FLAG_ACRO       0x02  // Modo acro
+#define COMMAND_FLAG_KILL       0x04  // Parada de emergencia (mientras esté activo)
+
+// Tramas con secuencia hasta este número por detrás de la última aceptada se
+// consideran duplicadas o desordenadas; más atrás, un reinicio del emisor.
+#define COMMAND_STALE_WINDOW    32
+
+// Tras una trama válida el teclado queda bloqueado este tiempo: si se pierde
+// un delimitador, el cuerpo de la trama siguiente no puede llegar como teclas
+#define COMMAND_KEY_LOCKOUT_US  1000000
+#define COMMAND_CONSOLE_LINE    64    // Línea '$' más larga que se entrega
+
+// Trama de mandos absolutos. Valores en 0.1% como en la telemetría.
+struct __attribute__((packed)) CommandFrame {
+    uint8_t type;           // COMMAND_FRAME_STICKS
+    uint16_t sequence;
+    int16_t throttle;       // 0..1000
+    int16_t roll;           // -1000..1000
+    int16_t pitch;
+    int16_t yaw;
+    uint8_t flags;
+};
+
+// Mandos decodificados, listos para pasar a ControlInputs
+struct StickCommand {
+    float throttle;         // 0-100%
+    float rollCmd;          // -100 a 100%
+    float pitchCmd;
+    float yawCmd;
+    bool armCmd;            // Flanco de subida del interruptor de armado
+    bool disarmCmd;         // Interruptor bajado o parada de emergencia
+    bool acroMode;
+    bool kill;
+};
+
+// Separa el flujo de la UART en tramas COBS de mandos y bytes de teclado.
+// Una trama empieza con un delimitador 0x00 y termina con el siguiente; los
+// bytes fuera de tramas son teclas, salvo con el enlace binario activo: ahí
+// sólo pasan las líneas '$' de la consola y el resto se descarta. Una línea
+// '$' se retiene hasta su fin y se entrega entera sólo si es texto; si la
+// corta un delimitador o un byte binario, se descarta. Se procesa el bloque
+// leído entero y sólo se conserva el mando más reciente. Código puro, sin
+// Arduino.
+class CommandParser {
+private:
+    uint8_t frameBuffer[COBS_MAX_ENCODED(sizeof(CommandFrame) + FRAME_CRC_BYTES) + 8];
+    size_t frameLength;
+    bool inFrame;
+    bool overflow;
+
+    bool hasSequence;
+    uint16_t lastSequence;
+    bool armSwitch;
+    bool linkSeen;
+    uint32_t lastValidFrameUs;
+    char consoleLine[COMMAND_CONSOLE_LINE];
+    size_t consoleLength;
+
+    StickCommand latest;
+    bool fresh;
+
+    uint32_t validFrames;
+    uint32_t invalidFrames;
+    uint32_t staleFrames;
+    uint32_t lostFrames;
+    uint32_t droppedKeys;
+
+    void handleFrame(uint32_t nowUs);
+    void handleKey(uint8_t byte, uint32_t nowUs, char* keys, size_t& keyCount, size_t maxKeys);
+    void dropConsoleLine();
+
+public:
+    CommandParser();
+    void reset();
+
+    // Procesa `length` bytes recibidos en `nowUs`. Las teclas aceptadas fuera
+    // de las tramas se copian a `keys` (hasta `maxKeys`) y se devuelve cuántas
+    // hay. Con `maxKeys` >= length + COMMAND_CONSOLE_LINE no se pierde ninguna.
+    size_t feed(const uint8_t* data, size_t length, uint32_t nowUs, char* keys, size_t maxKeys);
+
+    // Devuelve el último mando recibido desde la llamada anterior
+    bool takeCommand(StickCommand& command);
+
+    uint32_t getValidFrames() const { return validFrames; }
+    uint32_t getInvalidFrames() const { return invalidFrames; }
+    uint32_t getStaleFrames() const { return staleFrames; }
+    uint32_t getLostFrames() const { return lostFrames; }
+    uint32_t getDroppedKeys() const { return droppedKeys; }
+};
+
+#endif
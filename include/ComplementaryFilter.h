@@ -0,0 +1,30 @@
+#ifndef COMPLEMENTARY_FILTER_H
+#define COMPLEMENTARY_FILTER_H
+
+// Estimador de actitud por filtro complementario en cada eje: integra el
+// giroscopio y lo corrige con los ángulos del acelerómetro. Yaw sólo con el
+// giroscopio (sin magnetómetro). Misma interfaz que MahonyAHRS.
+class ComplementaryFilter {
+public:
+    struct Config {
+        float gyroWeight;   // Peso de la integración del giroscopio (0-1)
+    };
+
+private:
+    float gyroWeight;
+    float roll, pitch, yaw;     // Grados
+
+public:
+    explicit ComplementaryFilter(const Config& config);
+
+    // Giroscopio en rad/s, acelerómetro en cualquier unidad, dt en segundos
+    void update(float gx, float gy, float gz, float ax, float ay, float az, float dt);
+    void reset();
+
+    // Ángulos de Euler en grados (yaw en 0-360)
+    float getRoll() const { return roll; }
+    float getPitch() const { return pitch; }
+    float getYaw() const { return yaw; }
+};
+
+#endif
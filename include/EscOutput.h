@@ -0,0 +1,48 @@
+#ifndef ESC_OUTPUT_H
+#define ESC_OUTPUT_H
+
+#include <Arduino.h>
+#include "EscProtocol.h"
+#include "Hal.h"
+#include "config.h"
+
+#if ESC_PROTOCOL == ESC_PROTOCOL_PWM
+#include <ESP32Servo.h>
+#endif
+
+#if ESC_PROTOCOL >= ESC_PROTOCOL_DSHOT150
+#include "driver/rmt.h"
+#endif
+
+// Salida a los ESC con el protocolo elegido en config.h (ESC_PROTOCOL).
+// Todos los motores se escriben juntos en cada llamada a write(). Los
+// métodos están en EscOutput.cpp, instanciados para el marco de config.h.
+template <int MotorCount>
+class EscOutput final : public MotorOutput<MotorCount> {
+private:
+    uint8_t pins[MotorCount];
+    bool initialized;
+
+#if ESC_PROTOCOL == ESC_PROTOCOL_PWM
+    Servo servos[MotorCount];
+#elif ESC_PROTOCOL >= ESC_PROTOCOL_DSHOT150
+    DshotBitTicks bitTicks;
+    rmt_item32_t items[MotorCount][DSHOT_FRAME_BITS + 1];  // +1 marca de fin
+
+    void encodeDshot(rmt_item32_t* frameItems, uint16_t frame);
+#else
+    uint8_t ledcResolutionBits;
+    uint32_t ledcPeriodNs;
+#endif
+
+public:
+    EscOutput();
+
+    // Configura el periférico para cada pin
+    bool init(const uint8_t* motorPins) override;
+    void write(const int (&pulsesUs)[MotorCount]) override;
+};
+
+extern template class EscOutput<NUM_MOTORS>;
+
+#endif
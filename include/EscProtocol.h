@@ -0,0 +1,53 @@
+#ifndef ESC_PROTOCOL_H
+#define ESC_PROTOCOL_H
+
+#include <stdint.h>
+
+// Protocolos de salida a los ESC
+#define ESC_PROTOCOL_PWM        0   // PWM de servo (ESP32Servo)
+#define ESC_PROTOCOL_ONESHOT125 1   // Pulso de 125-250 us (LEDC)
+#define ESC_PROTOCOL_MULTISHOT  2   // Pulso de 5-25 us (LEDC)
+#define ESC_PROTOCOL_DSHOT150   3   // Tramas digitales de 16 bits (RMT)
+#define ESC_PROTOCOL_DSHOT300   4
+#define ESC_PROTOCOL_DSHOT600   5
+
+#define DSHOT_FRAME_BITS        16
+#define DSHOT_MIN_THROTTLE      48    // 0 = parada, 1-47 = comandos especiales
+#define DSHOT_MAX_THROTTLE      2047
+
+// Tiempos de bit de DShot en nanosegundos
+struct DshotTiming {
+    uint32_t bitNs;     // Periodo de bit
+    uint32_t oneHighNs; // Nivel alto de un '1' (75%)
+    uint32_t zeroHighNs;// Nivel alto de un '0' (37.5%)
+};
+
+// Duraciones de un bit en ticks del periférico
+struct DshotBitTicks {
+    uint16_t oneHigh, oneLow;
+    uint16_t zeroHigh, zeroLow;
+};
+
+// Código puro, sin dependencias del hardware, para poder probarlo en el host
+
+bool escProtocolIsDshot(int protocol);
+
+// Devuelve los tiempos de bit del protocolo DShot, o nullptr si no es DShot
+const DshotTiming* dshotTiming(int protocol);
+
+// Convierte los tiempos de bit a ticks de un reloj de `tickNs` nanosegundos
+bool dshotBitTicks(int protocol, uint32_t tickNs, DshotBitTicks& ticks);
+
+// Valor DShot (0 o 48-2047) para un pulso de ESC_MIN_PULSE..ESC_MAX_PULSE
+uint16_t dshotValueFromPulse(int pulseUs, int minPulseUs, int maxPulseUs);
+
+// Trama de 16 bits: 11 de valor, 1 de petición de telemetría y 4 de CRC
+uint16_t dshotEncodeFrame(uint16_t value, bool telemetryRequest);
+
+// Anchura del pulso analógico (ns) de OneShot125 o Multishot
+uint32_t escAnalogPulseNs(int protocol, int pulseUs, int minPulseUs, int maxPulseUs);
+
+// Frecuencia de refresco del PWM de LEDC para los protocolos analógicos
+uint32_t escAnalogFrequencyHz(int protocol);
+
+#endif
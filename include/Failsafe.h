@@ -0,0 +1,41 @@
+#ifndef FAILSAFE_H
+#define FAILSAFE_H
+
+#include <stdint.h>
+
+enum FailsafeState {
+    FAILSAFE_IDLE,      // Enlace correcto (o sin enlace binario)
+    FAILSAFE_HOLD,      // Enlace perdido: nivelar y mantener throttle
+    FAILSAFE_LANDING,   // Rampa de throttle hacia cero (no se recupera)
+    FAILSAFE_DISARMED   // Desarmado por failsafe hasta que vuelva el enlace
+};
+
+// Failsafe escalonado según el tiempo desde la última trama de mandos.
+// Sin enlace binario activo (sólo teclado) no interviene. Código puro:
+// la tarea de control lo evalúa en cada tick con su propio reloj.
+class Failsafe {
+private:
+    FailsafeState state;
+    uint32_t holdAfterUs;       // Hueco que activa HOLD
+    uint32_t landAfterUs;       // Hueco que activa LANDING
+    uint32_t rampUs;            // Duración de la rampa de throttle
+    uint32_t landingStartUs;
+    float landingThrottle;      // Throttle al empezar la rampa
+    float throttle;             // Throttle impuesto en HOLD/LANDING
+    bool linkLost;              // Enlace binario activo pero sin tramas recientes
+
+public:
+    Failsafe(uint32_t holdUs, uint32_t landUs, uint32_t rampDurationUs);
+
+    // `commandedThrottle` es el último throttle del piloto (0-100%)
+    FailsafeState update(uint32_t nowUs, uint32_t lastFrameUs, bool linkActive,
+                         bool armed, float commandedThrottle);
+    void reset();
+
+    FailsafeState getState() const { return state; }
+    bool isActive() const { return state == FAILSAFE_HOLD || state == FAILSAFE_LANDING; }
+    float getThrottle() const { return throttle; }
+    bool isLinkLost() const { return linkLost; }
+};
+
+#endif
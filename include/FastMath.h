@@ -0,0 +1,63 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Matemática en precisión simple para el bucle de control. La FPU del ESP32
+// sólo trabaja en float, así que se evitan double, sqrt y atan2 de libm.
+
+#define FAST_PI             3.14159265f
+#define FAST_HALF_PI        1.57079633f
+#define RAD_TO_DEG_F        57.2957795f
+#define DEG_TO_RAD_F        0.0174532925f
+
+// 1/sqrt(x) con dos iteraciones de Newton (error relativo < 5e-6)
+static inline float fastInvSqrt(float x) {
+    float halfX = 0.5f * x;
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    bits = 0x5f3759df - (bits >> 1);
+    float y;
+    memcpy(&y, &bits, sizeof(y));
+    y = y * (1.5f - halfX * y * y);
+    return y * (1.5f - halfX * y * y);
+}
+
+static inline float fastSqrt(float x) {
+    return x > 0.0f ? x * fastInvSqrt(x) : 0.0f;
+}
+
+// atan(z) para |z| <= 1, polinomio minimax (error < 1e-5 rad)
+static inline float fastAtanUnit(float z) {
+    float z2 = z * z;
+    return z * (0.9998660f + z2 * (-0.3302995f + z2 * (0.1801410f +
+           z2 * (-0.0851330f + z2 * 0.0208351f))));
+}
+
+static inline float fastAtan2(float y, float x) {
+    float absY = y < 0.0f ? -y : y;
+    float absX = x < 0.0f ? -x : x;
+    if (absX == 0.0f && absY == 0.0f) return 0.0f;
+
+    float angle;
+    if (absX >= absY) {
+        angle = fastAtanUnit(absY / absX);
+    } else {
+        angle = FAST_HALF_PI - fastAtanUnit(absX / absY);
+    }
+    if (x < 0.0f) angle = FAST_PI - angle;
+    return y < 0.0f ? -angle : angle;
+}
+
+// asin(x) según Abramowitz-Stegun 4.4.45 (error < 1e-4 rad)
+static inline float fastAsin(float x) {
+    float absX = x < 0.0f ? -x : x;
+    if (absX >= 1.0f) return x < 0.0f ? -FAST_HALF_PI : FAST_HALF_PI;
+
+    float poly = 1.5707288f + absX * (-0.2121144f + absX * (0.0742610f - absX * 0.0187293f));
+    float angle = FAST_HALF_PI - fastSqrt(1.0f - absX) * poly;
+    return x < 0.0f ? -angle : angle;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,66 @@
+#ifndef FILTERS_H
+#define FILTERS_H
+
+#define FILTER_AXES         3
+#define FILTER_MAX_STAGES   4
+
+// Biquad de un canal (forma directa II transpuesta). Se usa en el término D
+// de cada PID. Los coeficientes se calculan una vez al configurar.
+struct Biquad {
+    float b0, b1, b2, a1, a2;
+    float z1, z2;
+
+    Biquad() { setPassthrough(); }
+
+    void setPassthrough();
+    void setLowpass(float cutoffHz, float sampleRateHz, float q = 0.7071f);
+    void setNotch(float centerHz, float sampleRateHz, float q);
+    void reset() { z1 = z2 = 0.0f; }
+
+    inline float apply(float x) {
+        float y = b0 * x + z1;
+        z1 = b1 * x - a1 * y + z2;
+        z2 = b2 * x - a2 * y;
+        return y;
+    }
+};
+
+// Banco de biquads en cascada para los tres ejes a la vez. Cada etapa guarda
+// coeficientes y estado como estructura de arrays, así el bucle interno
+// recorre los tres ejes con los mismos accesos y la misma etapa.
+class BiquadBank {
+private:
+    struct Stage {
+        float b0[FILTER_AXES], b1[FILTER_AXES], b2[FILTER_AXES];
+        float a1[FILTER_AXES], a2[FILTER_AXES];
+        float z1[FILTER_AXES], z2[FILTER_AXES];
+    };
+
+    Stage stages[FILTER_MAX_STAGES];
+    int stageCount;
+    float sampleRate;
+
+    int addStage(const Biquad& coefficients);
+
+public:
+    BiquadBank();
+
+    // Borra las etapas y fija la frecuencia de muestreo
+    void init(float sampleRateHz);
+
+    // Devuelven el índice de la etapa, o -1 si está desactivada (0 Hz),
+    // por encima de Nyquist o no quedan etapas libres
+    int addLowpass(float cutoffHz, float q = 0.7071f);
+    int addNotch(float centerHz, float q);
+
+    // Reajustar una etapa de muesca de un eje sin perder su estado
+    void setNotch(int stage, int axis, float centerHz, float q);
+
+    void apply(float values[FILTER_AXES]);
+    void reset();
+
+    int getStageCount() const { return stageCount; }
+    float getSampleRate() const { return sampleRate; }
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef FLASH_STORE_H
+#define FLASH_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Interfaz mínima de almacenamiento en flash para el registro de vuelo.
+// Las escrituras sólo pueden pasar bits de 1 a 0: hay que borrar el sector antes.
+class FlashStore {
+public:
+    virtual ~FlashStore() {}
+    virtual size_t size() const = 0;
+    virtual size_t sectorSize() const = 0;
+    virtual bool read(size_t offset, uint8_t* data, size_t length) = 0;
+    virtual bool write(size_t offset, const uint8_t* data, size_t length) = 0;
+    virtual bool eraseSector(size_t offset) = 0;
+};
+
+#endif
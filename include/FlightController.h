@@ -1,71 +1,38 @@
 #ifndef FLIGHT_CONTROLLER_H
 #define FLIGHT_CONTROLLER_H
 
-#include <Adafruit_MPU6050.h>
-#include <Adafruit_Sensor.h>
-#include <ESP32Servo.h>
+#include "AirframeConfig.h"
+#include "ComplementaryFilter.h"
+#include "EscOutput.h"
+#include "FlightPipeline.h"
+#include "ImuSource.h"
+#include "MahonyAHRS.h"
+#include "Mixer.h"
 #include "PID.h"
 #include "config.h"
 
-struct FlightData {
-    float roll, pitch, yaw;
-    float rollRate, pitchRate, yawRate;
-    float accelX, accelY, accelZ;
-    bool armed;
-};
+// Marco de config.h: MPU6050, estimador elegido con ATTITUDE_ESTIMATOR, PID
+// por eje, mezclador por tabla y ESC con el protocolo de ESC_PROTOCOL
+struct DefaultAirframe {
+    static constexpr AirframeConfig config = DEFAULT_AIRFRAME_CONFIG;
 
-struct ControlInputs {
-    float throttle;    // 0-100%
-    float rollCmd;     // -100 to 100%
-    float pitchCmd;    // -100 to 100%
-    float yawCmd;      // -100 to 100%
-    bool armCmd;
-    bool disarmCmd;
-};
+    using Sensor = Mpu6050Source;
+    using Controller = PIDController;
+    using MotorMixer = Mixer;
+    using Output = EscOutput<config.esc.motorCount>;
 
-class FlightController {
-private:
-    // Sensores
-    Adafruit_MPU6050 mpu;
-    
-    // Servos para ESCs
-    Servo esc1, esc2, esc3, esc4;
-    
-    // Controladores PID
-    PIDController pidRoll;
-    PIDController pidPitch;
-    PIDController pidYaw;
-    
-    // Variables de estado
-    FlightData flightData;
-    ControlInputs inputs;
-    
-    // Timing
-    unsigned long lastLoopTime;
-    float deltaTime;
-    
-    // Calibración
-    float gyroOffsetX, gyroOffsetY, gyroOffsetZ;
-    bool calibrated;
-    
-    // Métodos privados
-    void calibrateSensors();
-    void readSensors();
-    void calculateAngles();
-    void computePID();
-    void updateMotors();
-    void armMotors();
-    void disarmMotors();
-    int constrainValue(int value, int min, int max);
-    
-public:
-    FlightController();
-    bool init();
-    void update();
-    void setInputs(ControlInputs& newInputs);
-    FlightData getFlightData() const { return flightData; }
-    bool isArmed() const { return flightData.armed; }
-    void emergencyStop();
+#if ATTITUDE_ESTIMATOR == ESTIMATOR_MAHONY
+    using Estimator = MahonyAHRS;
+    static constexpr MahonyAHRS::Config estimatorConfig = { MAHONY_KP, MAHONY_KI };
+#else
+    using Estimator = ComplementaryFilter;
+    static constexpr ComplementaryFilter::Config estimatorConfig = { GYRO_FILTER_ALPHA };
+#endif
 };
 
-#endif
\ No newline at end of file
+// Se instancia una sola vez, en FlightController.cpp
+extern template class FlightPipeline<DefaultAirframe>;
+
+typedef FlightPipeline<DefaultAirframe> FlightController;
+
+#endif
@@ -0,0 +1,796 @@
+#ifndef FLIGHT_PIPELINE_H
+#define FLIGHT_PIPELINE_H
+
+#include <math.h>
+#include <string.h>
+#include <type_traits>
+#include "AirframeConfig.h"
+#include "Failsafe.h"
+#include "FastMath.h"
+#include "Filters.h"
+#include "GyroCalibrator.h"
+#include "Hal.h"
+#include "InputInterpolator.h"
+#include "Log.h"
+#include "MPU6050Driver.h"
+#include "OutputShaping.h"
+#include "Parameters.h"
+#include "Profiler.h"
+#include "SpectrumAnalyzer.h"
+#include "StateBus.h"
+#include "Trace.h"
+
+struct FlightData {
+    float roll, pitch, yaw;
+    float rollRate, pitchRate, yawRate;
+    float accelX, accelY, accelZ;
+    bool armed;
+    bool calibrated;   // Offsets del giroscopio válidos (se puede armar)
+    uint8_t failsafe;  // FailsafeState
+};
+
+struct ControlInputs {
+    float throttle;    // 0-100%
+    float rollCmd;     // -100 to 100%
+    float pitchCmd;    // -100 to 100%
+    float yawCmd;      // -100 to 100%
+    bool armCmd;
+    bool disarmCmd;
+    bool acroMode;     // true = los sticks mandan velocidad, sin lazo de ángulo
+    uint32_t traceId;  // Correlación de la traza desde la UART (0 = ninguna)
+};
+
+// Lazo de control completo, especializado al compilar para un marco. Airframe
+// reúne los componentes (políticas) y la configuración fija:
+//
+//   Sensor      fuente de ImuSample: init(const ImuConfig&), startFifo(),
+//               read(muestras, máx), pendingSamples(), getSamplePeriodUs()
+//               y la constante usesFifo (ver Mpu6050Source)
+//   Estimator   actitud: Estimator(estimatorConfig), update(gx, gy, gz en
+//               rad/s, ax, ay, az, dt), getRoll/Pitch/Yaw() en grados
+//   Controller  lazo de velocidad por eje, con la interfaz de PIDController
+//   MotorMixer  mezcla normalizada, con la interfaz de Mixer y la
+//               constante maxMotors
+//   Output      salida a los ESC: init(pines), write(int (&)[motorCount]),
+//               writeAll(pulso) y la constante motorCount (ver MotorOutput)
+//
+//   static constexpr AirframeConfig config;
+//   static constexpr Estimator::Config estimatorConfig;
+//   static constexpr bool instrumented;   (opcional, por defecto true)
+//
+// Con instrumented = false el lazo no escribe en el perfilador ni en el
+// trazador globales: su único escritor es la tarea de control, y un
+// pipeline que corre en otro núcleo (los benchmarks) los corrompería.
+//
+// Sensor y Output se inyectan por referencia (hardware real o simulado); el
+// resto son miembros por valor. Con tipos concretos y configuración constexpr
+// las llamadas del lazo no pasan por funciones virtuales y los límites de los
+// bucles son constantes. FlightController (FlightController.h) es el marco de
+// config.h.
+template <typename Airframe, typename = void>
+struct AirframeInstrumented : std::true_type {};
+
+template <typename Airframe>
+struct AirframeInstrumented<Airframe, std::void_t<decltype(Airframe::instrumented)>>
+    : std::bool_constant<Airframe::instrumented> {};
+
+// Gancho de perfilado o traza del lazo, omitido si el marco no está instrumentado
+#define PIPELINE_HOOK(hook) do { if constexpr (instrumented) { hook; } } while (0)
+
+template <typename Airframe>
+class FlightPipeline {
+public:
+    using Sensor = typename Airframe::Sensor;
+    using Estimator = typename Airframe::Estimator;
+    using Controller = typename Airframe::Controller;
+    using MotorMixer = typename Airframe::MotorMixer;
+    using Output = typename Airframe::Output;
+
+    static constexpr AirframeConfig config = Airframe::config;
+    static constexpr int motorCount = config.esc.motorCount;
+    static constexpr bool instrumented = AirframeInstrumented<Airframe>::value;
+
+private:
+    static constexpr int notchCount = config.dynamicNotch.enable ? config.dynamicNotch.count : 0;
+
+    static_assert(motorCount > 0 && motorCount <= MotorMixer::maxMotors, "motorCount fuera de rango");
+    static_assert(Output::motorCount == motorCount, "La salida no tiene los motores del marco");
+    static_assert(motorCount <= MotorState::maxMotors, "MotorState no tiene sitio para todos los motores");
+    static_assert(config.loop.angleDivider > 0, "angleDivider debe ser al menos 1");
+    static_assert(config.imu.burstSamples > 0, "burstSamples debe ser al menos 1");
+    static_assert(notchCount <= SpectrumAnalyzer::maxPeaks, "Demasiadas muescas dinámicas");
+    static_assert(notchCount == 0 || config.dynamicNotch.maxHz < config.imu.filterRateHz / 2,
+                  "dynamicNotch.maxHz por encima de Nyquist");
+    static_assert(config.shaping.throttleMid > 0.0f && config.shaping.throttleMid < 1.0f,
+                  "shaping.throttleMid fuera de (0, 1)");
+    static_assert(config.shaping.throttleExpo >= 0.0f && config.shaping.throttleExpo <= 1.0f,
+                  "shaping.throttleExpo fuera de [0, 1]");
+    static_assert(config.shaping.thrustLinearization >= 0.0f && config.shaping.thrustLinearization < 1.0f,
+                  "shaping.thrustLinearization fuera de [0, 1)");
+
+    // Escalas precalculadas de cuentas del ADC a unidades del controlador
+    static constexpr int32_t gyroFixedOne = 1 << GyroCalibrator::fractionBits;
+    static constexpr float standardGravity = 9.80665f;
+    static constexpr float gyroScale = 1.0f / (config.imu.gyroSensitivity * gyroFixedOne);  // grados/s
+    static constexpr float accelScale = standardGravity / config.imu.accelSensitivity;  // m/s²
+    static constexpr int32_t gyroCalTolerance =
+        (int32_t)(config.gyroCal.toleranceDps * config.imu.gyroSensitivity * gyroFixedOne);
+    static constexpr float pulseRange = (float)(config.esc.maxPulse - config.esc.minPulse);
+
+    // Curva de throttle y linealización del empuje, tablas en flash
+    static constexpr OutputShaper shaper{ config.shaping };
+    static_assert(shaper.isValid(), "Curva de salida no monótona");
+
+    // Hardware inyectado (placa real o simulación)
+    Sensor& sensor;
+    Output& motors;
+    HalClock clock;
+    Logger& logger;  // Mensajes diferidos: nunca se formatea texto en el lazo
+
+    // Bus de estado donde se publica cada tick
+    StateBus& stateBus;
+
+    // Sensores
+    ImuSample imuSamples[config.imu.burstSamples];
+    ImuSample lastRawSample;  // Última muestra cruda aplicada (para el blackbox)
+    uint32_t lastSampleTime;
+
+    // Filtros digitales de los sensores
+    BiquadBank gyroFilter;
+    BiquadBank accelFilter;
+
+    // Muescas dinámicas guiadas por el espectro del giroscopio crudo
+    SpectrumAnalyzer spectrum;
+    int dynamicNotchStage[notchCount > 0 ? notchCount : 1];  // Etapa de gyroFilter, -1 si no hay
+
+    // Estimador de actitud
+    Estimator estimator;
+
+    // Lazo externo de ángulo: produce las velocidades pedidas al lazo interno
+    float rollRateSetpoint;
+    float pitchRateSetpoint;
+    float rollFeedforwardReference;   // Parte de los sticks de la consigna, en cada tick
+    float pitchFeedforwardReference;
+    uint8_t angleLoopCounter;
+    float angleLoopDeltaTime;
+
+    // Controladores del lazo interno de velocidad
+    Controller pidRoll;
+    Controller pidPitch;
+    Controller pidYaw;
+
+    // Mezcla de throttle y correcciones a cada motor
+    MotorMixer mixer;
+
+    // Parámetros ajustables en vuelo (ver Parameters.h)
+    FlightParameters parameters;
+    bool filtersPending;  // Filtros de sensores a reconstruir al desarmar
+
+    // Variables de estado
+    FlightData flightData;
+    ControlInputs inputs;
+    InputInterpolator inputInterpolator;  // Mandos suavizados a un valor por tick
+    int motorOutputs[motorCount];  // Último pulso enviado a cada ESC (us)
+
+    // Timing
+    unsigned long lastLoopTime;
+    float deltaTime;
+
+    // Calibración en segundo plano mientras está desarmado
+    GyroCalibrator gyroCalibrator;
+    int32_t gyroOffset[3];  // Cuentas crudas en punto fijo (ver GyroCalibrator::fractionBits)
+    bool calibrationPending;  // Offsets nuevos aún no recogidos para guardar
+    uint32_t escArmStartTime;
+
+    // Failsafe escalonado del enlace de mandos
+    Failsafe failsafe;
+    bool linkActive;
+    uint32_t linkLastFrameTime;
+
+    // Métodos privados
+    void configureSensorFilters();
+    void updateCalibration(const ImuSample& sample);
+    size_t readSensors();
+    void applySample(const ImuSample& sample);
+    void updateDynamicNotches();
+    void calculateAngles(float dt);
+    void applyFailsafe();
+    void computeAngleLoop();
+    void computeRateSetpoints();
+    void computePID();
+    void updateMotors();
+    void publishState();
+    void armMotors();
+    void disarmMotors();
+    int constrainValue(int value, int min, int max);
+    float constrainFloat(float value, float min, float max);
+
+public:
+    FlightPipeline(Sensor& sensorSource, Output& motorOutput, HalClock clockSource, Logger& logOutput,
+                   StateBus& stateOutput);
+    // Con offsets guardados se vuela con ellos mientras se verifican en reposo
+    bool init(const int32_t* storedGyroOffsets = nullptr);
+    void update();
+    bool dataReady() const;
+    void setInputs(ControlInputs& newInputs);
+
+    // Aplica una instantánea completa de parámetros al principio de un tick
+    void applyParameters(const FlightParameters& newParameters);
+    const FlightParameters& getParameters() const { return parameters; }
+
+    // Estado del enlace visto por la tarea de comunicaciones (ver LinkMonitor)
+    void setLinkStatus(bool active, uint32_t lastFrameTime);
+    const FlightData& getFlightData() const { return flightData; }
+    ControlInputs getInputs() const { return inputs; }
+    const int* getMotorOutputs() const { return motorOutputs; }
+    const ImuSample& getRawSample() const { return lastRawSample; }
+    const Controller& getRollPID() const { return pidRoll; }
+    const Controller& getPitchPID() const { return pidPitch; }
+    const Controller& getYawPID() const { return pidYaw; }
+    const MotorMixer& getMixer() const { return mixer; }
+    const SpectrumAnalyzer& getSpectrum() const { return spectrum; }
+    bool isArmed() const { return flightData.armed; }
+    bool isCalibrated() const { return flightData.calibrated; }
+
+    // Recoge los offsets de una calibración recién terminada (una sola vez)
+    bool takeCalibration(int32_t offsets[3]);
+    void emergencyStop();
+};
+
+template <typename Airframe>
+FlightPipeline<Airframe>::FlightPipeline(Sensor& sensorSource, Output& motorOutput, HalClock clockSource,
+                                         Logger& logOutput, StateBus& stateOutput)
+    : sensor(sensorSource),
+      motors(motorOutput),
+      clock(clockSource),
+      logger(logOutput),
+      stateBus(stateOutput),
+      lastSampleTime(0),
+      estimator(Airframe::estimatorConfig),
+      rollRateSetpoint(0),
+      pitchRateSetpoint(0),
+      rollFeedforwardReference(0),
+      pitchFeedforwardReference(0),
+      angleLoopCounter(0),
+      angleLoopDeltaTime(0),
+      pidRoll(config.parameters.rollP, config.parameters.rollI, config.parameters.rollD, config.parameters.rollMax),
+      pidPitch(config.parameters.pitchP, config.parameters.pitchI, config.parameters.pitchD,
+               config.parameters.pitchMax),
+      pidYaw(config.parameters.yawP, config.parameters.yawI, config.parameters.yawD, config.parameters.yawMax),
+      parameters(config.parameters),
+      filtersPending(false),
+      inputInterpolator(config.interpolation.minUs, config.interpolation.maxUs),
+      lastLoopTime(0),
+      deltaTime(0),
+      gyroCalibrator(config.gyroCal.blockSamples, config.gyroCal.blocks, config.gyroCal.stillRange,
+                     gyroCalTolerance),
+      calibrationPending(false),
+      escArmStartTime(0),
+      failsafe(config.failsafe.holdUs, config.failsafe.landUs, config.failsafe.rampUs),
+      linkActive(false),
+      linkLastFrameTime(0) {
+
+    // Inicializar datos de vuelo
+    memset(&flightData, 0, sizeof(flightData));
+    memset(&inputs, 0, sizeof(inputs));
+    memset(&lastRawSample, 0, sizeof(lastRawSample));
+
+    for (int i = 0; i < motorCount; i++) {
+        motorOutputs[i] = config.esc.minPulse;
+    }
+
+    // Configurar offsets iniciales
+    gyroOffset[0] = gyroOffset[1] = gyroOffset[2] = 0;
+}
+
+template <typename Airframe>
+bool FlightPipeline<Airframe>::init(const int32_t* storedGyroOffsets) {
+    logger.log(LOG_FC_INIT);
+
+    // Configurar ESCs lo primero: la espera de armado de los ESCs corre en
+    // paralelo con el resto del arranque y la calibración
+    if (!motors.init(config.esc.pins)) {
+        logger.log(LOG_FC_ESC_ERROR);
+        return false;
+    }
+    motors.writeAll(config.esc.armPulse);
+    escArmStartTime = clock();
+
+    // Inicializar y configurar el sensor
+    if (!sensor.init(config.imu)) {
+        logger.log(LOG_FC_IMU_ERROR);
+        return false;
+    }
+
+    // Modo FIFO con interrupción de datos listos
+    if constexpr (Sensor::usesFifo) {
+        if (!sensor.startFifo()) {
+            logger.log(LOG_FC_FIFO_ERROR);
+            return false;
+        }
+    }
+
+    // Mezclador del marco configurado
+    if (!mixer.setFrame(config.frame) || mixer.getMotorCount() != motorCount) {
+        logger.log(LOG_FC_FRAME_ERROR);
+        return false;
+    }
+
+    // Filtros, PID y airmode según los parámetros actuales
+    applyParameters(parameters);
+    configureSensorFilters();
+
+    // Offsets guardados: se usan ya y se verifican con el primer bloque en
+    // reposo. Sin ellos no se puede armar hasta terminar la calibración.
+    gyroCalibrator.begin(storedGyroOffsets);
+    for (int axis = 0; axis < 3; axis++) {
+        gyroOffset[axis] = storedGyroOffsets ? storedGyroOffsets[axis] : 0;
+    }
+    flightData.calibrated = storedGyroOffsets != nullptr;
+    if (!flightData.calibrated) {
+        logger.log(LOG_FC_NO_CALIBRATION);
+    }
+
+    logger.log(LOG_FC_READY);
+    return true;
+}
+
+template <typename Airframe>
+size_t FlightPipeline<Airframe>::readSensors() {
+    return sensor.read(imuSamples, config.imu.burstSamples);
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::configureSensorFilters() {
+    // Las etapas a 0 Hz quedan desactivadas
+    gyroFilter.init(config.imu.filterRateHz);
+    gyroFilter.addLowpass(parameters.gyroLpfHz);
+    gyroFilter.addNotch(parameters.gyroNotchHz, parameters.gyroNotchQ);
+
+    // Muescas dinámicas: empiezan transparentes hasta que aparece un pico
+    dynamicNotchStage[0] = -1;
+    for (int i = 0; i < notchCount; i++) {
+        dynamicNotchStage[i] = gyroFilter.addNotch(config.dynamicNotch.maxHz, parameters.dynNotchQ);
+        for (int axis = 0; axis < FILTER_AXES; axis++) {
+            gyroFilter.setNotch(dynamicNotchStage[i], axis, 0.0f, parameters.dynNotchQ);
+        }
+    }
+    spectrum.init(config.imu.filterRateHz, config.dynamicNotch.minHz, config.dynamicNotch.maxHz, notchCount,
+                  config.dynamicNotch.threshold, config.dynamicNotch.smoothing);
+
+    accelFilter.init(config.imu.filterRateHz);
+    accelFilter.addLowpass(parameters.accelLpfHz);
+    filtersPending = false;
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::applyParameters(const FlightParameters& newParameters) {
+    // Reconstruir un banco borra su estado: en vuelo se espera al desarmado
+    if (newParameters.gyroLpfHz != parameters.gyroLpfHz ||
+        newParameters.gyroNotchHz != parameters.gyroNotchHz ||
+        newParameters.gyroNotchQ != parameters.gyroNotchQ ||
+        newParameters.accelLpfHz != parameters.accelLpfHz) {
+        filtersPending = true;
+    }
+    parameters = newParameters;
+
+    pidRoll.setTunings(parameters.rollP, parameters.rollI, parameters.rollD);
+    pidRoll.setOutputLimits(parameters.rollMax);
+    pidPitch.setTunings(parameters.pitchP, parameters.pitchI, parameters.pitchD);
+    pidPitch.setOutputLimits(parameters.pitchMax);
+    pidYaw.setTunings(parameters.yawP, parameters.yawI, parameters.yawD);
+    pidYaw.setOutputLimits(parameters.yawMax);
+
+    // Sólo cambia coeficientes: el estado del filtro del término D se conserva
+    pidRoll.setDerivativeFilter(parameters.dtermLpfHz, config.loop.rateHz);
+    pidPitch.setDerivativeFilter(parameters.dtermLpfHz, config.loop.rateHz);
+    pidYaw.setDerivativeFilter(parameters.dtermLpfHz, config.loop.rateHz);
+
+    pidRoll.setFeedforward(parameters.rollF);
+    pidPitch.setFeedforward(parameters.pitchF);
+    pidYaw.setFeedforward(parameters.yawF);
+    pidRoll.setFeedforwardFilter(parameters.feedforwardLpfHz, config.loop.rateHz);
+    pidPitch.setFeedforwardFilter(parameters.feedforwardLpfHz, config.loop.rateHz);
+    pidYaw.setFeedforwardFilter(parameters.feedforwardLpfHz, config.loop.rateHz);
+
+    bool derivativeOnMeasurement = parameters.dOnMeasurement != 0;
+    pidRoll.setDerivativeOnMeasurement(derivativeOnMeasurement);
+    pidPitch.setDerivativeOnMeasurement(derivativeOnMeasurement);
+    pidYaw.setDerivativeOnMeasurement(derivativeOnMeasurement);
+
+    mixer.setAirmode(parameters.airmode != 0);
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::updateCalibration(const ImuSample& sample) {
+    // Con los motores girando las vibraciones no dejan ver el reposo
+    if (flightData.armed) return;
+
+    CalibrationState previousState = gyroCalibrator.getState();
+    bool finished = gyroCalibrator.addSample(sample.gyro);
+
+    // Verificación fallida: los offsets guardados están obsoletos
+    if (previousState == CALIBRATION_VERIFYING &&
+        gyroCalibrator.getState() == CALIBRATION_RUNNING) {
+        flightData.calibrated = false;
+    }
+
+    if (finished) {
+        const int32_t* offsets = gyroCalibrator.getOffsets();
+        for (int axis = 0; axis < 3; axis++) {
+            gyroOffset[axis] = offsets[axis];
+        }
+        flightData.calibrated = true;
+        calibrationPending = true;
+    }
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::applySample(const ImuSample& sample) {
+    lastRawSample = sample;
+    updateCalibration(sample);
+
+    float gyro[3], accel[3];
+    for (int axis = 0; axis < 3; axis++) {
+        // Aplicar offsets del giroscopio en enteros y convertir una sola vez a grados/s
+        gyro[axis] = (sample.gyro[axis] * gyroFixedOne - gyroOffset[axis]) * gyroScale;
+
+        // Acelerómetro en m/s²
+        accel[axis] = sample.accel[axis] * accelScale;
+    }
+
+    // El espectro se mide antes de filtrar: las muescas no esconden su propio pico
+    if constexpr (config.dynamicNotch.enable) {
+        spectrum.addSample(gyro);
+    }
+
+    // Filtrado digital de los tres ejes a la vez
+    gyroFilter.apply(gyro);
+    accelFilter.apply(accel);
+
+    flightData.rollRate = gyro[0];
+    flightData.pitchRate = gyro[1];
+    flightData.yawRate = gyro[2];
+    flightData.accelX = accel[0];
+    flightData.accelY = accel[1];
+    flightData.accelZ = accel[2];
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::updateDynamicNotches() {
+    // Un eje por tick: el análisis completo se reparte en FILTER_AXES ticks
+    int axis = spectrum.step();
+    if (axis < 0) return;
+    for (int i = 0; i < spectrum.getPeakCount() && i < notchCount; i++) {
+        if (dynamicNotchStage[i] < 0) continue;
+        gyroFilter.setNotch(dynamicNotchStage[i], axis, spectrum.getPeak(axis, i), parameters.dynNotchQ);
+    }
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::calculateAngles(float dt) {
+    estimator.update(flightData.rollRate * DEG_TO_RAD_F,
+                     flightData.pitchRate * DEG_TO_RAD_F,
+                     flightData.yawRate * DEG_TO_RAD_F,
+                     flightData.accelX, flightData.accelY, flightData.accelZ,
+                     dt);
+
+    flightData.roll = estimator.getRoll();
+    flightData.pitch = estimator.getPitch();
+    flightData.yaw = estimator.getYaw();
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::applyFailsafe() {
+    FailsafeState previous = failsafe.getState();
+    FailsafeState state = failsafe.update(clock(), linkLastFrameTime, linkActive,
+                                          flightData.armed, inputs.throttle);
+    flightData.failsafe = state;
+
+    if (failsafe.isActive()) {
+        // Nivelar en modo ángulo con el throttle que impone el failsafe
+        inputs.throttle = failsafe.getThrottle();
+        inputs.rollCmd = inputs.pitchCmd = inputs.yawCmd = 0;
+        inputs.acroMode = false;
+        inputs.armCmd = false;
+
+        // Sin rampa: el failsafe manda desde este mismo tick
+        float failsafeInputs[INTERPOLATOR_AXES] = { inputs.throttle, 0, 0, 0 };
+        inputInterpolator.jumpTo(failsafeInputs);
+    } else if (state == FAILSAFE_DISARMED && flightData.armed) {
+        disarmMotors();
+    }
+
+    if (state != previous) {
+        if (state == FAILSAFE_HOLD) {
+            logger.log(LOG_FAILSAFE_HOLD);
+        } else if (state == FAILSAFE_LANDING) {
+            logger.log(LOG_FAILSAFE_LANDING);
+        } else if (previous == FAILSAFE_HOLD && state == FAILSAFE_IDLE) {
+            logger.log(LOG_FAILSAFE_RECOVERED);
+        }
+    }
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::computeAngleLoop() {
+    if (inputs.acroMode) return;  // En acro las consignas se calculan en cada tick
+
+    // Modo ángulo: el error de ángulo se convierte en velocidad pedida
+    float rollSetpoint = (inputInterpolator.get(1) / 100.0f) * parameters.maxAngleRoll;
+    float pitchSetpoint = (inputInterpolator.get(2) / 100.0f) * parameters.maxAnglePitch;
+
+    rollRateSetpoint = constrainFloat(parameters.angleRollP * (rollSetpoint - flightData.roll),
+                                      -parameters.angleMaxRate, parameters.angleMaxRate);
+    pitchRateSetpoint = constrainFloat(parameters.anglePitchP * (pitchSetpoint - flightData.pitch),
+                                       -parameters.angleMaxRate, parameters.angleMaxRate);
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::computeRateSetpoints() {
+    // Modo acro: los sticks interpolados mandan velocidad directamente, así el
+    // feedforward ve una consigna que cambia en cada tick y no a saltos
+    if (inputs.acroMode) {
+        rollRateSetpoint = (inputInterpolator.get(1) / 100.0f) * parameters.acroMaxRate;
+        pitchRateSetpoint = (inputInterpolator.get(2) / 100.0f) * parameters.acroMaxRate;
+        rollFeedforwardReference = rollRateSetpoint;
+        pitchFeedforwardReference = pitchRateSetpoint;
+        return;
+    }
+
+    // Modo ángulo: la consigna del lazo de ángulo cambia a saltos cada
+    // angleDivider ticks y lleva dentro el error de actitud medido. El
+    // feedforward usa sólo su parte de los sticks, interpolada en cada tick.
+    float rollSetpoint = (inputInterpolator.get(1) / 100.0f) * parameters.maxAngleRoll;
+    float pitchSetpoint = (inputInterpolator.get(2) / 100.0f) * parameters.maxAnglePitch;
+    rollFeedforwardReference = parameters.angleRollP * rollSetpoint;
+    pitchFeedforwardReference = parameters.anglePitchP * pitchSetpoint;
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::computePID() {
+    if (!flightData.armed) return;
+    PIPELINE_HOOK(TRACE_BEGIN(TRACE_COMPUTE_PID, inputs.traceId));
+
+    float yawSetpoint = (inputInterpolator.get(3) / 100.0f) * parameters.maxRateYaw;  // Yaw siempre en rate mode
+
+    // Lazo interno de velocidad sobre el giroscopio filtrado, en cada tick
+    float rollOutput = pidRoll.compute(rollRateSetpoint, flightData.rollRate, deltaTime, rollFeedforwardReference);
+    float pitchOutput = pidPitch.compute(pitchRateSetpoint, flightData.pitchRate, deltaTime, pitchFeedforwardReference);
+    float yawOutput = pidYaw.compute(yawSetpoint, flightData.yawRate, deltaTime);
+
+    // Mezcla normalizada: throttle en [0, 1] y correcciones en fracción del rango del ESC
+    float motorMix[motorCount];
+    mixer.mix(shaper.shapeThrottle(inputInterpolator.get(0) / 100.0f), rollOutput / pulseRange,
+              pitchOutput / pulseRange, yawOutput / pulseRange, motorMix);
+
+    // Empuje pedido -> mando del ESC (tabla precalculada, sin sqrt por motor)
+    shaper.linearizeThrust(motorMix, motorCount);
+
+    for (int i = 0; i < motorCount; i++) {
+        int pulse = config.esc.minPulse + (int)(motorMix[i] * pulseRange + 0.5f);
+        motorOutputs[i] = constrainValue(pulse, config.esc.minPulse, config.esc.maxPulse);
+    }
+
+    // Enviar señales a los motores en el mismo ciclo
+    motors.write(motorOutputs);
+    PIPELINE_HOOK(TRACE_INSTANT(TRACE_MOTOR_WRITE, inputs.traceId));
+    PIPELINE_HOOK(TRACE_END(TRACE_COMPUTE_PID, inputs.traceId));
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::updateMotors() {
+    if (!flightData.armed) {
+        for (int i = 0; i < motorCount; i++) {
+            motorOutputs[i] = config.esc.minPulse;
+        }
+        motors.write(motorOutputs);
+    }
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::update() {
+    PROFILE_START();
+
+    if constexpr (Sensor::usesFifo) {
+        // Leer sensores
+        PIPELINE_HOOK(TRACE_BEGIN(TRACE_READ_SENSORS, 0));
+        size_t count = readSensors();
+        PIPELINE_HOOK(TRACE_END(TRACE_READ_SENSORS, 0));
+        if (count == 0) return;  // Sin datos nuevos del sensor
+        PIPELINE_HOOK(PROFILE_LAP(PROFILE_READ_SENSORS));
+
+        // Filtrar cada muestra y acumular su dt real según la marca de tiempo del sensor
+        float controlDeltaTime = 0;
+        for (size_t i = 0; i < count; i++) {
+            const ImuSample& sample = imuSamples[i];
+            uint32_t sampleDt = lastSampleTime ? sample.timestampUs - lastSampleTime
+                                               : sensor.getSamplePeriodUs();
+            lastSampleTime = sample.timestampUs;
+
+            applySample(sample);
+            controlDeltaTime += sampleDt / 1000000.0f;
+        }
+        deltaTime = controlDeltaTime;
+    } else {
+        unsigned long currentTime = clock();
+        deltaTime = (currentTime - lastLoopTime) / 1000000.0f;
+        lastLoopTime = currentTime;
+
+        // Leer sensores
+        PIPELINE_HOOK(TRACE_BEGIN(TRACE_READ_SENSORS, 0));
+        if (readSensors() > 0) {
+            applySample(imuSamples[0]);
+        }
+        PIPELINE_HOOK(TRACE_END(TRACE_READ_SENSORS, 0));
+        PIPELINE_HOOK(PROFILE_LAP(PROFILE_READ_SENSORS));
+    }
+
+    updateDynamicNotches();
+    PIPELINE_HOOK(PROFILE_LAP(PROFILE_DYNAMIC_NOTCH));
+
+    // El failsafe sustituye los mandos antes de los lazos de control
+    applyFailsafe();
+    inputInterpolator.update(deltaTime);
+    computeRateSetpoints();
+
+    // Lazo externo: estimador de actitud y lazo de ángulo cada angleDivider ticks
+    angleLoopDeltaTime += deltaTime;
+    if (++angleLoopCounter >= config.loop.angleDivider) {
+        angleLoopCounter = 0;
+        PIPELINE_HOOK(TRACE_BEGIN(TRACE_ESTIMATION, 0));
+        calculateAngles(angleLoopDeltaTime);
+        computeAngleLoop();
+        PIPELINE_HOOK(TRACE_END(TRACE_ESTIMATION, 0));
+        angleLoopDeltaTime = 0;
+    }
+    PIPELINE_HOOK(PROFILE_LAP(PROFILE_CALCULATE_ANGLES));
+
+    // Procesar comandos de armado/desarmado
+    if (inputs.armCmd && !flightData.armed) {
+        armMotors();
+        inputs.armCmd = false;  // Resetear comando después de procesar
+    } else if (inputs.disarmCmd && flightData.armed) {
+        disarmMotors();
+        inputs.disarmCmd = false;  // Resetear comando después de procesar
+    }
+    if (filtersPending && !flightData.armed) {
+        configureSensorFilters();
+    }
+    PIPELINE_HOOK(PROFILE_LAP(PROFILE_ARM_LOGIC));
+
+    // Calcular PID y actualizar motores
+    computePID();
+    PIPELINE_HOOK(PROFILE_LAP(PROFILE_COMPUTE_PID));
+    updateMotors();
+    PIPELINE_HOOK(PROFILE_LAP(PROFILE_UPDATE_MOTORS));
+
+    publishState();
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::publishState() {
+    uint32_t now = clock();
+
+    ImuState imuState;
+    for (int axis = 0; axis < 3; axis++) {
+        imuState.rawGyro[axis] = lastRawSample.gyro[axis];
+        imuState.rawAccel[axis] = lastRawSample.accel[axis];
+    }
+    imuState.rates[0] = flightData.rollRate;
+    imuState.rates[1] = flightData.pitchRate;
+    imuState.rates[2] = flightData.yawRate;
+    imuState.accel[0] = flightData.accelX;
+    imuState.accel[1] = flightData.accelY;
+    imuState.accel[2] = flightData.accelZ;
+    stateBus.imu.publish(imuState, lastRawSample.timestampUs ? lastRawSample.timestampUs : now);
+
+    // La actitud sólo cambia cuando corre el lazo externo
+    if (angleLoopCounter == 0) {
+        AttitudeState attitude = { flightData.roll, flightData.pitch, flightData.yaw };
+        stateBus.attitude.publish(attitude, now);
+    }
+
+    SetpointState setpoints;
+    setpoints.throttle = inputInterpolator.get(0);
+    setpoints.rollRate = rollRateSetpoint;
+    setpoints.pitchRate = pitchRateSetpoint;
+    setpoints.yawRate = (inputInterpolator.get(3) / 100.0f) * parameters.maxRateYaw;
+    setpoints.acroMode = inputs.acroMode;
+    stateBus.setpoints.publish(setpoints, now);
+
+    MotorState motorState;
+    for (int i = 0; i < MotorState::maxMotors; i++) {
+        motorState.outputs[i] = i < motorCount ? motorOutputs[i] : 0;
+    }
+    motorState.count = motorCount;
+    stateBus.motors.publish(motorState, now);
+
+    StatusState status = { flightData.armed, flightData.calibrated, flightData.failsafe };
+    stateBus.status.publish(status, now);
+}
+
+template <typename Airframe>
+bool FlightPipeline<Airframe>::dataReady() const {
+    if constexpr (Sensor::usesFifo) {
+        return sensor.pendingSamples() >= config.imu.samplesPerLoop;
+    }
+    return true;
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::armMotors() {
+    if (failsafe.getState() != FAILSAFE_IDLE || failsafe.isLinkLost()) {
+        logger.log(LOG_ARM_FAILSAFE);
+    } else if (!flightData.calibrated) {
+        logger.log(LOG_ARM_NOT_CALIBRATED);
+    } else if (clock() - escArmStartTime < config.esc.armTimeUs) {
+        logger.log(LOG_ARM_ESC_WAIT);
+    } else if (inputs.throttle <= 5) {  // Permitir hasta 5% de throttle
+        flightData.armed = true;
+        pidRoll.reset();
+        pidPitch.reset();
+        pidYaw.reset();
+        rollRateSetpoint = pitchRateSetpoint = 0;
+        logger.log(LOG_ARMED, inputs.throttle);
+    } else {
+        logger.log(LOG_ARM_THROTTLE_HIGH, inputs.throttle);
+    }
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::disarmMotors() {
+    flightData.armed = false;
+    logger.log(LOG_DISARMED);
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::setLinkStatus(bool active, uint32_t lastFrameTime) {
+    linkActive = active;
+    linkLastFrameTime = lastFrameTime;
+}
+
+template <typename Airframe>
+bool FlightPipeline<Airframe>::takeCalibration(int32_t offsets[3]) {
+    if (!calibrationPending) return false;
+    calibrationPending = false;
+    for (int axis = 0; axis < 3; axis++) {
+        offsets[axis] = gyroOffset[axis];
+    }
+    return true;
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::setInputs(ControlInputs& newInputs) {
+    PIPELINE_HOOK(TRACE_INSTANT(TRACE_SET_INPUTS, newInputs.traceId));
+    inputs = newInputs;
+
+    // Los mandos llegan a baja frecuencia: se interpolan hasta el siguiente
+    float values[INTERPOLATOR_AXES] = { inputs.throttle, inputs.rollCmd, inputs.pitchCmd, inputs.yawCmd };
+    inputInterpolator.setTarget(values, clock());
+}
+
+template <typename Airframe>
+void FlightPipeline<Airframe>::emergencyStop() {
+    disarmMotors();
+    motors.writeAll(config.esc.minPulse);
+    logger.log(LOG_EMERGENCY_STOP);
+}
+
+template <typename Airframe>
+int FlightPipeline<Airframe>::constrainValue(int value, int min, int max) {
+    if (value < min) return min;
+    if (value > max) return max;
+    return value;
+}
+
+template <typename Airframe>
+float FlightPipeline<Airframe>::constrainFloat(float value, float min, float max) {
+    if (value < min) return min;
+    if (value > max) return max;
+    return value;
+}
+
+#undef PIPELINE_HOOK
+
+#endif
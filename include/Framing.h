@@ -0,0 +1,33 @@
+#ifndef FRAMING_H
+#define FRAMING_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Entramado binario para el enlace serie: COBS con delimitador 0x00 y
+// CRC16-CCITT al final de la carga útil.
+
+#define FRAME_DELIMITER         0x00
+#define FRAME_CRC_BYTES         2
+#define FRAME_MAX_PAYLOAD       250   // Carga útil + CRC caben en un bloque COBS
+
+// Tamaño máximo codificado para una carga útil de `length` bytes
+#define COBS_MAX_ENCODED(length) ((length) + ((length) / 254) + 1)
+
+uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+// Devuelve la longitud codificada (sin delimitador)
+size_t cobsEncode(const uint8_t* input, size_t length, uint8_t* output);
+
+// Devuelve la longitud decodificada o 0 si la entrada no es válida
+size_t cobsDecode(const uint8_t* input, size_t length, uint8_t* output, size_t maxOutput);
+
+// Añade CRC, codifica y termina con delimitador. `output` debe tener
+// COBS_MAX_ENCODED(length + FRAME_CRC_BYTES) + 1 bytes.
+size_t encodeFrame(const uint8_t* payload, size_t length, uint8_t* output);
+
+// Decodifica una trama sin delimitador y verifica el CRC.
+// Devuelve la longitud de la carga útil o 0 si la trama no es válida.
+size_t decodeFrame(const uint8_t* input, size_t length, uint8_t* payload, size_t maxPayload);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef GYRO_CALIBRATOR_H
+#define GYRO_CALIBRATOR_H
+
+#include <stdint.h>
+
+// Offsets en punto fijo: cuentas del ADC con 4 bits fraccionarios
+#define GYRO_OFFSET_FRACTION_BITS   4
+
+// Detector de reposo por bloques: un bloque es estable si en los tres ejes
+// la diferencia entre la muestra mayor y la menor no supera `maxRange` cuentas.
+class StillnessDetector {
+private:
+    int16_t minValue[3];
+    int16_t maxValue[3];
+    int32_t sum[3];
+    uint16_t count;
+    uint16_t blockSize;
+    int16_t maxRange;
+    bool lastStill;
+    int32_t lastSum[3];
+
+public:
+    StillnessDetector(uint16_t samplesPerBlock, int16_t stillRange);
+
+    // Devuelve true cada vez que se completa un bloque
+    bool addSample(const int16_t gyro[3]);
+    void reset();
+
+    // Resultado del último bloque completo
+    bool wasStill() const { return lastStill; }
+    const int32_t* getBlockSum() const { return lastSum; }
+    uint16_t getBlockSize() const { return blockSize; }
+};
+
+enum CalibrationState {
+    CALIBRATION_IDLE,       // Sin empezar
+    CALIBRATION_VERIFYING,  // Comprobando los offsets guardados con un bloque en reposo
+    CALIBRATION_RUNNING,    // Calibración completa: acumulando bloques en reposo
+    CALIBRATION_DONE        // Offsets verificados o recién calculados
+};
+
+// Máquina de estados de la calibración del giroscopio. Con offsets guardados
+// basta un bloque en reposo que coincida con ellos; si no coinciden (o no
+// hay) se acumulan `requiredBlocks` bloques en reposo seguidos. Un bloque
+// con movimiento reinicia la acumulación. Código puro, sin hardware.
+class GyroCalibrator {
+public:
+    static constexpr int fractionBits = GYRO_OFFSET_FRACTION_BITS;
+
+private:
+    StillnessDetector detector;
+    CalibrationState state;
+    int32_t offsets[3];     // Punto fijo (GYRO_OFFSET_FRACTION_BITS)
+    bool offsetsValid;
+    int32_t sum[3];
+    uint16_t stillBlocks;
+    uint16_t requiredBlocks;
+    int32_t tolerance;      // Punto fijo
+
+    void startRunning();
+
+public:
+    GyroCalibrator(uint16_t samplesPerBlock, uint16_t blocksRequired,
+                   int16_t stillRange, int32_t toleranceFixed);
+
+    // Arranca con los offsets guardados (o nullptr si no hay)
+    void begin(const int32_t* storedOffsets);
+
+    // Devuelve true cuando termina una calibración completa con offsets nuevos
+    bool addSample(const int16_t gyro[3]);
+
+    CalibrationState getState() const { return state; }
+    bool hasOffsets() const { return offsetsValid; }
+    const int32_t* getOffsets() const { return offsets; }
+};
+
+#endif
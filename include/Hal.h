@@ -0,0 +1,38 @@
+#ifndef HAL_H
+#define HAL_H
+
+#include <stdint.h>
+
+// Puntos de sustitución del hardware para el lazo de control. El sensor ya
+// se abstrae con I2CBus; aquí se añaden el reloj y la salida a los motores,
+// de modo que FlightPipeline pueda ejecutarse contra un modelo simulado.
+
+// Microsegundos monótonos (micros() en la placa)
+typedef uint32_t (*HalClock)();
+
+// Salida a MotorCount motores. El tamaño forma parte del tipo: FlightPipeline
+// comprueba al compilar que coincide con el del marco.
+template <int MotorCount>
+class MotorOutput {
+public:
+    static_assert(MotorCount > 0, "MotorCount debe ser al menos 1");
+    static constexpr int motorCount = MotorCount;
+
+    virtual ~MotorOutput() {}
+
+    // Configura la salida de cada pin (MotorCount pines); devuelve false si falla
+    virtual bool init(const uint8_t* motorPins) = 0;
+
+    // Pulsos equivalentes en us (ESC_MIN_PULSE..ESC_MAX_PULSE), todos en el mismo ciclo
+    virtual void write(const int (&pulsesUs)[MotorCount]) = 0;
+
+    void writeAll(int pulseUs) {
+        int pulses[MotorCount];
+        for (int i = 0; i < MotorCount; i++) {
+            pulses[i] = pulseUs;
+        }
+        write(pulses);
+    }
+};
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Interfaz mínima de bus I2C para los drivers de sensores.
+// Permite sustituir Wire por un bus simulado en compilaciones de host.
+class I2CBus {
+public:
+    virtual ~I2CBus() {}
+    virtual bool writeRegister(uint8_t address, uint8_t reg, uint8_t value) = 0;
+    virtual bool readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, size_t length) = 0;
+};
+
+#endif
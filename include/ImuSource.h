@@ -0,0 +1,41 @@
+#ifndef IMU_SOURCE_H
+#define IMU_SOURCE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "AirframeConfig.h"
+#include "I2CBus.h"
+#include "MPU6050Driver.h"
+#include "config.h"
+
+// Fuente de muestras del MPU6050 para FlightPipeline: lectura directa del
+// bloque de registros o FIFO + interrupción de datos listos (IMU_USE_FIFO).
+class Mpu6050Source {
+private:
+    MPU6050Driver imu;
+
+public:
+    static constexpr bool usesFifo = IMU_USE_FIFO != 0;
+
+    explicit Mpu6050Source(I2CBus& bus);
+
+    // Comprueba el sensor y fija el DLPF y la frecuencia de muestreo
+    bool init(const ImuConfig& config);
+
+    // Activa el FIFO y la interrupción del pin INT (sólo con usesFifo)
+    bool startFifo();
+
+    // Tarea a despertar (notificación) en cada interrupción de datos listos
+    static void notifyOnDataReady(TaskHandle_t task);
+
+    // Muestras nuevas: una ráfaga del FIFO o una lectura de registros
+    size_t read(ImuSample* samples, size_t maxSamples);
+
+    uint32_t pendingSamples() const { return imu.pendingSamples(); }
+    uint32_t getSamplePeriodUs() const { return imu.getSamplePeriodUs(); }
+    uint32_t getOverflowCount() const { return imu.getOverflowCount(); }
+};
+
+#endif
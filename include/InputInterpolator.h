@@ -0,0 +1,39 @@
+#ifndef INPUT_INTERPOLATOR_H
+#define INPUT_INTERPOLATOR_H
+
+#include <stdint.h>
+
+#define INTERPOLATOR_AXES   4   // Throttle, roll, pitch, yaw
+
+// Convierte mandos que llegan a baja frecuencia (teclado, radio a 50 Hz)
+// en consignas por tick: cada mando nuevo se alcanza con una rampa lineal
+// que dura el intervalo medio entre mandos, acotado a [minPeriod, maxPeriod].
+// Código puro, sin hardware.
+class InputInterpolator {
+private:
+    float current[INTERPOLATOR_AXES];
+    float target[INTERPOLATOR_AXES];
+    float slope[INTERPOLATOR_AXES];     // Unidades por segundo
+    float commandPeriod;                // Intervalo medio entre mandos (s)
+    float minPeriod;
+    float maxPeriod;
+    uint32_t lastCommandUs;
+    bool hasCommand;
+
+public:
+    InputInterpolator(uint32_t minPeriodUs, uint32_t maxPeriodUs);
+
+    // Nuevo mando recibido en `nowUs`
+    void setTarget(const float values[INTERPOLATOR_AXES], uint32_t nowUs);
+
+    // Saltar sin rampa (failsafe, armado)
+    void jumpTo(const float values[INTERPOLATOR_AXES]);
+
+    // Avanzar las rampas un tick
+    void update(float dt);
+
+    float get(int axis) const { return current[axis]; }
+    float getCommandPeriod() const { return commandPeriod; }
+};
+
+#endif
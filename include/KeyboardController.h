@@ -2,21 +2,35 @@
 #define KEYBOARD_CONTROLLER_H
 
 #include "FlightController.h"
+#include "Log.h"
+#include "StateBus.h"
 
 class KeyboardController {
 private:
+    Logger& logger;  // Eco de las teclas, formateado fuera de la lectura serie
     ControlInputs currentInputs;
     bool helpShown;
+    bool telemetryMode;  // Telemetría binaria en lugar de líneas de estado
+    bool benchmarkRequested;
+    bool traceDumpRequested;
     
     void showHelp();
-    void showStatus(const FlightData& data);
+    void showStatus(const StateBus& bus);
     
 public:
-    KeyboardController();
+    explicit KeyboardController(Logger& logOutput);
     void init();
     bool processInput(char key);
     ControlInputs getInputs() const { return currentInputs; }
-    void update(const FlightData& flightData);
+    
+    // Mandos absolutos del enlace binario; el teclado sigue desde ellos
+    void setInputs(const ControlInputs& inputs) { currentInputs = inputs; }
+    void update(const StateBus& bus);
+    bool isTelemetryMode() const { return telemetryMode; }
+    
+    // Devuelve true una vez por cada pulsación de la tecla de benchmarks
+    bool takeBenchmarkRequest();
+    bool takeTraceDumpRequest();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef LINK_MONITOR_H
+#define LINK_MONITOR_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Calidad del enlace de mandos binarios. La tarea de comunicaciones marca
+// cada trama válida; la marca de tiempo es atómica para que la tarea de
+// control decida el failsafe sin depender de que la otra tarea siga viva.
+class LinkMonitor {
+private:
+    std::atomic<uint32_t> lastFrameUs;
+    std::atomic<bool> active;   // Se ha recibido alguna trama de mandos
+
+    // Estadísticas, sólo desde la tarea de comunicaciones
+    uint32_t frameCount;
+    uint32_t windowStartUs;
+    uint32_t windowFrames;
+    float rateHz;
+    uint32_t maxGapUs;
+    uint32_t dropoutCount;      // Huecos mayores que `dropoutUs`
+    uint32_t dropoutUs;
+
+public:
+    explicit LinkMonitor(uint32_t dropoutThresholdUs);
+
+    // Tarea de comunicaciones: llamar con las tramas de mandos válidas recibidas
+    void onFrame(uint32_t nowUs, uint32_t frames = 1);
+
+    // Tarea de comunicaciones: recalcula la tasa de tramas cada segundo
+    void update(uint32_t nowUs);
+
+    // Cualquier tarea
+    bool isActive() const { return active.load(std::memory_order_acquire); }
+    uint32_t getLastFrameTime() const { return lastFrameUs.load(std::memory_order_acquire); }
+
+    uint32_t getFrameCount() const { return frameCount; }
+    float getRateHz() const { return rateHz; }
+    uint32_t getMaxGapUs() const { return maxGapUs; }
+    uint32_t getDropoutCount() const { return dropoutCount; }
+    void resetStats();
+};
+
+#endif
@@ -0,0 +1,166 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "Framing.h"
+#include "Hal.h"
+#include "SpscRing.h"
+#include "config.h"
+
+class HardwareSerial;
+
+// Mensajes del firmware. En el camino de control sólo se guarda el
+// identificador y los argumentos en binario; el texto se formatea después,
+// fuera del lazo, o lo decodifica el host (tools/telemetry_decode.py lee
+// esta lista). Tipos de argumento: f = float, i = int32, u = uint32.
+//   X(identificador, "tipos", "formato")
+#define LOG_MESSAGE_LIST(X) \
+    X(LOG_MESSAGES_DROPPED,     "u",    "ADVERTENCIA: %u mensajes de log perdidos") \
+    X(LOG_FC_INIT,              "",     "Inicializando Flight Controller...") \
+    X(LOG_FC_ESC_ERROR,         "",     "Error al configurar la salida de los ESCs") \
+    X(LOG_FC_IMU_ERROR,         "",     "Error: No se pudo inicializar MPU6050!") \
+    X(LOG_FC_FIFO_ERROR,        "",     "Error: No se pudo activar el FIFO del MPU6050!") \
+    X(LOG_FC_FRAME_ERROR,       "",     "Error: FRAME_TYPE no válido") \
+    X(LOG_FC_NO_CALIBRATION,    "",     "Sin calibración guardada: mantén el dron inmóvil") \
+    X(LOG_FC_READY,             "",     "Flight Controller inicializado correctamente!") \
+    X(LOG_FAILSAFE_HOLD,        "",     "FAILSAFE: enlace perdido - nivelando") \
+    X(LOG_FAILSAFE_LANDING,     "",     "FAILSAFE: bajando throttle") \
+    X(LOG_FAILSAFE_RECOVERED,   "",     "FAILSAFE: enlace recuperado") \
+    X(LOG_ARM_FAILSAFE,         "",     "ERROR: Failsafe activo - sin enlace de mandos") \
+    X(LOG_ARM_NOT_CALIBRATED,   "",     "ERROR: Giroscopio sin calibrar - mantén el dron inmóvil") \
+    X(LOG_ARM_ESC_WAIT,         "",     "ERROR: Los ESCs aún se están armando") \
+    X(LOG_ARM_THROTTLE_HIGH,    "f",    "ERROR: Throttle muy alto (%.1f%%) - Baja a 5%% o menos para armar!") \
+    X(LOG_ARMED,                "f",    "MOTORES ARMADOS! Throttle actual: %.1f%%") \
+    X(LOG_DISARMED,             "",     "MOTORES DESARMADOS!") \
+    X(LOG_EMERGENCY_STOP,       "",     "PARADA DE EMERGENCIA ACTIVADA!") \
+    X(LOG_KEY_THROTTLE,         "f",    "Throttle: %.0f%%") \
+    X(LOG_KEY_ROLL,             "f",    "Roll: %.0f%%") \
+    X(LOG_KEY_PITCH,            "f",    "Pitch: %.0f%%") \
+    X(LOG_KEY_YAW,              "f",    "Yaw: %.0f%%") \
+    X(LOG_KEY_ARM,              "f",    "Comando: ARMAR (Throttle: %.1f%%)") \
+    X(LOG_KEY_DISARM,           "",     "Comando: DESARMAR") \
+    X(LOG_KEY_MODE_ACRO,        "",     "Modo: ACRO") \
+    X(LOG_KEY_MODE_ANGLE,       "",     "Modo: ANGULO") \
+    X(LOG_KEY_CENTER,           "",     "Controles centrados") \
+    X(LOG_KEY_EMERGENCY,        "",     "¡PARADA DE EMERGENCIA!") \
+    X(LOG_KEY_STATUS_ACRO,      "ffff", "Estado actual - T:%.0f%% R:%.0f%% P:%.0f%% Y:%.0f%% | ACRO") \
+    X(LOG_KEY_STATUS_ANGLE,     "ffff", "Estado actual - T:%.0f%% R:%.0f%% P:%.0f%% Y:%.0f%% | ANGULO") \
+    X(LOG_SERIAL_TIMEOUT,       "",     "ADVERTENCIA: Sin actividad serial - desarmando por seguridad")
+
+#define LOG_ENUM(id, types, format) id,
+enum LogMessageId {
+    LOG_MESSAGE_LIST(LOG_ENUM)
+    LOG_MESSAGE_COUNT
+};
+#undef LOG_ENUM
+
+#define LOG_MAX_ARGS        4
+#define LOG_FRAME_TYPE      0x02  // Comparte el flujo con TELEMETRY_FRAME_STATE
+
+// Argumento crudo: se guarda el patrón de bits, sin convertir
+union LogArg {
+    float f;
+    int32_t i;
+    uint32_t u;
+
+    LogArg() : u(0) {}
+    LogArg(float value) : f(value) {}
+    LogArg(int value) : i(value) {}
+    LogArg(unsigned value) : u(value) {}
+    LogArg(long value) : i((int32_t)value) {}             // int32_t en algunas toolchains
+    LogArg(unsigned long value) : u((uint32_t)value) {}   // uint32_t en algunas toolchains
+};
+
+struct LogEntry {
+    uint32_t timestampUs;
+    uint16_t id;            // LogMessageId
+    uint16_t argCount;
+    LogArg args[LOG_MAX_ARGS];
+};
+
+// Trama binaria de un mensaje (payload de encodeFrame)
+struct __attribute__((packed)) LogFrame {
+    uint8_t type;           // LOG_FRAME_TYPE
+    uint16_t id;
+    uint32_t timestampUs;
+    uint32_t args[LOG_MAX_ARGS];  // Sin usar a cero
+};
+
+struct LogMessageInfo {
+    const char* name;
+    const char* types;
+    const char* format;
+};
+
+// Registro diferido de un solo productor: una instancia por tarea. Escribir
+// cuesta copiar una entrada en la cola; si está llena el mensaje se descarta
+// y se cuenta, nunca se bloquea.
+class Logger {
+private:
+    SpscRing<LogEntry, LOG_RING_SIZE> ring;
+    HalClock clock;
+    std::atomic<uint32_t> dropped;
+
+#if TARGET_BOARD
+    static bool emit(const LogEntry& entry, HardwareSerial& port, bool binary);
+#endif
+
+    void write(LogMessageId id, uint16_t argCount, const LogArg* args) {
+        LogEntry entry;
+        entry.timestampUs = clock();
+        entry.id = (uint16_t)id;
+        entry.argCount = argCount;
+        for (uint16_t i = 0; i < argCount; i++) {
+            entry.args[i] = args[i];
+        }
+        if (!ring.push(entry)) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    explicit Logger(HalClock clockSource) : clock(clockSource), dropped(0) {}
+
+    // Productor
+    void log(LogMessageId id) { write(id, 0, nullptr); }
+    void log(LogMessageId id, LogArg a) { write(id, 1, &a); }
+    void log(LogMessageId id, LogArg a, LogArg b) {
+        LogArg args[2] = { a, b };
+        write(id, 2, args);
+    }
+    void log(LogMessageId id, LogArg a, LogArg b, LogArg c) {
+        LogArg args[3] = { a, b, c };
+        write(id, 3, args);
+    }
+    void log(LogMessageId id, LogArg a, LogArg b, LogArg c, LogArg d) {
+        LogArg args[4] = { a, b, c, d };
+        write(id, 4, args);
+    }
+
+    // Consumidor
+    bool pop(LogEntry& entry) { return ring.pop(entry); }
+    size_t pending() const { return ring.size(); }
+
+    // Mensajes descartados desde la última llamada
+    uint32_t takeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+    // Consumidor: enviar lo que quepa en la UART sin bloquear, como texto o
+    // como tramas binarias (modo telemetría). Devuelve los mensajes enviados.
+#if TARGET_BOARD
+    size_t drain(HardwareSerial& port, bool binary);
+#endif
+
+    static const LogMessageInfo& getMessage(uint16_t id);
+
+    // Texto de una entrada con el formato de su mensaje (sin salto de línea)
+    static size_t format(const LogEntry& entry, char* output, size_t size);
+
+    // Trama COBS de una entrada; `output` necesita LOG_FRAME_MAX_ENCODED bytes
+    static size_t encode(const LogEntry& entry, uint8_t* output);
+};
+
+#define LOG_FRAME_MAX_ENCODED   (COBS_MAX_ENCODED(sizeof(LogFrame) + FRAME_CRC_BYTES) + 1)
+
+#endif
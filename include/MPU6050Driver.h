@@ -0,0 +1,81 @@
+#ifndef MPU6050_DRIVER_H
+#define MPU6050_DRIVER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "I2CBus.h"
+
+// Registros del MPU6050 usados por el driver
+#define MPU6050_I2C_ADDRESS     0x68
+#define MPU6050_REG_SMPLRT_DIV  0x19
+#define MPU6050_REG_CONFIG      0x1A
+#define MPU6050_REG_GYRO_CONFIG 0x1B
+#define MPU6050_REG_ACCEL_CONFIG 0x1C
+#define MPU6050_REG_FIFO_EN     0x23
+#define MPU6050_REG_INT_PIN_CFG 0x37
+#define MPU6050_REG_INT_ENABLE  0x38
+#define MPU6050_REG_INT_STATUS  0x3A
+#define MPU6050_REG_ACCEL_XOUT_H 0x3B
+#define MPU6050_REG_USER_CTRL   0x6A
+#define MPU6050_REG_PWR_MGMT_1  0x6B
+#define MPU6050_REG_FIFO_COUNTH 0x72
+#define MPU6050_REG_FIFO_R_W    0x74
+#define MPU6050_REG_WHO_AM_I    0x75
+
+#define MPU6050_FIFO_SIZE       1024
+#define MPU6050_FIFO_SAMPLE_BYTES 12  // Accel XYZ + Gyro XYZ (sin temperatura)
+
+// Muestra cruda del FIFO con su instante de captura
+struct ImuSample {
+    int16_t accel[3];      // Cuentas del ADC
+    int16_t gyro[3];       // Cuentas del ADC
+    uint32_t timestampUs;  // Instante de muestreo en la base de tiempo de micros()
+};
+
+// Driver del MPU6050 por registros: FIFO + interrupción de datos listos.
+// Sólo depende de I2CBus, por lo que puede probarse con un bus simulado.
+class MPU6050Driver {
+private:
+    I2CBus& bus;
+    uint8_t address;
+    uint32_t samplePeriodUs;
+
+    // Actualizados desde la ISR de datos listos
+    std::atomic<uint32_t> pendingCount;
+    std::atomic<uint32_t> lastInterruptUs;
+
+    uint32_t lastSampleUs;
+    bool timestampValid;
+    uint32_t overflowCount;
+
+    bool resetFifo();
+
+public:
+    explicit MPU6050Driver(I2CBus& i2c, uint8_t addr = MPU6050_I2C_ADDRESS);
+
+    bool begin();
+    bool configure(uint8_t dlpfConfig, uint16_t sampleRateHz);
+    bool enableFifo();
+
+    // Lectura directa del bloque de registros ACCEL_XOUT_H..GYRO_ZOUT_L (14 bytes)
+    bool readRaw(ImuSample& sample);
+
+    // Llamar desde la ISR del pin INT con el instante actual. En línea: la
+    // ISR va en IRAM y puede saltar con la caché de flash apagada (escrituras
+    // en NVS o en la partición del blackbox), así que no puede llamar a
+    // código en flash. Sólo toca atómicos del propio objeto (DRAM).
+    inline void handleDataReady(uint32_t nowUs) {
+        lastInterruptUs.store(nowUs, std::memory_order_relaxed);
+        pendingCount.fetch_add(1, std::memory_order_release);
+    }
+    uint32_t pendingSamples() const { return pendingCount.load(std::memory_order_acquire); }
+
+    // Vacía el FIFO en una ráfaga y devuelve el número de muestras leídas
+    size_t readFifo(ImuSample* samples, size_t maxSamples);
+
+    uint32_t getSamplePeriodUs() const { return samplePeriodUs; }
+    uint32_t getOverflowCount() const { return overflowCount; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef MAHONY_AHRS_H
+#define MAHONY_AHRS_H
+
+// Estimador de actitud por cuaterniones (filtro de Mahony).
+// Integra el giroscopio sin singularidades y corrige la deriva de roll y
+// pitch con la dirección de la gravedad medida por el acelerómetro.
+class MahonyAHRS {
+public:
+    struct Config {
+        float kp;   // Ganancia proporcional de corrección por gravedad
+        float ki;   // Ganancia integral (compensa sesgo del giroscopio)
+    };
+
+private:
+    float q0, q1, q2, q3;                       // Cuaternión cuerpo -> tierra
+    float integralX, integralY, integralZ;      // Término integral de la corrección
+    float twoKp, twoKi;
+    bool initialized;
+
+    void initFromAccel(float ax, float ay, float az);
+
+public:
+    MahonyAHRS(float kp, float ki);
+    explicit MahonyAHRS(const Config& config) : MahonyAHRS(config.kp, config.ki) {}
+
+    // Giroscopio en rad/s, acelerómetro en cualquier unidad, dt en segundos
+    void update(float gx, float gy, float gz, float ax, float ay, float az, float dt);
+    void reset();
+
+    // Ángulos de Euler en grados (yaw en 0-360)
+    float getRoll() const;
+    float getPitch() const;
+    float getYaw() const;
+};
+
+#endif
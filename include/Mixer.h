@@ -0,0 +1,54 @@
+#ifndef MIXER_H
+#define MIXER_H
+
+#include <stdint.h>
+#include "config.h"
+
+#define MIXER_MAX_MOTORS    8
+
+// Fila de la matriz de mezcla: contribución de cada eje a un motor.
+// Roll positivo sube los motores de la derecha, pitch positivo los de atrás
+// y yaw positivo los que giran en sentido horario.
+struct MixerRule {
+    float roll;
+    float pitch;
+    float yaw;
+};
+
+// Mezclador por tabla. Las entradas y salidas están normalizadas: throttle
+// y motores en [0, 1], correcciones de actitud en la misma escala.
+class Mixer {
+public:
+    static constexpr int maxMotors = MIXER_MAX_MOTORS;
+
+private:
+    // Matriz guardada por columnas para recorrer todos los motores seguidos
+    float rollGain[MIXER_MAX_MOTORS];
+    float pitchGain[MIXER_MAX_MOTORS];
+    float yawGain[MIXER_MAX_MOTORS];
+    int motorCount;
+    bool airmode;
+    bool saturated;
+    uint32_t saturationCount;
+
+public:
+    Mixer();
+
+    // Cargar una de las tablas predefinidas (FRAME_*); false si no existe
+    bool setFrame(int frameType);
+    bool setRules(const MixerRule* rules, int count);
+    void setAirmode(bool enable) { airmode = enable; }
+
+    // Calcula las salidas de todos los motores. Si las correcciones no caben
+    // entre 0 y 1 se desplaza el throttle (o se escalan si ocupan más que el
+    // rango completo) para no perder autoridad de actitud. Sin airmode el
+    // throttle sólo se baja; con airmode también se sube a throttle cero.
+    void mix(float throttle, float roll, float pitch, float yaw, float* outputs);
+
+    int getMotorCount() const { return motorCount; }
+    bool isAirmode() const { return airmode; }
+    bool isSaturated() const { return saturated; }
+    uint32_t getSaturationCount() const { return saturationCount; }
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef OUTPUT_SHAPING_H
+#define OUTPUT_SHAPING_H
+
+#include <stddef.h>
+#include <array>
+#include "config.h"
+
+// Conformado de la salida entre el mezclador y los ESC. Las curvas se
+// evalúan en tiempo de compilación en tablas de OUTPUT_LUT_SIZE puntos;
+// en el lazo cada motor cuesta una búsqueda con interpolación lineal.
+
+static_assert(OUTPUT_LUT_SIZE >= 2, "OUTPUT_LUT_SIZE demasiado pequeño");
+
+struct OutputShapingConfig {
+    float throttleMid;          // Punto medio de la curva de throttle, en (0, 1)
+    float throttleExpo;         // 0 = lineal; hasta 1 = más fina cerca del punto medio
+    float thrustLinearization;  // Parte cuadrática del empuje, en [0, 1); 0 = desactivada
+};
+
+// Raíz cuadrada evaluable en tiempo de compilación (Newton)
+constexpr float constexprSqrt(float x) {
+    if (x <= 0.0f) return 0.0f;
+    float y = x > 1.0f ? x : 1.0f;
+    for (int i = 0; i < 32; i++) {
+        y = 0.5f * (y + x / y);
+    }
+    return y;
+}
+
+// Curva de throttle: pasa por 0, throttleMid y 1, y con expo se aplana
+// alrededor del punto medio para afinar el vuelo estacionario
+constexpr float throttleCurve(const OutputShapingConfig& config, float x) {
+    float delta = x - config.throttleMid;
+    float range = delta < 0.0f ? config.throttleMid : 1.0f - config.throttleMid;
+    float normalized = delta / range;
+    return config.throttleMid +
+           delta * (1.0f - config.throttleExpo + config.throttleExpo * normalized * normalized);
+}
+
+// Empuje modelado como (1 - a) * c + a * c²; devuelve el mando c que da el
+// empuje pedido, así la autoridad del PID no depende del throttle
+constexpr float thrustToCommand(const OutputShapingConfig& config, float thrust) {
+    if (config.thrustLinearization <= 0.0f) return thrust;
+    const float a = config.thrustLinearization;
+    return (constexprSqrt((1.0f - a) * (1.0f - a) + 4.0f * a * thrust) - (1.0f - a)) / (2.0f * a);
+}
+
+// Tablas de un marco. Se construye como constexpr a partir de su
+// configuración (ver FlightPipeline), así las tablas van en flash.
+class OutputShaper {
+private:
+    typedef std::array<float, OUTPUT_LUT_SIZE> Table;
+
+    Table throttleTable;
+    Table thrustTable;
+
+    static constexpr bool isMonotonic(const Table& table) {
+        for (size_t i = 1; i < OUTPUT_LUT_SIZE; i++) {
+            if (table[i] < table[i - 1]) return false;
+        }
+        return table[0] >= 0.0f && table[OUTPUT_LUT_SIZE - 1] <= 1.0001f;
+    }
+
+    static float lookup(const Table& table, float x) {
+        if (x <= 0.0f) return table[0];
+        if (x >= 1.0f) return table[OUTPUT_LUT_SIZE - 1];
+        float position = x * (OUTPUT_LUT_SIZE - 1);
+        int index = (int)position;
+        float fraction = position - index;
+        return table[index] + (table[index + 1] - table[index]) * fraction;
+    }
+
+public:
+    constexpr explicit OutputShaper(const OutputShapingConfig& config) : throttleTable(), thrustTable() {
+        for (size_t i = 0; i < OUTPUT_LUT_SIZE; i++) {
+            float x = (float)i / (OUTPUT_LUT_SIZE - 1);
+            throttleTable[i] = throttleCurve(config, x);
+            thrustTable[i] = thrustToCommand(config, x);
+        }
+    }
+
+    // Una curva no monótona invertiría el mando: se comprueba al compilar
+    constexpr bool isValid() const { return isMonotonic(throttleTable) && isMonotonic(thrustTable); }
+
+    // Throttle del piloto (0-1) tras la curva
+    float shapeThrottle(float throttle) const { return lookup(throttleTable, throttle); }
+
+    // Salidas del mezclador (empuje 0-1) convertidas en mando a los ESC, en sitio
+    void linearizeThrust(float* outputs, int count) const {
+        for (int i = 0; i < count; i++) {
+            outputs[i] = lookup(thrustTable, outputs[i]);
+        }
+    }
+};
+
+#endif
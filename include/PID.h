@@ -1,22 +1,49 @@
 #ifndef PID_H
 #define PID_H
 
+#include "Filters.h"
+
 class PIDController {
 private:
-    float kp, ki, kd;
+    float kp, ki, kd, kf;
     float integral;
     float lastError;
+    float lastReference;        // Última referencia del feedforward
+    float lastInput;
+    bool hasHistory;            // Hay muestra anterior para derivar
+    bool derivativeOnMeasurement;
     float maxOutput;
     unsigned long lastTime;
+    float pTerm, iTerm, dTerm, fTerm;  // Últimos términos calculados
+    Biquad dTermFilter;         // Paso bajo del término derivativo
+    Biquad feedforwardFilter;   // Paso bajo de la derivada de la consigna
     
 public:
     PIDController(float p, float i, float d, float maxOut) 
-        : kp(p), ki(i), kd(d), maxOutput(maxOut), integral(0), lastError(0), lastTime(0) {}
+        : kp(p), ki(i), kd(d), kf(0), maxOutput(maxOut), integral(0), lastError(0),
+          lastReference(0), lastInput(0), hasHistory(false), derivativeOnMeasurement(false),
+          lastTime(0), pTerm(0), iTerm(0), dTerm(0), fTerm(0) {}
     
-    float compute(float setpoint, float input, float dt);
+    float compute(float setpoint, float input, float dt) { return compute(setpoint, input, dt, setpoint); }
+    // Feedforward sobre otra señal que la consigna (p. ej. la parte de los
+    // sticks de una consigna que también depende de la medida)
+    float compute(float setpoint, float input, float dt, float feedforwardReference);
     void reset();
     void setTunings(float p, float i, float d);
     void setOutputLimits(float maxOut);
+    void setDerivativeFilter(float cutoffHz, float sampleRateHz);
+    
+    // Feedforward: kf por la velocidad de cambio de la consigna (o de la referencia)
+    void setFeedforward(float f) { kf = f; }
+    void setFeedforwardFilter(float cutoffHz, float sampleRateHz);
+    
+    // Derivar la medida en lugar del error: sin picos al saltar la consigna
+    void setDerivativeOnMeasurement(bool enable) { derivativeOnMeasurement = enable; }
+    
+    float getPTerm() const { return pTerm; }
+    float getITerm() const { return iTerm; }
+    float getDTerm() const { return dTerm; }
+    float getFTerm() const { return fTerm; }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,35 @@
+#ifndef PARAMETER_CONSOLE_H
+#define PARAMETER_CONSOLE_H
+
+#include <Arduino.h>
+#include "ParameterStore.h"
+#include "Parameters.h"
+
+#define PARAMETER_LINE_LENGTH   64
+
+// Órdenes de parámetros por la consola serie, en líneas que empiezan por '$':
+//   $list | $get <nombre> | $set <nombre> <valor> | $save | $defaults
+// El resto de teclas sigue yendo al KeyboardController.
+class ParameterConsole {
+private:
+    ParameterRegistry& registry;
+    ParameterStore& store;
+    char line[PARAMETER_LINE_LENGTH];
+    size_t length;
+    bool collecting;
+    bool changed;
+
+    void execute(bool armed);
+    void printParameter(int id);
+
+public:
+    ParameterConsole(ParameterRegistry& parameterRegistry, ParameterStore& parameterStore);
+
+    // Devuelve true si la tecla pertenece a una orden de parámetros
+    bool processKey(char key, bool armed);
+
+    // Devuelve true una vez tras cada cambio de valores
+    bool takeChanged();
+};
+
+#endif
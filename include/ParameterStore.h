@@ -0,0 +1,22 @@
+#ifndef PARAMETER_STORE_H
+#define PARAMETER_STORE_H
+
+#include "Parameters.h"
+
+// Parámetros persistidos en NVS (Preferences), una clave por parámetro.
+// Las claves ausentes o fuera de rango conservan el valor por defecto, así
+// que añadir parámetros no invalida lo ya guardado.
+class ParameterStore {
+private:
+    const char* nvsNamespace;
+
+public:
+    explicit ParameterStore(const char* name) : nvsNamespace(name) {}
+
+    // Devuelve el número de parámetros cargados
+    int load(ParameterRegistry& registry);
+    bool save(const ParameterRegistry& registry);
+    bool clear();
+};
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef PARAMETERS_H
+#define PARAMETERS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+
+// Parámetros ajustables en vuelo. Los valores de la lista son los de
+// config.h; cada marco puede darle otros al registro (AirframeConfig). El
+// nombre es también la clave en NVS (máx. 15 caracteres).
+//   X(campo, "nombre", tipo, defecto, mínimo, máximo)
+#define PARAMETER_LIST(X) \
+    X(rollP,          "roll_p",         float,   PID_P_GAIN_ROLL,    0.0f,  10.0f)  \
+    X(rollI,          "roll_i",         float,   PID_I_GAIN_ROLL,    0.0f,  10.0f)  \
+    X(rollD,          "roll_d",         float,   PID_D_GAIN_ROLL,    0.0f,  1.0f)   \
+    X(rollMax,        "roll_max",       float,   PID_MAX_ROLL,       0.0f,  1000.0f) \
+    X(rollF,          "roll_f",         float,   PID_F_GAIN_ROLL,    0.0f,  1.0f)   \
+    X(pitchP,         "pitch_p",        float,   PID_P_GAIN_PITCH,   0.0f,  10.0f)  \
+    X(pitchI,         "pitch_i",        float,   PID_I_GAIN_PITCH,   0.0f,  10.0f)  \
+    X(pitchD,         "pitch_d",        float,   PID_D_GAIN_PITCH,   0.0f,  1.0f)   \
+    X(pitchMax,       "pitch_max",      float,   PID_MAX_PITCH,      0.0f,  1000.0f) \
+    X(pitchF,         "pitch_f",        float,   PID_F_GAIN_PITCH,   0.0f,  1.0f)   \
+    X(yawP,           "yaw_p",          float,   PID_P_GAIN_YAW,     0.0f,  10.0f)  \
+    X(yawI,           "yaw_i",          float,   PID_I_GAIN_YAW,     0.0f,  10.0f)  \
+    X(yawD,           "yaw_d",          float,   PID_D_GAIN_YAW,     0.0f,  1.0f)   \
+    X(yawMax,         "yaw_max",        float,   PID_MAX_YAW,        0.0f,  1000.0f) \
+    X(yawF,           "yaw_f",          float,   PID_F_GAIN_YAW,     0.0f,  1.0f)   \
+    X(angleRollP,     "angle_roll_p",   float,   ANGLE_P_GAIN_ROLL,  0.0f,  20.0f)  \
+    X(anglePitchP,    "angle_pitch_p",  float,   ANGLE_P_GAIN_PITCH, 0.0f,  20.0f)  \
+    X(angleMaxRate,   "angle_max_rate", float,   ANGLE_MAX_RATE,     0.0f,  240.0f) \
+    X(maxAngleRoll,   "max_angle_roll", float,   MAX_ANGLE_ROLL,     0.0f,  80.0f)  \
+    X(maxAnglePitch,  "max_angle_pitch",float,   MAX_ANGLE_PITCH,    0.0f,  80.0f)  \
+    X(maxRateYaw,     "max_rate_yaw",   float,   MAX_RATE_YAW,       0.0f,  240.0f) \
+    X(acroMaxRate,    "acro_max_rate",  float,   ACRO_MAX_RATE,      0.0f,  240.0f) \
+    X(gyroLpfHz,      "gyro_lpf_hz",    float,   GYRO_LPF_HZ,        0.0f,  500.0f) \
+    X(gyroNotchHz,    "gyro_notch_hz",  float,   GYRO_NOTCH_HZ,      0.0f,  500.0f) \
+    X(gyroNotchQ,     "gyro_notch_q",   float,   GYRO_NOTCH_Q,       0.1f,  20.0f)  \
+    X(dynNotchQ,      "dyn_notch_q",    float,   DYN_NOTCH_Q,        0.5f,  20.0f)  \
+    X(accelLpfHz,     "accel_lpf_hz",   float,   ACCEL_LPF_HZ,       0.0f,  100.0f) \
+    X(dtermLpfHz,     "dterm_lpf_hz",   float,   DTERM_LPF_HZ,       0.0f,  500.0f) \
+    X(feedforwardLpfHz, "ff_lpf_hz",    float,   FEEDFORWARD_LPF_HZ, 0.0f,  500.0f) \
+    X(dOnMeasurement, "d_on_meas",      int32_t, PID_D_ON_MEASUREMENT, 0,   1)      \
+    X(airmode,        "airmode",        int32_t, MIXER_AIRMODE,      0,     1)
+
+// Instantánea de todos los parámetros. La tarea de control la recibe entera
+// al principio de un tick y lee los campos directamente, sin búsquedas.
+#define PARAMETER_FIELD(field, name, type, initial, min, max) type field;
+struct FlightParameters {
+    PARAMETER_LIST(PARAMETER_FIELD)
+};
+#undef PARAMETER_FIELD
+
+// Valores de config.h, en el orden de la lista
+#define PARAMETER_INITIAL(field, name, type, initial, min, max) (type)(initial),
+constexpr FlightParameters DEFAULT_FLIGHT_PARAMETERS = {
+    PARAMETER_LIST(PARAMETER_INITIAL)
+};
+#undef PARAMETER_INITIAL
+
+#define PARAMETER_ENUM(field, name, type, initial, min, max) PARAMETER_ID_##field,
+enum ParameterId {
+    PARAMETER_LIST(PARAMETER_ENUM)
+    PARAMETER_COUNT
+};
+#undef PARAMETER_ENUM
+
+enum ParameterType {
+    PARAMETER_FLOAT,
+    PARAMETER_INT
+};
+
+enum ParameterStatus {
+    PARAMETER_OK,
+    PARAMETER_UNKNOWN,
+    PARAMETER_OUT_OF_RANGE
+};
+
+struct ParameterDescriptor {
+    const char* name;
+    ParameterType type;
+    size_t offset;      // Dentro de FlightParameters
+    float minValue;
+    float maxValue;
+};
+
+// Registro tipado de parámetros por nombre. Sólo lo usa la tarea de
+// comunicaciones; el control recibe copias de getValues() por un canal.
+// Código puro, sin Arduino.
+class ParameterRegistry {
+private:
+    FlightParameters defaultValues;  // Los del marco; resetToDefaults() vuelve a ellos
+    FlightParameters values;
+    uint32_t revision;  // Cambia con cada escritura aceptada
+
+public:
+    explicit ParameterRegistry(const FlightParameters& defaults = DEFAULT_FLIGHT_PARAMETERS);
+
+    static int getCount() { return PARAMETER_COUNT; }
+    static const ParameterDescriptor& getDescriptor(int id);
+
+    // Devuelve el identificador o -1 si el nombre no existe
+    static int find(const char* name);
+
+    float get(int id) const;
+    ParameterStatus set(int id, float value);
+    ParameterStatus set(const char* name, float value);
+    void resetToDefaults();
+
+    const FlightParameters& getValues() const { return values; }
+    const FlightParameters& getDefaults() const { return defaultValues; }
+    uint32_t getRevision() const { return revision; }
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef PARTITION_FLASH_STORE_H
+#define PARTITION_FLASH_STORE_H
+
+#include "FlashStore.h"
+#include "esp_partition.h"
+
+// Implementación de FlashStore sobre una partición de datos de la flash SPI
+// (ver partitions.csv). Mientras se borra o escribe la caché de la flash se
+// desactiva y el otro núcleo se detiene si ejecuta código desde flash.
+class PartitionFlashStore : public FlashStore {
+private:
+    const esp_partition_t* partition;
+
+public:
+    PartitionFlashStore() : partition(nullptr) {}
+
+    // Busca la partición de datos por nombre
+    bool begin(const char* label);
+
+    size_t size() const override;
+    size_t sectorSize() const override { return SPI_FLASH_SEC_SIZE; }
+    bool read(size_t offset, uint8_t* data, size_t length) override;
+    bool write(size_t offset, const uint8_t* data, size_t length) override;
+    bool eraseSector(size_t offset) override;
+};
+
+#endif
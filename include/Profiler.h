@@ -0,0 +1,90 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Etapas medidas. Cada etapa tiene un único escritor (tarea de control o de
+// comunicaciones), por lo que las estadísticas no necesitan bloqueos.
+enum ProfileStage {
+    PROFILE_READ_SENSORS,
+    PROFILE_DYNAMIC_NOTCH,
+    PROFILE_CALCULATE_ANGLES,
+    PROFILE_ARM_LOGIC,
+    PROFILE_COMPUTE_PID,
+    PROFILE_UPDATE_MOTORS,
+    PROFILE_CONTROL_LOOP,   // Iteración completa; cuenta los excesos sobre LOOP_TIME_US
+    PROFILE_INPUT,
+    PROFILE_STATUS,
+    PROFILE_STAGE_COUNT
+};
+
+#if ENABLE_PROFILER
+
+#include <Arduino.h>
+#include <atomic>
+
+struct ProfileStats {
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+    uint32_t overruns;
+    uint32_t histogram[PROFILER_BUCKETS];
+};
+
+class Profiler {
+private:
+    ProfileStats stats[PROFILE_STAGE_COUNT];
+    std::atomic<bool> resetPending[PROFILE_STAGE_COUNT];
+    uint32_t overrunCycles;
+
+    static void clear(ProfileStats& s);
+
+public:
+    Profiler();
+
+    static inline uint32_t cycles() { return ESP.getCycleCount(); }
+
+    void record(ProfileStage stage, uint32_t elapsedCycles);
+
+    // Registra la etapa desde `start` y devuelve el nuevo instante de inicio
+    inline uint32_t lap(ProfileStage stage, uint32_t start) {
+        uint32_t now = cycles();
+        record(stage, now - start);
+        return now;
+    }
+
+    // Imprime las estadísticas acumuladas y empieza una nueva ventana
+    void report(HardwareSerial& port);
+    void reset();
+};
+
+extern Profiler profiler;
+
+// Medición de un ámbito completo
+class ProfileScope {
+private:
+    ProfileStage stage;
+    uint32_t start;
+
+public:
+    explicit ProfileScope(ProfileStage s) : stage(s), start(Profiler::cycles()) {}
+    ~ProfileScope() { profiler.record(stage, Profiler::cycles() - start); }
+};
+
+#define PROFILE_CONCAT_(a, b)   a##b
+#define PROFILE_CONCAT(a, b)    PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(stage)    ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(stage)
+#define PROFILE_START()         uint32_t profileLap = Profiler::cycles()
+#define PROFILE_LAP(stage)      profileLap = profiler.lap(stage, profileLap)
+
+#else
+
+#define PROFILE_SCOPE(stage)
+#define PROFILE_START()
+#define PROFILE_LAP(stage)
+
+#endif
+
+#endif
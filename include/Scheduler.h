@@ -0,0 +1,64 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdint.h>
+
+#define SCHEDULER_MAX_TASKS     16  // Huecos por planificador (comunicaciones usa 10)
+#define SCHEDULER_PRIORITY_CRITICAL 0   // Se ejecuta en cada tick, nunca se aplaza
+
+typedef void (*SchedulerCallback)(void* context);
+typedef uint32_t (*SchedulerClock)();
+
+struct SchedulerTask {
+    const char* name;
+    SchedulerCallback callback;
+    void* context;
+    uint32_t periodUs;      // 0 = en cada tick
+    uint8_t priority;       // Menor valor = más prioritaria
+    uint32_t budgetUs;      // Tiempo de CPU previsto por ejecución
+    uint32_t nextRunUs;
+
+    // Estadísticas
+    uint32_t runCount;
+    uint32_t overrunCount;  // Ejecuciones que superaron su presupuesto
+    uint32_t deferCount;    // Ticks en que se aplazó por falta de margen
+    uint32_t skipCount;     // Periodos perdidos por completo
+    uint32_t maxDurationUs;
+};
+
+// Planificador cooperativo multifrecuencia. En cada tick ejecuta primero las
+// tareas críticas y después, por prioridad, las que tocan y caben en el
+// margen que queda hasta el siguiente tick. El reloj se inyecta, así que
+// puede probarse en el host con un reloj simulado.
+class Scheduler {
+private:
+    SchedulerTask tasks[SCHEDULER_MAX_TASKS];
+    int taskCount;
+    SchedulerClock clock;
+    uint32_t tickPeriodUs;
+    uint32_t nextTickUs;
+    uint32_t tickCount;
+    bool started;
+
+public:
+    Scheduler(SchedulerClock clockSource, uint32_t tickPeriod);
+
+    // Registra una tarea; periodUs = 0 la ejecuta en cada tick.
+    // Devuelve el índice o -1 si no quedan huecos.
+    int addTask(const char* name, SchedulerCallback callback, void* context,
+                uint32_t periodUs, uint8_t priority, uint32_t budgetUs);
+
+    // Ejecuta un tick si ha llegado su momento según el reloj
+    bool poll();
+
+    // Ejecuta un tick que empezó en `tickStartUs` (p. ej. marcado por una interrupción)
+    void runTick(uint32_t tickStartUs);
+
+    uint32_t getTickPeriodUs() const { return tickPeriodUs; }
+    uint32_t getTickCount() const { return tickCount; }
+    int getTaskCount() const { return taskCount; }
+    const SchedulerTask& getTask(int index) const { return tasks[index]; }
+    void resetStats();
+};
+
+#endif
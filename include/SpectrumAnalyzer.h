@@ -0,0 +1,62 @@
+#ifndef SPECTRUM_ANALYZER_H
+#define SPECTRUM_ANALYZER_H
+
+#include "Filters.h"
+#include "config.h"
+
+#define SPECTRUM_MAX_BINS   (DYN_NOTCH_SDFT_SIZE / 2 + 1)
+#define SPECTRUM_MAX_PEAKS  2
+
+static_assert((DYN_NOTCH_SDFT_SIZE & (DYN_NOTCH_SDFT_SIZE - 1)) == 0,
+              "DYN_NOTCH_SDFT_SIZE debe ser potencia de dos");
+
+// Analizador de espectro del giroscopio por DFT deslizante (SDFT). Cada
+// muestra actualiza sólo los bins del rango vigilado, O(bins) por muestra y
+// sin transformadas completas. La búsqueda de picos se reparte entre ticks:
+// step() analiza un eje cada vez. Código puro, sin hardware.
+class SpectrumAnalyzer {
+public:
+    static constexpr int maxPeaks = SPECTRUM_MAX_PEAKS;
+
+private:
+    // Ventana de las últimas DYN_NOTCH_SDFT_SIZE muestras de cada eje
+    float history[FILTER_AXES][DYN_NOTCH_SDFT_SIZE];
+    int historyIndex;
+
+    // Bins complejos [firstBin, firstBin + binCount), con un bin de margen a
+    // cada lado del rango para la ventana de Hann en frecuencia
+    float binRe[FILTER_AXES][SPECTRUM_MAX_BINS];
+    float binIm[FILTER_AXES][SPECTRUM_MAX_BINS];
+    float twiddleRe[SPECTRUM_MAX_BINS];  // r * e^(j2πk/N)
+    float twiddleIm[SPECTRUM_MAX_BINS];
+    float dampingN;                      // r^N: mantiene estable la recursión
+    int firstBin;
+    int binCount;
+    float binWidth;
+
+    // Picos seguidos por eje (Hz, 0 = ninguno), ordenados por frecuencia
+    float peakHz[FILTER_AXES][SPECTRUM_MAX_PEAKS];
+    int peakCount;
+    int nextAxis;
+    float threshold;  // Factor sobre la media del rango para aceptar un pico
+    float smoothing;  // Seguimiento de la frecuencia por análisis (0-1]
+
+public:
+    SpectrumAnalyzer();
+
+    // Vigilar [minHz, maxHz] buscando hasta `peaks` picos por eje
+    void init(float sampleRateHz, float minHz, float maxHz, int peaks,
+              float peakThreshold, float peakSmoothing);
+
+    // Una muestra cruda de los tres ejes (cada muestra del sensor)
+    void addSample(const float values[FILTER_AXES]);
+
+    // Analiza el siguiente eje (una vez por tick); devuelve el eje o -1
+    int step();
+
+    float getPeak(int axis, int peak) const { return peakHz[axis][peak]; }
+    int getPeakCount() const { return peakCount; }
+    float getBinWidth() const { return binWidth; }
+};
+
+#endif
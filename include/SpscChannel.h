@@ -0,0 +1,46 @@
+#ifndef SPSC_CHANNEL_H
+#define SPSC_CHANNEL_H
+
+#include <stdint.h>
+#include <atomic>
+
+// Canal de un productor y un consumidor sin bloqueos (triple buffer).
+// El productor nunca espera y el consumidor siempre obtiene el último
+// valor publicado completo. Sólo depende de std::atomic, por lo que
+// compila igual en el ESP32 y en el host.
+template <typename T>
+class SpscChannel {
+private:
+    static const uint32_t INDEX_MASK = 0x03;
+    static const uint32_t FRESH_BIT = 0x04;  // Hay un valor sin consumir
+
+    T buffers[3];
+    std::atomic<uint32_t> middle;  // Buffer intercambiable + bit de nuevo
+    uint32_t writeIndex;           // Sólo lo toca el productor
+    uint32_t readIndex;            // Sólo lo toca el consumidor
+
+public:
+    SpscChannel() : buffers(), middle(1), writeIndex(0), readIndex(2) {}
+
+    // Productor: publicar una copia completa del valor
+    void publish(const T& value) {
+        buffers[writeIndex] = value;
+        uint32_t previous = middle.exchange(writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Consumidor: obtener el último valor si hay uno nuevo desde la última lectura
+    bool consume(T& out) {
+        if (!(middle.load(std::memory_order_acquire) & FRESH_BIT)) return false;
+        uint32_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        out = buffers[readIndex];
+        return true;
+    }
+
+    bool hasNew() const {
+        return (middle.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,121 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+
+// Cola circular de un productor y un consumidor sin bloqueos.
+// La capacidad debe ser potencia de dos. Las escrituras son todo o nada,
+// así un bloque (p. ej. una trama) nunca queda partido en la cola.
+template <typename T, size_t N>
+class SpscRing {
+private:
+    static_assert((N & (N - 1)) == 0, "La capacidad debe ser potencia de dos");
+
+    T buffer[N];
+    std::atomic<uint32_t> head;  // Próxima posición a escribir (productor)
+    std::atomic<uint32_t> tail;  // Próxima posición a leer (consumidor)
+
+public:
+    SpscRing() : buffer(), head(0), tail(0) {}
+
+    static size_t capacity() { return N; }
+
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    size_t space() const { return N - size(); }
+
+    // Productor: copiar `count` elementos o ninguno si no caben
+    bool push(const T* items, size_t count) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t t = tail.load(std::memory_order_acquire);
+        if (N - (h - t) < count) return false;
+
+        for (size_t i = 0; i < count; i++) {
+            buffer[(h + i) & (N - 1)] = items[i];
+        }
+        head.store(h + (uint32_t)count, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T& item) { return push(&item, 1); }
+
+    // Consumidor: extraer hasta `maxCount` elementos
+    size_t pop(T* items, size_t maxCount) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t h = head.load(std::memory_order_acquire);
+        size_t count = h - t;
+        if (count > maxCount) count = maxCount;
+
+        for (size_t i = 0; i < count; i++) {
+            items[i] = buffer[(t + i) & (N - 1)];
+        }
+        tail.store(t + (uint32_t)count, std::memory_order_release);
+        return count;
+    }
+
+    bool pop(T& item) { return pop(&item, 1) == 1; }
+};
+
+// Variante de bytes con almacenamiento externo y capacidad fijada en
+// tiempo de ejecución, para buffers grandes reservados en PSRAM.
+class SpscByteRing {
+private:
+    uint8_t* buffer;
+    uint32_t mask;
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+
+public:
+    SpscByteRing() : buffer(nullptr), mask(0), head(0), tail(0) {}
+
+    // `capacity` debe ser potencia de dos; llamar antes de usar la cola
+    bool attach(uint8_t* storage, size_t capacity) {
+        if (storage == nullptr || capacity == 0 || (capacity & (capacity - 1)) != 0) return false;
+        buffer = storage;
+        mask = (uint32_t)capacity - 1;
+        head.store(0, std::memory_order_relaxed);
+        tail.store(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    size_t capacity() const { return buffer ? (size_t)mask + 1 : 0; }
+
+    size_t size() const {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    size_t space() const { return capacity() - size(); }
+
+    bool push(const uint8_t* data, size_t count) {
+        if (buffer == nullptr) return false;
+        uint32_t h = head.load(std::memory_order_relaxed);
+        uint32_t t = tail.load(std::memory_order_acquire);
+        if (mask + 1 - (h - t) < count) return false;
+
+        for (size_t i = 0; i < count; i++) {
+            buffer[(h + i) & mask] = data[i];
+        }
+        head.store(h + (uint32_t)count, std::memory_order_release);
+        return true;
+    }
+
+    size_t pop(uint8_t* data, size_t maxCount) {
+        if (buffer == nullptr) return 0;
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t h = head.load(std::memory_order_acquire);
+        size_t count = h - t;
+        if (count > maxCount) count = maxCount;
+
+        for (size_t i = 0; i < count; i++) {
+            data[i] = buffer[(t + i) & mask];
+        }
+        tail.store(t + (uint32_t)count, std::memory_order_release);
+        return count;
+    }
+};
+
+#endif
\ No newline at end of file
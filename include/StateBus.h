@@ -0,0 +1,140 @@
+#ifndef STATE_BUS_H
+#define STATE_BUS_H
+
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include "Mixer.h"
+
+// Tema de un solo publicador protegido por seqlock. El publicador nunca
+// espera; los lectores reintentan si la lectura coincide con una escritura
+// y siempre obtienen una instantánea completa. El valor se guarda en
+// palabras atómicas para que la copia concurrente esté bien definida.
+// T debe ser copiable con memcpy. Sin memoria dinámica.
+template <typename T>
+class Topic {
+private:
+    static const size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> sequence;  // Impar mientras se escribe
+    std::atomic<uint32_t> timestamp;
+    std::atomic<uint32_t> words[WORDS];
+
+public:
+    Topic() : sequence(0), timestamp(0) {
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Publicador (una sola tarea)
+    void publish(const T& value, uint32_t timestampUs) {
+        uint32_t buffer[WORDS];
+        buffer[WORDS - 1] = 0;
+        memcpy(buffer, &value, sizeof(T));
+
+        uint32_t current = sequence.load(std::memory_order_relaxed);
+        sequence.store(current + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++) {
+            words[i].store(buffer[i], std::memory_order_relaxed);
+        }
+        timestamp.store(timestampUs, std::memory_order_relaxed);
+
+        sequence.store(current + 2, std::memory_order_release);
+    }
+
+    // Cualquier tarea. Devuelve la secuencia de la instantánea (0 = nunca publicado)
+    uint32_t read(T& out, uint32_t* timestampUs = nullptr) const {
+        uint32_t buffer[WORDS];
+        uint32_t before, stamp;
+        for (;;) {
+            before = sequence.load(std::memory_order_acquire);
+            if (before & 1) continue;
+
+            for (size_t i = 0; i < WORDS; i++) {
+                buffer[i] = words[i].load(std::memory_order_relaxed);
+            }
+            stamp = timestamp.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) break;
+        }
+
+        memcpy(&out, buffer, sizeof(T));
+        if (timestampUs) *timestampUs = stamp;
+        return before;
+    }
+
+    uint32_t getSequence() const { return sequence.load(std::memory_order_acquire); }
+};
+
+// Lector de un tema que recuerda la última instantánea vista
+template <typename T>
+class Subscriber {
+private:
+    const Topic<T>& topic;
+    uint32_t lastSequence;
+
+public:
+    explicit Subscriber(const Topic<T>& source) : topic(source), lastSequence(0) {}
+
+    // ¿Se ha publicado algo desde la última lectura?
+    bool hasChanged() const { return topic.getSequence() != lastSequence; }
+
+    // Siempre copia la última instantánea; devuelve true si es nueva
+    bool read(T& out, uint32_t* timestampUs = nullptr) {
+        uint32_t current = topic.read(out, timestampUs);
+        bool changed = current != lastSequence;
+        lastSequence = current;
+        return changed;
+    }
+};
+
+// ---- Temas del controlador de vuelo ----
+
+struct ImuState {
+    int16_t rawGyro[3];     // Cuentas del ADC
+    int16_t rawAccel[3];
+    float rates[3];         // Giroscopio filtrado (grados/s)
+    float accel[3];         // Acelerómetro filtrado (m/s²)
+};
+
+struct AttitudeState {
+    float roll, pitch, yaw; // Grados
+};
+
+struct SetpointState {
+    float throttle;         // 0-100%
+    float rollRate;         // Consignas del lazo de velocidad (grados/s)
+    float pitchRate;
+    float yawRate;
+    bool acroMode;
+};
+
+struct MotorState {
+    static constexpr int maxMotors = MIXER_MAX_MOTORS;
+
+    uint16_t outputs[maxMotors];  // Pulso de cada ESC (us), 0 si no existe
+    uint8_t count;
+};
+
+struct StatusState {
+    bool armed;
+    bool calibrated;
+    uint8_t failsafe;       // FailsafeState
+};
+
+// Bus de estado: temas fijos publicados por la tarea de control al final de
+// cada tick. Los consumidores (estado, seguridad, registro...) leen sólo lo
+// que necesitan sin depender de FlightController.
+struct StateBus {
+    Topic<ImuState> imu;
+    Topic<AttitudeState> attitude;
+    Topic<SetpointState> setpoints;
+    Topic<MotorState> motors;
+    Topic<StatusState> status;
+};
+
+#endif
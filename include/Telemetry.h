@@ -0,0 +1,52 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "FlightController.h"
+#include "Framing.h"
+#include "SpscRing.h"
+#include "config.h"
+
+#define TELEMETRY_FRAME_STATE   0x01
+
+// Trama de estado. Valores en punto fijo para reducir el ancho de banda.
+struct __attribute__((packed)) TelemetryFrame {
+    uint8_t type;           // TELEMETRY_FRAME_STATE
+    uint16_t sequence;      // Para detectar tramas perdidas
+    uint32_t timestampUs;
+    uint16_t loopTimeUs;    // Duración del loop anterior
+    int16_t attitude[3];    // Roll, pitch, yaw (0.01°, yaw en ±180°)
+    int16_t rates[3];       // 0.1°/s
+    int16_t accel[3];       // 0.01 m/s²
+    int16_t inputs[4];      // Throttle, roll, pitch, yaw (0.1%)
+    int16_t pid[3][3];      // Roll/pitch/yaw x P/I/D (0.1 us)
+    uint16_t motors[MIXER_MAX_MOTORS];  // Pulso de cada ESC (us), 0 si no existe
+    uint8_t flags;          // bit0 armado, bit1 armCmd, bit2 disarmCmd, bit3 acro, bits4-5 failsafe
+};
+
+// Telemetría binaria. La tarea de control codifica las tramas en un buffer
+// circular preasignado y la tarea de comunicaciones lo vacía hacia la UART
+// sin bloquear. Si el buffer está lleno la trama se descarta.
+class Telemetry {
+private:
+    SpscRing<uint8_t, TELEMETRY_BUFFER_SIZE> txRing;
+    std::atomic<bool> enabled;
+    std::atomic<uint32_t> droppedFrames;
+    uint16_t sequence;
+
+public:
+    Telemetry();
+    void setEnabled(bool enable);
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Tarea de control: llamar a TELEMETRY_RATE_HZ (lo planifica el Scheduler)
+    void sample(const FlightController& controller, uint32_t timestampUs, uint32_t loopTimeUs);
+
+    // Tarea de comunicaciones: enviar lo que quepa en la UART sin bloquear
+    size_t flush(HardwareSerial& port);
+
+    uint32_t getDroppedFrames() const { return droppedFrames.load(std::memory_order_relaxed); }
+};
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Eventos trazados. El nombre es el que aparece en Perfetto / chrome://tracing
+// (ver tools/trace_to_chrome.py).
+#define TRACE_EVENT_LIST(X) \
+    X(TRACE_CLOCK_SYNC,     "clockSync")        /* Instante: micros() en el id */ \
+    X(TRACE_CONTROL_TICK,   "controlTick")      \
+    X(TRACE_READ_SENSORS,   "readSensors")      \
+    X(TRACE_ESTIMATION,     "calculateAngles")  \
+    X(TRACE_COMPUTE_PID,    "computePID")       \
+    X(TRACE_MOTOR_WRITE,    "motorWrite")       \
+    X(TRACE_SET_INPUTS,     "setInputs")        \
+    X(TRACE_INPUT_JOB,      "inputJob")         \
+    X(TRACE_UART_RX,        "uartRx")           \
+    X(TRACE_KEY,            "processInput")     \
+    X(TRACE_COMMAND_FRAME,  "commandFrame")     \
+    X(TRACE_INPUTS_PUBLISH, "inputsPublish")
+
+#define TRACE_ENUM(id, name) id,
+enum TraceEventId {
+    TRACE_EVENT_LIST(TRACE_ENUM)
+    TRACE_EVENT_COUNT
+};
+#undef TRACE_ENUM
+
+#define TRACE_CORES         2
+
+#if ENABLE_TRACE
+
+#include <Arduino.h>
+#include <atomic>
+
+static_assert((TRACE_BUFFER_EVENTS & (TRACE_BUFFER_EVENTS - 1)) == 0,
+              "TRACE_BUFFER_EVENTS debe ser potencia de dos");
+
+enum TracePhase : uint8_t {
+    TRACE_PHASE_BEGIN = 'B',
+    TRACE_PHASE_END = 'E',
+    TRACE_PHASE_INSTANT = 'i'
+};
+
+struct TraceEvent {
+    uint32_t cycles;       // Contador de ciclos del núcleo que lo registra
+    uint32_t correlation;  // Sigue un mando de la UART a los motores (0 = ninguno)
+    uint16_t id;           // TraceEventId
+    uint8_t phase;         // TracePhase
+    uint8_t reserved;
+};
+
+// Registro circular de eventos, uno por núcleo: cada núcleo tiene un único
+// escritor (tarea de control o de comunicaciones), así que escribir no
+// necesita bloqueos. Se sobrescriben los eventos más antiguos; un volcado
+// congela el registro y lo envía poco a poco sin bloquear la tarea. Para
+// congelarlo sin romper un evento a medias, cada escritor marca `writing`
+// antes de mirar `recording` y beginDump() apaga `recording` antes de
+// esperar a que las marcas se borren (orden secuencial en ambos lados).
+class Tracer {
+private:
+    struct CoreBuffer {
+        TraceEvent events[TRACE_BUFFER_EVENTS];
+        std::atomic<uint32_t> head;  // Eventos escritos desde el arranque
+        std::atomic<bool> writing;   // El escritor del núcleo está dentro de record()
+    };
+
+    CoreBuffer buffers[TRACE_CORES];
+    std::atomic<bool> recording;
+    std::atomic<uint32_t> nextCorrelation;
+
+    // Estado del volcado en curso
+    bool dumping;
+    int dumpCore;
+    uint32_t dumpIndex;
+    uint32_t dumpEnd[TRACE_CORES];
+
+    void write(CoreBuffer& buffer, TraceEventId id, uint8_t phase, uint32_t correlation, uint32_t cycles) {
+        uint32_t head = buffer.head.load(std::memory_order_relaxed);
+        TraceEvent& event = buffer.events[head & (TRACE_BUFFER_EVENTS - 1)];
+        event.cycles = cycles;
+        event.correlation = correlation;
+        event.id = (uint16_t)id;
+        event.phase = phase;
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+public:
+    Tracer();
+
+    static inline uint32_t cycles() { return ESP.getCycleCount(); }
+
+    inline void record(TraceEventId id, uint8_t phase, uint32_t correlation) {
+        uint32_t now = cycles();
+        CoreBuffer& buffer = buffers[xPortGetCoreID() & (TRACE_CORES - 1)];
+
+        // Marca y comprobación en este orden: o beginDump() ve la marca y
+        // espera, o este escritor ve recording = false y no toca el registro
+        buffer.writing.store(true, std::memory_order_seq_cst);
+        if (recording.load(std::memory_order_seq_cst)) {
+            write(buffer, id, phase, correlation, now);
+
+            // Los contadores de ciclos de los dos núcleos no están alineados:
+            // cada cierto número de eventos se guarda la hora común (micros())
+            if ((buffer.head.load(std::memory_order_relaxed) & (TRACE_SYNC_INTERVAL - 1)) == 0) {
+                write(buffer, TRACE_CLOCK_SYNC, TRACE_PHASE_INSTANT, micros(), cycles());
+            }
+        }
+        buffer.writing.store(false, std::memory_order_release);
+    }
+
+    // Identificador nuevo para seguir un mando de extremo a extremo
+    uint32_t newCorrelation() {
+        uint32_t id = nextCorrelation.fetch_add(1, std::memory_order_relaxed);
+        return id != 0 ? id : nextCorrelation.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Congela el registro y empieza el volcado en texto
+    void beginDump(HardwareSerial& port);
+
+    // Envía lo que quepa en la UART; devuelve true al terminar (y reanuda)
+    bool continueDump(HardwareSerial& port);
+
+    bool isDumping() const { return dumping; }
+};
+
+extern Tracer tracer;
+
+// Comienzo y fin de un ámbito
+class TraceScope {
+private:
+    TraceEventId id;
+    uint32_t correlation;
+
+public:
+    TraceScope(TraceEventId eventId, uint32_t correlationId) : id(eventId), correlation(correlationId) {
+        tracer.record(id, TRACE_PHASE_BEGIN, correlation);
+    }
+    ~TraceScope() { tracer.record(id, TRACE_PHASE_END, correlation); }
+};
+
+#define TRACE_CONCAT_(a, b)             a##b
+#define TRACE_CONCAT(a, b)              TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(id, correlation)    TraceScope TRACE_CONCAT(traceScope, __LINE__)(id, correlation)
+#define TRACE_BEGIN(id, correlation)    tracer.record(id, TRACE_PHASE_BEGIN, correlation)
+#define TRACE_END(id, correlation)      tracer.record(id, TRACE_PHASE_END, correlation)
+#define TRACE_INSTANT(id, correlation)  tracer.record(id, TRACE_PHASE_INSTANT, correlation)
+#define TRACE_NEW_CORRELATION()         tracer.newCorrelation()
+
+#else
+
+#define TRACE_SCOPE(id, correlation)
+#define TRACE_BEGIN(id, correlation)
+#define TRACE_END(id, correlation)
+#define TRACE_INSTANT(id, correlation)
+#define TRACE_NEW_CORRELATION()         0u
+
+#endif
+
+#endif
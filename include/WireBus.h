@@ -0,0 +1,20 @@
+#ifndef WIRE_BUS_H
+#define WIRE_BUS_H
+
+#include <Wire.h>
+#include "I2CBus.h"
+
+// Implementación de I2CBus sobre la librería Wire de Arduino
+class WireBus : public I2CBus {
+private:
+    TwoWire& wire;
+    
+public:
+    static const size_t MAX_READ_LENGTH = 128;  // Tamaño del buffer de Wire en ESP32
+    
+    explicit WireBus(TwoWire& w) : wire(w) {}
+    bool writeRegister(uint8_t address, uint8_t reg, uint8_t value) override;
+    bool readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, size_t length) override;
+};
+
+#endif
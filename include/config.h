@@ -1,58 +1,253 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+// Compilación para la placa; 0 en el host (pruebas con pio test -e native)
+#ifdef ARDUINO
+#define TARGET_BOARD        1
+#else
+#define TARGET_BOARD        0
+#endif
+
 // Configuración de pines ESP32
 #define PIN_ESC_1           33  // Motor delantero derecho (CCW)
 #define PIN_ESC_2           25  // Motor trasero derecho (CW)
 #define PIN_ESC_3           26  // Motor trasero izquierdo (CCW)
 #define PIN_ESC_4           27  // Motor delantero izquierdo (CW)
+#define PIN_ESC_5           32  // Motores 5-8 sólo en hexa y octo
+#define PIN_ESC_6           14
+#define PIN_ESC_7           13
+#define PIN_ESC_8           23
 
 #define PIN_MPU6050_SDA     21  // Pin SDA para MPU6050
 #define PIN_MPU6050_SCL     22  // Pin SCL para MPU6050
+#define PIN_MPU6050_INT     4   // Pin INT (datos listos) del MPU6050
 
 #define PIN_LED_STATUS      2   // LED interno ESP32
 
 // Configuración de comunicación
 #define SERIAL_BAUD         115200
+#define SERIAL_RX_BUFFER_SIZE 1024  // Bytes; se vacía entero en cada tick de comunicaciones
+#define COMMAND_RX_CHUNK    64      // Bytes leídos de la UART por iteración
+
+// Failsafe del enlace de mandos binarios (ver Failsafe.h). Con sólo teclado
+// se mantiene el desarmado por inactividad de KEYBOARD_TIMEOUT_US.
+#define FAILSAFE_HOLD_US    80000   // Sin tramas: nivelar (~4 tramas a 50 Hz)
+#define FAILSAFE_LAND_US    500000  // Sin tramas: empezar la rampa de throttle
+#define FAILSAFE_RAMP_US    3000000 // Rampa hasta throttle cero y desarmado
+#define LINK_DROPOUT_US     FAILSAFE_HOLD_US  // Hueco contado como corte en las estadísticas
+#define KEYBOARD_TIMEOUT_US 10000000
+
+// Configuración de tareas FreeRTOS
+#define CONTROL_TASK_CORE       1     // Núcleo del loop de control
+#define CONTROL_TASK_PRIORITY   (configMAX_PRIORITIES - 1)
+#define CONTROL_TASK_STACK      8192
+#define COMMS_TASK_CORE         0     // Núcleo de entrada serie y estado
+#define COMMS_TASK_PRIORITY     1
+#define COMMS_TASK_STACK        8192
+
+// Planificador: periodos (us), prioridades (0 = crítica) y presupuestos de CPU (us)
+#define COMMS_TICK_US           1000
+#define TELEMETRY_TX_PERIOD_US  2000
+#define SAFETY_PERIOD_US        100000
+#define STATUS_PERIOD_US        2000000
+#define MONITOR_PERIOD_US       1000000
+#define STATS_PERIOD_US         10000000
+#define BLACKBOX_FLUSH_PERIOD_US COMMS_TICK_US  // Una página por tick
+#define TELEMETRY_BUDGET_US     50
+#define TELEMETRY_TX_BUDGET_US  200
+#define SAFETY_BUDGET_US        20
+#define STATUS_BUDGET_US        500
+#define STATS_BUDGET_US         800
+#define BLACKBOX_BUDGET_US      40
+#define BLACKBOX_FLUSH_BUDGET_US 700    // Programar una página de 256 bytes
+#define BLACKBOX_ERASE_BUDGET_US 50000  // Un sector tarda decenas de ms: tarea crítica, sólo desarmado
+#define LOG_DRAIN_PERIOD_US     10000
+#define LOG_DRAIN_BUDGET_US     300
+#define TRACE_DUMP_PERIOD_US    10000
+#define TRACE_DUMP_BUDGET_US    500
+
+// Telemetría binaria (tramas COBS + CRC16, ver tools/telemetry_decode.py)
+#define TELEMETRY_RATE_HZ       100   // Tramas/s; a LOOP_FREQUENCY hace falta subir SERIAL_BAUD
+#define TELEMETRY_BUFFER_SIZE   2048  // Bytes del buffer de transmisión (potencia de dos)
+
+// Registro diferido (Log.h): entradas por tarea y longitud máxima de una línea
+#define LOG_RING_SIZE           64    // Potencia de dos
+#define LOG_LINE_MAX            96
+
+// Registro de vuelo: buffer en PSRAM volcado a la partición "blackbox" (partitions.csv)
+#define ENABLE_BLACKBOX             1
+#define BLACKBOX_PARTITION          "blackbox"
+#define BLACKBOX_RATE_DIVIDER       1     // Registros a LOOP_FREQUENCY / divisor
+#define BLACKBOX_KEYFRAME_INTERVAL  32    // Un registro absoluto cada N
+#define BLACKBOX_BUFFER_SIZE        (2 * 1024 * 1024)  // Bytes en PSRAM (potencia de dos)
+#define BLACKBOX_FLUSH_WHILE_ARMED  0     // 1 = volcar en vuelo (la escritura en flash detiene el otro núcleo)
+
+// Microbenchmarks de los núcleos del lazo (tecla 'J' o pio run -e native_bench
+// -t exec en el host, salida JSON por línea)
+#define ENABLE_BENCHMARKS       1
+#if TARGET_BOARD
+#define BENCHMARK_ITERATIONS    1000  // Llamadas por tanda
+#else
+#define BENCHMARK_ITERATIONS    100000  // El reloj del host no resuelve tandas más cortas
+#endif
+#define BENCHMARK_BATCHES       5     // Se informa la tanda más rápida
+
+// Perfilado del loop (0 = la instrumentación no se compila). Mide con el
+// contador de ciclos del ESP32: sólo existe en la placa.
+#define ENABLE_PROFILER         TARGET_BOARD
+#define PROFILER_BUCKETS        24    // Histograma logarítmico: cubo n = [2^(n-1), 2^n) ciclos
+
+// Trazas de eventos (tecla 'G', convertir con tools/trace_to_chrome.py); sólo en la placa
+#define ENABLE_TRACE            TARGET_BOARD
+#define TRACE_BUFFER_EVENTS     1024  // Eventos por núcleo (potencia de dos)
+#define TRACE_SYNC_INTERVAL     256   // Eventos entre marcas de hora común (potencia de dos)
 
 // Configuración de vuelo
-#define LOOP_FREQUENCY      250   // Hz - Frecuencia del loop principal
+// Adquisición del MPU6050
+#define IMU_USE_FIFO            0     // 1 = FIFO + interrupción de datos listos (requiere cablear INT)
+
+// La lectura directa de los 14 bytes a 400 kHz ocupa unos 400 us del núcleo
+// de control en cada tick: sin FIFO el lazo de velocidad se queda en 500 Hz
+#if IMU_USE_FIFO
+#define LOOP_FREQUENCY      1000  // Hz - Frecuencia del loop principal (lazo de velocidad)
+#else
+#define LOOP_FREQUENCY      500
+#endif
 #define LOOP_TIME_US        (1000000 / LOOP_FREQUENCY)
+#define ANGLE_LOOP_DIVIDER  (LOOP_FREQUENCY / 250)  // Estimador y lazo de ángulo a 250 Hz
+#define ANGLE_LOOP_FREQUENCY (LOOP_FREQUENCY / ANGLE_LOOP_DIVIDER)
+
+#if !IMU_USE_FIFO && LOOP_FREQUENCY > 500
+#warning "Lectura directa del MPU6050 por encima de 500 Hz: el I2C no cabe en el tick, usar IMU_USE_FIFO"
+#endif
 
-// Configuración PID - Roll
-#define PID_P_GAIN_ROLL     1.0f
-#define PID_I_GAIN_ROLL     0.01f
-#define PID_D_GAIN_ROLL     10.0f
+#if IMU_USE_FIFO
+#define IMU_SAMPLE_RATE_HZ      1000  // Frecuencia de muestreo interna del sensor
+#else
+#define IMU_SAMPLE_RATE_HZ      LOOP_FREQUENCY  // Una muestra por lectura, sin submuestrear
+#endif
+#define IMU_SAMPLES_PER_LOOP    (IMU_SAMPLE_RATE_HZ / LOOP_FREQUENCY)
+#define IMU_FIFO_BURST_SAMPLES  32    // Máximo de muestras drenadas por ciclo
+#if IMU_USE_FIFO
+#define IMU_DLPF_CONFIG         1     // DLPF del MPU6050 abierto (188 Hz); filtra el banco de biquads
+#elif LOOP_FREQUENCY >= IMU_SAMPLE_RATE_HZ
+#define IMU_DLPF_CONFIG         2     // DLPF del MPU6050 (94 Hz); el loop lee cada muestra
+#else
+#define IMU_DLPF_CONFIG         4     // DLPF del MPU6050 (21 Hz); sin FIFO el loop submuestrea
+#endif
+
+// Lazo de ángulo (externo): velocidad pedida = ganancia * error de ángulo
+#define ANGLE_P_GAIN_ROLL   4.0f    // (grados/s) / grado
+#define ANGLE_P_GAIN_PITCH  ANGLE_P_GAIN_ROLL
+#define ANGLE_MAX_RATE      150.0f  // grados/segundo
+
+// Configuración PID - Roll (lazo de velocidad sobre el giroscopio filtrado)
+#define PID_P_GAIN_ROLL     0.7f
+#define PID_I_GAIN_ROLL     0.5f
+#define PID_D_GAIN_ROLL     0.01f
 #define PID_MAX_ROLL        400
+#define PID_F_GAIN_ROLL     0.04f   // Feedforward: us por (grados/s) / s de la consigna
 
 // Configuración PID - Pitch (igual que Roll)
 #define PID_P_GAIN_PITCH    PID_P_GAIN_ROLL
 #define PID_I_GAIN_PITCH    PID_I_GAIN_ROLL
 #define PID_D_GAIN_PITCH    PID_D_GAIN_ROLL
 #define PID_MAX_PITCH       PID_MAX_ROLL
+#define PID_F_GAIN_PITCH    PID_F_GAIN_ROLL
 
 // Configuración PID - Yaw
 #define PID_P_GAIN_YAW      2.0f
 #define PID_I_GAIN_YAW      0.05f
 #define PID_D_GAIN_YAW      0.0f
 #define PID_MAX_YAW         400
+#define PID_F_GAIN_YAW      0.0f
+
+// Término D sobre la medida (sin pico al saltar la consigna) y feedforward
+#define PID_D_ON_MEASUREMENT 1
+#define FEEDFORWARD_LPF_HZ  100.0f  // Paso bajo de la derivada de la consigna
+
+// Interpolación de mandos: cada mando nuevo se alcanza con una rampa que dura
+// el intervalo medio entre mandos, acotado a este rango
+#define INPUT_INTERPOLATION_MIN_US  LOOP_TIME_US
+#define INPUT_INTERPOLATION_MAX_US  50000
 
 // Configuración ESC
 #define ESC_MIN_PULSE       1000  // Microsegundos
 #define ESC_MAX_PULSE       2000  // Microsegundos
 #define ESC_ARM_PULSE       1000  // Pulso para armar ESCs
+#define ESC_ARM_TIME_US     2000000 // Pulso mínimo antes de permitir armar (corre en paralelo al arranque)
+
+// Tipo de marco (tabla de mezcla en Mixer.cpp)
+#define FRAME_QUAD_X        0
+#define FRAME_QUAD_PLUS     1
+#define FRAME_HEX_X         2
+#define FRAME_OCTO_X        3
+#define FRAME_TYPE          FRAME_QUAD_X
+#define NUM_MOTORS          (FRAME_TYPE == FRAME_HEX_X ? 6 : FRAME_TYPE == FRAME_OCTO_X ? 8 : 4)
+#define MIXER_AIRMODE       0     // 1 = mantener autoridad de actitud también a throttle cero
+
+// Conformado de la salida (OutputShaping.h): tablas generadas al compilar
+#define THROTTLE_CURVE_MID      0.5f  // Punto medio de la curva de throttle (fracción)
+#define THROTTLE_CURVE_EXPO     0.0f  // 0 = lineal; hasta 1 = más fina cerca del punto medio
+#define THRUST_LINEARIZATION    0.4f  // Parte cuadrática del empuje de las hélices; 0 = desactivada
+#define OUTPUT_LUT_SIZE         65    // Puntos de cada tabla
+
+// Protocolo de salida a los ESC (ver EscProtocol.h). El PWM de servo sólo
+// refresca cada 1/ESC_PWM_FREQUENCY s; OneShot125/Multishot/DShot cada tick.
+#define ESC_PROTOCOL        ESC_PROTOCOL_PWM
+#define ESC_PWM_FREQUENCY   50    // Hz (muchos ESC aceptan hasta 400 Hz)
+#define ESC_LEDC_CHANNEL    0     // Primer canal LEDC para OneShot125/Multishot
+#define ESC_RMT_CHANNEL     0     // Primer canal RMT para DShot
 
 // Limites de ángulos (grados)
 #define MAX_ANGLE_ROLL      30.0f
 #define MAX_ANGLE_PITCH     30.0f
 #define MAX_RATE_YAW        180.0f  // grados/segundo
+#define ACRO_MAX_RATE       200.0f  // grados/segundo en modo acro (< rango del giroscopio)
 
 // Configuración del giroscopio
 #define GYRO_SENSITIVITY    131.0f  // LSB/(grados/s) para ±250°/s
 #define ACCEL_SENSITIVITY   16384.0f // LSB/g para ±2g
 
+// Calibración del giroscopio en segundo plano (ver GyroCalibrator.h). Con
+// offsets guardados en NVS basta un bloque en reposo para aceptarlos.
+#define GYRO_CAL_BLOCK_SAMPLES  100     // Muestras por bloque de reposo
+#define GYRO_CAL_BLOCKS         10      // Bloques en reposo para una calibración completa
+#define GYRO_CAL_STILL_RANGE    64      // Máx. pico a pico por bloque (cuentas, ~0.5°/s)
+#define GYRO_CAL_TOLERANCE_DPS  0.3f    // Diferencia admitida con los offsets guardados
+#define GYRO_CAL_NVS_NAMESPACE  "gyrocal"
+
+// Parámetros ajustables por la consola ($set/$save, ver Parameters.h). Los
+// valores de arriba son los de por defecto.
+#define PARAMETER_NVS_NAMESPACE "params"
+
 // Filtros
-#define GYRO_FILTER_ALPHA   0.98f   // Filtro complementario
-#define ACCEL_FILTER_ALPHA  0.02f
+#define GYRO_FILTER_ALPHA   0.98f   // Filtro complementario: peso del giroscopio (acelerómetro 1 - alpha)
+
+// Filtros digitales biquad (0 = etapa desactivada)
+#define GYRO_FILTER_RATE_HZ (IMU_USE_FIFO ? IMU_SAMPLE_RATE_HZ : LOOP_FREQUENCY)
+#define GYRO_LPF_HZ         90.0f   // Paso bajo del giroscopio
+#define GYRO_NOTCH_HZ       0.0f    // Muesca fija (p. ej. resonancia del marco)
+#define GYRO_NOTCH_Q        3.0f
+#define ACCEL_LPF_HZ        10.0f   // Paso bajo del acelerómetro
+#define DTERM_LPF_HZ        40.0f   // Paso bajo del término D de los PID
+
+// Muescas dinámicas: un analizador SDFT del giroscopio crudo sigue los picos
+// de vibración (motores, marco) y reajusta una muesca por pico y eje
+#define DYN_NOTCH_ENABLE        1
+#define DYN_NOTCH_COUNT         2       // Muescas por eje (máx. 2; comparten FILTER_MAX_STAGES)
+#define DYN_NOTCH_MIN_HZ        60.0f
+#define DYN_NOTCH_MAX_HZ        (GYRO_FILTER_RATE_HZ >= 1000 ? 400.0f : GYRO_FILTER_RATE_HZ * 0.44f)  // Por debajo de Nyquist
+#define DYN_NOTCH_Q             3.5f
+#define DYN_NOTCH_SDFT_SIZE     64      // Muestras de la ventana (potencia de dos)
+#define DYN_NOTCH_THRESHOLD     4.0f    // Un pico debe superar la media del rango por este factor
+#define DYN_NOTCH_SMOOTHING     0.2f    // Seguimiento de la frecuencia por análisis (0-1]
+
+// Estimador de actitud
+#define ESTIMATOR_COMPLEMENTARY 0   // Filtro complementario por eje
+#define ESTIMATOR_MAHONY        1   // Cuaterniones (Mahony)
+#define ATTITUDE_ESTIMATOR      ESTIMATOR_COMPLEMENTARY
+#define MAHONY_KP           1.0f    // Ganancia proporcional de corrección por gravedad
+#define MAHONY_KI           0.0f    // Ganancia integral (compensa sesgo del giroscopio)
 
 #endif
\ No newline at end of file
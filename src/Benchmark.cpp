@@ -0,0 +1,376 @@
+#include "Benchmark.h"
+
+#if ENABLE_BENCHMARKS
+
+#include <math.h>
+#include <stdarg.h>
+#include "BlackboxEncoder.h"
+#include "ComplementaryFilter.h"
+#include "FastMath.h"
+#include "Filters.h"
+#include "FlightPipeline.h"
+#include "Log.h"
+#include "MahonyAHRS.h"
+#include "Mixer.h"
+#include "OutputShaping.h"
+#include "PID.h"
+#include "SpectrumAnalyzer.h"
+#include "StateBus.h"
+
+#if !TARGET_BOARD
+#include <chrono>
+#endif
+
+// Longitud de las trazas (potencia de dos); se recorren en bucle
+static const size_t TRACE_LENGTH = 256;
+static const size_t BLACKBOX_TRACE_LENGTH = 16;
+static const uint32_t TRACE_SEED = 12345;
+
+// Evita que el compilador elimine los cálculos medidos
+volatile float benchmarkSink;
+
+// Reloj del lazo completo: avanza un tick por llamada, no con el tiempo real
+static uint32_t benchmarkClockUs;
+
+static uint32_t benchmarkClock() {
+    return benchmarkClockUs;
+}
+
+// Contador del banco: ciclos de CPU en la placa, ns del reloj monótono en el
+// host. Una tanda dura mucho menos que la vuelta de 32 bits.
+#if TARGET_BOARD
+static inline uint32_t benchmarkTicks() {
+    return ESP.getCycleCount();
+}
+#else
+static inline uint32_t benchmarkTicks() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+#endif
+
+static void emit(BenchmarkStream& out, const char* format, ...) {
+    char line[192];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+#if TARGET_BOARD
+    out.print(line);
+#else
+    fputs(line, &out);
+#endif
+}
+
+// Políticas de banco para FlightPipeline: el mismo lazo que en vuelo, sin
+// bus I2C ni ESC. El sensor repite una traza de muestras crudas.
+struct BenchmarkSensor {
+    static constexpr bool usesFifo = false;
+    const ImuSample* trace;
+    size_t index;
+
+    bool init(const ImuConfig&) { return true; }
+    bool startFifo() { return true; }
+    size_t read(ImuSample* samples, size_t) {
+        samples[0] = trace[index++ & (TRACE_LENGTH - 1)];
+        return 1;
+    }
+    uint32_t pendingSamples() const { return 1; }
+    uint32_t getSamplePeriodUs() const { return LOOP_TIME_US; }
+};
+
+struct BenchmarkOutput {
+    static constexpr int motorCount = DEFAULT_AIRFRAME_CONFIG.esc.motorCount;
+    int pulses[motorCount];
+
+    bool init(const uint8_t*) { return true; }
+    void write(const int (&pulsesUs)[motorCount]) { memcpy(pulses, pulsesUs, sizeof(pulses)); }
+    void writeAll(int pulseUs) {
+        for (int i = 0; i < motorCount; i++) {
+            pulses[i] = pulseUs;
+        }
+    }
+};
+
+// Las mismas políticas que DefaultAirframe (FlightController.h), que no se
+// incluye para poder compilar en el host sin el MPU6050 ni los ESC. Sin
+// instrumentar: los benchmarks corren en la tarea de comunicaciones y no deben
+// escribir en el perfilador ni en la traza del lazo de control.
+struct BenchmarkAirframe {
+    static constexpr AirframeConfig config = DEFAULT_AIRFRAME_CONFIG;
+    static constexpr bool instrumented = false;
+
+    using Sensor = BenchmarkSensor;
+    using Controller = PIDController;
+    using MotorMixer = Mixer;
+    using Output = BenchmarkOutput;
+
+#if ATTITUDE_ESTIMATOR == ESTIMATOR_MAHONY
+    using Estimator = MahonyAHRS;
+    static constexpr MahonyAHRS::Config estimatorConfig = { MAHONY_KP, MAHONY_KI };
+#else
+    using Estimator = ComplementaryFilter;
+    static constexpr ComplementaryFilter::Config estimatorConfig = { GYRO_FILTER_ALPHA };
+#endif
+};
+
+struct BenchmarkContext {
+    // Trazas de entrada
+    float gyro[TRACE_LENGTH][3];      // grados/s
+    float accel[TRACE_LENGTH][3];     // m/s²
+    float setpoint[TRACE_LENGTH][3];  // grados/s
+    int32_t fields[BLACKBOX_TRACE_LENGTH][BLACKBOX_FIELD_COUNT];
+
+    // Núcleos con su estado, configurados como en FlightController
+    PIDController pid[3];
+    BiquadBank gyroFilter;
+    SpectrumAnalyzer spectrum;
+    MahonyAHRS ahrs;
+    ComplementaryFilter complementary;
+    Mixer mixer;
+    BlackboxEncoder encoder;
+    uint8_t record[BLACKBOX_MAX_RECORD];
+
+    // Lazo completo armado sobre las mismas trazas
+    ImuSample samples[TRACE_LENGTH];
+    BenchmarkSensor sensor;
+    BenchmarkOutput output;
+    StateBus stateBus;
+    Logger logger;
+    FlightPipeline<BenchmarkAirframe> pipeline;
+
+    BenchmarkContext()
+        : pid{ PIDController(PID_P_GAIN_ROLL, PID_I_GAIN_ROLL, PID_D_GAIN_ROLL, PID_MAX_ROLL),
+               PIDController(PID_P_GAIN_PITCH, PID_I_GAIN_PITCH, PID_D_GAIN_PITCH, PID_MAX_PITCH),
+               PIDController(PID_P_GAIN_YAW, PID_I_GAIN_YAW, PID_D_GAIN_YAW, PID_MAX_YAW) },
+          ahrs(MAHONY_KP, MAHONY_KI),
+          complementary(ComplementaryFilter::Config{ GYRO_FILTER_ALPHA }),
+          encoder(BLACKBOX_KEYFRAME_INTERVAL),
+          sensor{ samples, 0 },
+          logger(benchmarkClock),
+          pipeline(sensor, output, benchmarkClock, logger, stateBus) {}
+};
+
+typedef float (*BenchmarkKernel)(BenchmarkContext& ctx, size_t index);
+
+// Generador congruencial: la misma traza en cada ejecución y en cada placa
+static uint32_t randomState;
+
+static float randomSigned() {
+    randomState = randomState * 1664525u + 1013904223u;
+    return (float)(randomState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+}
+
+static void buildTraces(BenchmarkContext& ctx) {
+    randomState = TRACE_SEED;
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        float phase = (float)i * (2.0f * FAST_PI / TRACE_LENGTH);
+        for (int axis = 0; axis < 3; axis++) {
+            ctx.gyro[i][axis] = 50.0f * sinf(phase * (axis + 1)) + 2.0f * randomSigned();
+            ctx.setpoint[i][axis] = 100.0f * randomSigned();
+        }
+        ctx.accel[i][0] = 0.5f * randomSigned();
+        ctx.accel[i][1] = 0.5f * randomSigned();
+        ctx.accel[i][2] = 9.81f + 0.5f * randomSigned();
+    }
+
+    for (size_t i = 0; i < BLACKBOX_TRACE_LENGTH; i++) {
+        for (int f = 0; f < BLACKBOX_FIELD_COUNT; f++) {
+            ctx.fields[i][f] = (int32_t)(ctx.gyro[i][f % 3] * 10.0f);
+        }
+        ctx.fields[i][BLACKBOX_TIME] = (int32_t)(i * LOOP_TIME_US);
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        ctx.pid[axis].setDerivativeFilter(DTERM_LPF_HZ, LOOP_FREQUENCY);
+    }
+    ctx.gyroFilter.init(GYRO_FILTER_RATE_HZ);
+    ctx.gyroFilter.addLowpass(GYRO_LPF_HZ);
+    ctx.gyroFilter.addNotch(GYRO_NOTCH_HZ, GYRO_NOTCH_Q);
+    ctx.gyroFilter.addNotch(DYN_NOTCH_MAX_HZ, DYN_NOTCH_Q);
+    ctx.gyroFilter.addNotch(DYN_NOTCH_MAX_HZ, DYN_NOTCH_Q);
+    ctx.spectrum.init(GYRO_FILTER_RATE_HZ, DYN_NOTCH_MIN_HZ, DYN_NOTCH_MAX_HZ, DYN_NOTCH_COUNT,
+                      DYN_NOTCH_THRESHOLD, DYN_NOTCH_SMOOTHING);
+    ctx.mixer.setFrame(FRAME_TYPE);
+    ctx.mixer.setAirmode(MIXER_AIRMODE);
+
+    // Muestras crudas equivalentes para el lazo completo
+    for (size_t i = 0; i < TRACE_LENGTH; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            ctx.samples[i].gyro[axis] = (int16_t)(ctx.gyro[i][axis] * GYRO_SENSITIVITY);
+            ctx.samples[i].accel[axis] = (int16_t)(ctx.accel[i][axis] * (ACCEL_SENSITIVITY / 9.80665f));
+        }
+        ctx.samples[i].timestampUs = 0;
+    }
+
+    // Armar con offsets nulos, pasada la espera de los ESC, sin enlace binario
+    const int32_t offsets[3] = { 0, 0, 0 };
+    benchmarkClockUs = 0;
+    ctx.pipeline.init(offsets);
+    ctx.pipeline.setLinkStatus(false, 0);
+    benchmarkClockUs = ESC_ARM_TIME_US;
+    ControlInputs inputs = {};
+    inputs.armCmd = true;
+    ctx.pipeline.setInputs(inputs);
+    ctx.pipeline.update();
+    inputs.armCmd = false;
+    inputs.throttle = 50.0f;
+    ctx.pipeline.setInputs(inputs);
+}
+
+// ---- Núcleos medidos ----
+
+static float benchEmpty(BenchmarkContext& ctx, size_t i) {
+    return ctx.gyro[i][0];
+}
+
+static float benchPidCompute(BenchmarkContext& ctx, size_t i) {
+    int axis = i % 3;
+    return ctx.pid[axis].compute(ctx.setpoint[i][axis], ctx.gyro[i][axis], 1.0f / LOOP_FREQUENCY);
+}
+
+static float benchGyroFilter(BenchmarkContext& ctx, size_t i) {
+    float values[3] = { ctx.gyro[i][0], ctx.gyro[i][1], ctx.gyro[i][2] };
+    ctx.gyroFilter.apply(values);
+    return values[0];
+}
+
+static float benchSdftSample(BenchmarkContext& ctx, size_t i) {
+    ctx.spectrum.addSample(ctx.gyro[i]);
+    return ctx.gyro[i][0];
+}
+
+// Presupuesto de un tick: las muestras del tick, el análisis de un eje y el
+// reajuste de sus muescas, como en FlightController
+static float benchDynamicNotchTick(BenchmarkContext& ctx, size_t i) {
+    for (int n = 0; n < IMU_SAMPLES_PER_LOOP; n++) {
+        ctx.spectrum.addSample(ctx.gyro[(i + n) & (TRACE_LENGTH - 1)]);
+    }
+    int axis = ctx.spectrum.step();
+    if (axis < 0) return 0.0f;
+    for (int p = 0; p < ctx.spectrum.getPeakCount(); p++) {
+        ctx.gyroFilter.setNotch(ctx.gyroFilter.getStageCount() - 1 - p, axis,
+                                ctx.spectrum.getPeak(axis, p), DYN_NOTCH_Q);
+    }
+    return ctx.spectrum.getPeak(axis, 0);
+}
+
+static float benchMahonyUpdate(BenchmarkContext& ctx, size_t i) {
+    ctx.ahrs.update(ctx.gyro[i][0] * DEG_TO_RAD_F, ctx.gyro[i][1] * DEG_TO_RAD_F,
+                    ctx.gyro[i][2] * DEG_TO_RAD_F,
+                    ctx.accel[i][0], ctx.accel[i][1], ctx.accel[i][2],
+                    1.0f / ANGLE_LOOP_FREQUENCY);
+    return ctx.ahrs.getRoll();
+}
+
+static float benchComplementaryUpdate(BenchmarkContext& ctx, size_t i) {
+    ctx.complementary.update(ctx.gyro[i][0] * DEG_TO_RAD_F, ctx.gyro[i][1] * DEG_TO_RAD_F,
+                             ctx.gyro[i][2] * DEG_TO_RAD_F,
+                             ctx.accel[i][0], ctx.accel[i][1], ctx.accel[i][2],
+                             1.0f / ANGLE_LOOP_FREQUENCY);
+    return ctx.complementary.getRoll();
+}
+
+static float benchAtan2f(BenchmarkContext& ctx, size_t i) {
+    return atan2f(ctx.accel[i][1], ctx.accel[i][2]);
+}
+
+static float benchFastAtan2(BenchmarkContext& ctx, size_t i) {
+    return fastAtan2(ctx.accel[i][1], ctx.accel[i][2]);
+}
+
+static float benchMixerMix(BenchmarkContext& ctx, size_t i) {
+    float outputs[MIXER_MAX_MOTORS];
+    ctx.mixer.mix(0.5f, ctx.setpoint[i][0] * 0.002f, ctx.setpoint[i][1] * 0.002f,
+                  ctx.setpoint[i][2] * 0.002f, outputs);
+    return outputs[0];
+}
+
+static constexpr OutputShaper benchmarkShaper(DEFAULT_AIRFRAME_CONFIG.shaping);
+
+static float benchOutputShaping(BenchmarkContext& ctx, size_t i) {
+    float outputs[MIXER_MAX_MOTORS];
+    for (int m = 0; m < MIXER_MAX_MOTORS; m++) {
+        outputs[m] = 0.5f + ctx.setpoint[i][m % 3] * 0.002f;
+    }
+    outputs[0] = benchmarkShaper.shapeThrottle(outputs[0]);
+    benchmarkShaper.linearizeThrust(outputs, NUM_MOTORS);
+    return outputs[0];
+}
+
+// Un tick del lazo completo con las políticas de banco: filtros, muescas
+// dinámicas, estimador (cada ANGLE_LOOP_DIVIDER), PID, mezcla y salida
+static float benchPipelineTick(BenchmarkContext& ctx, size_t) {
+    benchmarkClockUs += LOOP_TIME_US;
+    ctx.pipeline.update();
+    return (float)ctx.output.pulses[0];
+}
+
+static float benchBlackboxEncode(BenchmarkContext& ctx, size_t i) {
+    return (float)ctx.encoder.encode(ctx.fields[i % BLACKBOX_TRACE_LENGTH], ctx.record);
+}
+
+// ---- Ejecución ----
+
+static void runKernel(BenchmarkStream& out, const char* name, BenchmarkContext& ctx, BenchmarkKernel kernel) {
+    // Mejor de varias tandas: descarta interrupciones y fallos de caché puntuales
+    uint32_t bestTicks = UINT32_MAX;
+    float sink = 0;
+    for (int batch = 0; batch < BENCHMARK_BATCHES; batch++) {
+        uint32_t start = benchmarkTicks();
+        for (uint32_t n = 0; n < BENCHMARK_ITERATIONS; n++) {
+            sink += kernel(ctx, n & (TRACE_LENGTH - 1));
+        }
+        uint32_t ticks = benchmarkTicks() - start;
+        if (ticks < bestTicks) bestTicks = ticks;
+    }
+    benchmarkSink = sink;
+
+    float ticksPerOp = (float)bestTicks / BENCHMARK_ITERATIONS;
+#if TARGET_BOARD
+    float nsPerOp = ticksPerOp * 1000.0f / ESP.getCpuFreqMHz();
+    emit(out, "{\"bench\":\"%s\",\"iterations\":%u,\"cycles_per_op\":%.1f,"
+              "\"ns_per_op\":%.1f,\"ops_per_s\":%.0f}\n",
+         name, (unsigned)BENCHMARK_ITERATIONS, ticksPerOp, nsPerOp,
+         nsPerOp > 0 ? 1e9f / nsPerOp : 0.0f);
+#else
+    float nsPerOp = ticksPerOp;
+    emit(out, "{\"bench\":\"%s\",\"iterations\":%u,\"ns_per_op\":%.2f,\"ops_per_s\":%.0f}\n",
+         name, (unsigned)BENCHMARK_ITERATIONS, nsPerOp, nsPerOp > 0 ? 1e9f / nsPerOp : 0.0f);
+#endif
+}
+
+void runBenchmarks(BenchmarkStream& out) {
+    BenchmarkContext* ctx = new BenchmarkContext();
+    buildTraces(*ctx);
+
+#if TARGET_BOARD
+    emit(out, "{\"suite\":\"control\",\"target\":\"esp32\",\"cpu_mhz\":%u,\"loop_hz\":%u,\"seed\":%u}\n",
+         (unsigned)ESP.getCpuFreqMHz(), (unsigned)LOOP_FREQUENCY, (unsigned)TRACE_SEED);
+#else
+    emit(out, "{\"suite\":\"control\",\"target\":\"host\",\"loop_hz\":%u,\"seed\":%u}\n",
+         (unsigned)LOOP_FREQUENCY, (unsigned)TRACE_SEED);
+#endif
+
+    // "empty" mide el coste de la llamada indirecta y del bucle
+    runKernel(out, "empty", *ctx, benchEmpty);
+    runKernel(out, "pid_compute", *ctx, benchPidCompute);
+    runKernel(out, "gyro_filter", *ctx, benchGyroFilter);
+    runKernel(out, "sdft_sample", *ctx, benchSdftSample);
+    runKernel(out, "dyn_notch_tick", *ctx, benchDynamicNotchTick);
+    runKernel(out, "mahony_update", *ctx, benchMahonyUpdate);
+    runKernel(out, "complementary_update", *ctx, benchComplementaryUpdate);
+    runKernel(out, "atan2f", *ctx, benchAtan2f);
+    runKernel(out, "fast_atan2", *ctx, benchFastAtan2);
+    runKernel(out, "mixer_mix", *ctx, benchMixerMix);
+    runKernel(out, "output_shaping", *ctx, benchOutputShaping);
+    runKernel(out, "blackbox_encode", *ctx, benchBlackboxEncode);
+    runKernel(out, "pipeline_tick", *ctx, benchPipelineTick);
+    if (!ctx->pipeline.isArmed()) {
+        emit(out, "{\"warning\":\"pipeline_tick medido desarmado\"}\n");
+    }
+
+    delete ctx;
+}
+
+#endif
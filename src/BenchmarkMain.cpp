@@ -0,0 +1,12 @@
+#include "Benchmark.h"
+
+// Programa del entorno native_bench: los mismos benchmarks que la tecla 'J'
+// de la placa, con la salida JSON en stdout para tools/bench_compare.py
+#if ENABLE_BENCHMARKS && !TARGET_BOARD
+
+int main() {
+    runBenchmarks(*stdout);
+    return 0;
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "Blackbox.h"
+
+// Cabecera de sesión: 8 bytes fijos + "nombre:escala\0" por campo
+static const size_t BLACKBOX_HEADER_MAX = 8 + BLACKBOX_FIELD_COUNT * 20;
+
+Blackbox blackbox;
+
+static int32_t toFixed(float value, float scale) {
+    return (int32_t)lroundf(value * scale);
+}
+
+Blackbox::Blackbox()
+    : encoder(BLACKBOX_KEYFRAME_INTERVAL),
+      ready(false),
+      recording(false),
+      seenEraseCount(0),
+      recordCount(0),
+      droppedRecords(0) {
+}
+
+bool Blackbox::init(FlashStore& flash) {
+    if (flash.size() == 0) return false;
+
+    uint8_t* buffer = (uint8_t*)ps_malloc(BLACKBOX_BUFFER_SIZE);
+    if (!ring.attach(buffer, BLACKBOX_BUFFER_SIZE)) {
+        free(buffer);
+        return false;
+    }
+
+    ready = writer.begin(flash, ring);
+    return ready;
+}
+
+void Blackbox::sample(const FlightController& controller, uint32_t timestampUs) {
+    if (!ready) return;
+
+    // Un borrado descarta el buffer: la sesión en curso ya no tiene cabecera
+    uint32_t eraseCount = writer.getEraseCount();
+    if (eraseCount != seenEraseCount) {
+        seenEraseCount = eraseCount;
+        recording = false;
+    }
+
+    FlightData data = controller.getFlightData();
+    if (!data.armed || writer.isFull() || writer.isErasePending()) {
+        recording = false;
+        return;
+    }
+
+    // Al armar, abrir sesión con la cabecera y empezar por un keyframe
+    if (!recording) {
+        uint8_t header[BLACKBOX_HEADER_MAX];
+        size_t length = BlackboxEncoder::writeHeader(header, sizeof(header),
+                                                     LOOP_FREQUENCY / BLACKBOX_RATE_DIVIDER);
+        if (length == 0 || !ring.push(header, length)) {
+            droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        encoder.forceKeyframe();
+        recording = true;
+    }
+
+    ControlInputs inputs = controller.getInputs();
+    const ImuSample& raw = controller.getRawSample();
+    const PIDController* pids[3] = {
+        &controller.getRollPID(), &controller.getPitchPID(), &controller.getYawPID()
+    };
+    const int* motors = controller.getMotorOutputs();
+
+    int32_t fields[BLACKBOX_FIELD_COUNT];
+    fields[BLACKBOX_TIME] = (int32_t)timestampUs;
+    for (int axis = 0; axis < 3; axis++) {
+        fields[BLACKBOX_GYRO_RAW_X + axis] = raw.gyro[axis];
+        fields[BLACKBOX_ACC_RAW_X + axis] = raw.accel[axis];
+    }
+    fields[BLACKBOX_ROLL] = toFixed(data.roll, 100.0f);
+    fields[BLACKBOX_PITCH] = toFixed(data.pitch, 100.0f);
+    fields[BLACKBOX_YAW] = toFixed(data.yaw, 100.0f);
+    fields[BLACKBOX_ROLL_RATE] = toFixed(data.rollRate, 10.0f);
+    fields[BLACKBOX_PITCH_RATE] = toFixed(data.pitchRate, 10.0f);
+    fields[BLACKBOX_YAW_RATE] = toFixed(data.yawRate, 10.0f);
+    fields[BLACKBOX_ACCEL_X] = toFixed(data.accelX, 100.0f);
+    fields[BLACKBOX_ACCEL_Y] = toFixed(data.accelY, 100.0f);
+    fields[BLACKBOX_ACCEL_Z] = toFixed(data.accelZ, 100.0f);
+    fields[BLACKBOX_THROTTLE] = toFixed(inputs.throttle, 10.0f);
+    fields[BLACKBOX_ROLL_CMD] = toFixed(inputs.rollCmd, 10.0f);
+    fields[BLACKBOX_PITCH_CMD] = toFixed(inputs.pitchCmd, 10.0f);
+    fields[BLACKBOX_YAW_CMD] = toFixed(inputs.yawCmd, 10.0f);
+    fields[BLACKBOX_FLAGS] = (data.armed ? BLACKBOX_FLAG_ARMED : 0) |
+                             (inputs.armCmd ? BLACKBOX_FLAG_ARM_CMD : 0) |
+                             (inputs.disarmCmd ? BLACKBOX_FLAG_DISARM_CMD : 0) |
+                             (inputs.acroMode ? BLACKBOX_FLAG_ACRO : 0) |
+                             (data.failsafe << BLACKBOX_FLAG_FAILSAFE_SHIFT);
+    for (int axis = 0; axis < 3; axis++) {
+        fields[BLACKBOX_ROLL_P + axis * 3] = toFixed(pids[axis]->getPTerm(), 10.0f);
+        fields[BLACKBOX_ROLL_I + axis * 3] = toFixed(pids[axis]->getITerm(), 10.0f);
+        fields[BLACKBOX_ROLL_D + axis * 3] = toFixed(pids[axis]->getDTerm(), 10.0f);
+    }
+    for (int i = 0; i < MIXER_MAX_MOTORS; i++) {
+        fields[BLACKBOX_MOTOR_1 + i] = i < FlightController::motorCount ? motors[i] : 0;
+    }
+
+    uint8_t record[BLACKBOX_MAX_RECORD];
+    size_t length = encoder.encode(fields, record);
+    if (ring.push(record, length)) {
+        recordCount.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        // Buffer lleno: el siguiente registro no puede ser un delta de éste
+        droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        encoder.forceKeyframe();
+    }
+}
+
+void Blackbox::flush(bool armed) {
+    if (!ready) return;
+
+#if !BLACKBOX_FLUSH_WHILE_ARMED
+    if (armed) return;
+#endif
+
+    writer.writeStep();
+}
@@ -0,0 +1,66 @@
+#include "BlackboxEncoder.h"
+#include <string.h>
+
+#define BLACKBOX_FIELD_NAME(id, name, scale) name ":" #scale,
+static const char* const FIELD_NAMES[BLACKBOX_FIELD_COUNT] = {
+    BLACKBOX_FIELD_LIST(BLACKBOX_FIELD_NAME)
+};
+#undef BLACKBOX_FIELD_NAME
+
+size_t writeVarint(uint32_t value, uint8_t* output) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        output[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    output[length++] = (uint8_t)value;
+    return length;
+}
+
+BlackboxEncoder::BlackboxEncoder(uint16_t interval)
+    : keyframeInterval(interval > 0 ? interval : 1),
+      sinceKeyframe(0),
+      keyframePending(true) {
+    memset(previous, 0, sizeof(previous));
+}
+
+size_t BlackboxEncoder::writeHeader(uint8_t* output, size_t maxLength, uint16_t loopFrequencyHz) {
+    size_t length = 0;
+    if (maxLength < 8) return 0;
+
+    memcpy(output, BLACKBOX_MAGIC, 4);
+    length = 4;
+    output[length++] = BLACKBOX_VERSION;
+    output[length++] = BLACKBOX_FIELD_COUNT;
+    output[length++] = (uint8_t)(loopFrequencyHz & 0xFF);
+    output[length++] = (uint8_t)(loopFrequencyHz >> 8);
+
+    for (int i = 0; i < BLACKBOX_FIELD_COUNT; i++) {
+        size_t nameLength = strlen(FIELD_NAMES[i]) + 1;  // Con el terminador
+        if (length + nameLength > maxLength) return 0;
+        memcpy(output + length, FIELD_NAMES[i], nameLength);
+        length += nameLength;
+    }
+    return length;
+}
+
+size_t BlackboxEncoder::encode(const int32_t fields[BLACKBOX_FIELD_COUNT], uint8_t* output) {
+    bool keyframe = keyframePending || sinceKeyframe >= keyframeInterval;
+    size_t length = 0;
+
+    output[length++] = keyframe ? BLACKBOX_KEYFRAME : BLACKBOX_DELTA;
+    for (int i = 0; i < BLACKBOX_FIELD_COUNT; i++) {
+        // Diferencia en aritmética sin signo: el decodificador la deshace módulo 2^32
+        int32_t value = keyframe ? fields[i]
+                                 : (int32_t)((uint32_t)fields[i] - (uint32_t)previous[i]);
+        length += writeVarint(zigzagEncode(value), output + length);
+        previous[i] = fields[i];
+    }
+
+    if (keyframe) {
+        keyframePending = false;
+        sinceKeyframe = 0;
+    }
+    sinceKeyframe++;
+    return length;
+}
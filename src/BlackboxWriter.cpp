@@ -0,0 +1,99 @@
+#include "BlackboxWriter.h"
+
+BlackboxWriter::BlackboxWriter()
+    : store(nullptr),
+      ring(nullptr),
+      state(STATE_IDLE),
+      writeOffset(0),
+      eraseOffset(0),
+      writeErrors(0),
+      storeFull(false),
+      eraseRequested(false),
+      eraseCount(0) {
+}
+
+bool BlackboxWriter::begin(FlashStore& flash, SpscByteRing& buffer) {
+    if (flash.size() == 0 || flash.sectorSize() == 0) return false;
+
+    store = &flash;
+    ring = &buffer;
+    state = STATE_IDLE;
+    writeOffset = findWriteOffset();
+    storeFull.store(writeOffset >= store->size());
+    return true;
+}
+
+bool BlackboxWriter::isSectorBlank(size_t offset) {
+    for (size_t done = 0; done < store->sectorSize(); done += sizeof(page)) {
+        if (!store->read(offset + done, page, sizeof(page))) return false;
+        for (size_t i = 0; i < sizeof(page); i++) {
+            if (page[i] != 0xFF) return false;
+        }
+    }
+    return true;
+}
+
+size_t BlackboxWriter::findWriteOffset() {
+    // Las sesiones se escriben seguidas desde el inicio: continuar tras el
+    // último sector usado para no escribir nunca sobre flash sin borrar
+    size_t sector = store->sectorSize();
+    size_t offset = store->size();
+    while (offset >= sector && isSectorBlank(offset - sector)) {
+        offset -= sector;
+    }
+    return offset;
+}
+
+bool BlackboxWriter::writeStep() {
+    if (store == nullptr || isErasing()) return false;
+
+    size_t available = store->size() - writeOffset;
+    if (available == 0) {
+        // Partición llena: descartar lo que quede pendiente
+        storeFull.store(true);
+        return ring->pop(page, sizeof(page)) > 0;
+    }
+
+    // Sin cruzar el límite de página: cada paso es una sola programación
+    size_t room = BLACKBOX_PAGE_SIZE - writeOffset % BLACKBOX_PAGE_SIZE;
+    if (room > available) room = available;
+
+    size_t count = ring->pop(page, room);
+    if (count == 0) return false;
+
+    if (!store->write(writeOffset, page, count)) {
+        writeErrors++;
+    }
+    writeOffset += count;
+    if (writeOffset >= store->size()) {
+        storeFull.store(true);
+    }
+    return true;
+}
+
+bool BlackboxWriter::eraseStep(bool armed) {
+    // La caché se desactiva durante cada borrado: sólo desarmado
+    if (store == nullptr || armed) return false;
+
+    if (state == STATE_IDLE) {
+        if (!eraseRequested.load()) return false;
+        state = STATE_ERASING;
+        eraseOffset = 0;
+    }
+
+    if (eraseOffset < writeOffset) {
+        if (!store->eraseSector(eraseOffset)) writeErrors++;
+        eraseOffset += store->sectorSize();
+        return true;
+    }
+
+    // La sesión que quedase en el buffer se descarta junto con el resto
+    while (ring->pop(page, sizeof(page)) > 0) {
+    }
+    writeOffset = 0;
+    storeFull.store(false);
+    state = STATE_IDLE;
+    eraseCount.fetch_add(1, std::memory_order_release);
+    eraseRequested.store(false);
+    return true;
+}
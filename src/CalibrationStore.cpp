@@ -0,0 +1,26 @@
+#include "CalibrationStore.h"
+#include <Preferences.h>
+#include "GyroCalibrator.h"
+
+// Versión del formato: incluye los bits fraccionarios de los offsets
+static const uint8_t CALIBRATION_VERSION = 0x10 | GYRO_OFFSET_FRACTION_BITS;
+
+bool CalibrationStore::load(int32_t offsets[3]) {
+    Preferences preferences;
+    if (!preferences.begin(nvsNamespace, true)) return false;
+
+    bool valid = preferences.getUChar("version", 0) == CALIBRATION_VERSION &&
+                 preferences.getBytes("gyro", offsets, 3 * sizeof(int32_t)) == 3 * sizeof(int32_t);
+    preferences.end();
+    return valid;
+}
+
+bool CalibrationStore::save(const int32_t offsets[3]) {
+    Preferences preferences;
+    if (!preferences.begin(nvsNamespace, false)) return false;
+
+    bool saved = preferences.putBytes("gyro", offsets, 3 * sizeof(int32_t)) == 3 * sizeof(int32_t) &&
+                 preferences.putUChar("version", CALIBRATION_VERSION) == 1;
+    preferences.end();
+    return saved;
+}
@@ -0,0 +1,155 @@
+#include "CommandParser.h"
+#include <string.h>
+
+static float fromFixed(int16_t value, float min, float max) {
+    float scaled = value / 10.0f;
+    if (scaled < min) return min;
+    if (scaled > max) return max;
+    return scaled;
+}
+
+CommandParser::CommandParser() {
+    reset();
+}
+
+void CommandParser::reset() {
+    frameLength = 0;
+    inFrame = false;
+    overflow = false;
+    hasSequence = false;
+    lastSequence = 0;
+    // Hasta ver el interruptor bajado no hay flanco: si el emisor arranca con
+    // él subido, la primera trama no arma
+    armSwitch = true;
+    linkSeen = false;
+    lastValidFrameUs = 0;
+    consoleLength = 0;
+    memset(&latest, 0, sizeof(latest));
+    fresh = false;
+    validFrames = invalidFrames = staleFrames = lostFrames = droppedKeys = 0;
+}
+
+void CommandParser::dropConsoleLine() {
+    droppedKeys += consoleLength;
+    consoleLength = 0;
+}
+
+void CommandParser::handleKey(uint8_t byte, uint32_t nowUs, char* keys, size_t& keyCount, size_t maxKeys) {
+    // Líneas de la consola: no mueven el avión, pasan también con el enlace
+    if (consoleLength > 0) {
+        bool lineEnd = byte == '\r' || byte == '\n';
+        bool text = (byte >= 0x20 && byte < 0x7F) || byte == '\b' || byte == 0x7F;
+        if (!lineEnd && (!text || consoleLength == sizeof(consoleLine))) {
+            dropConsoleLine();
+            droppedKeys++;
+            return;
+        }
+        consoleLine[consoleLength++] = (char)byte;
+        if (lineEnd) {
+            for (size_t i = 0; i < consoleLength && keyCount < maxKeys; i++) {
+                keys[keyCount++] = consoleLine[i];
+            }
+            consoleLength = 0;
+        }
+        return;
+    }
+    if (byte == '$') {
+        consoleLine[consoleLength++] = '$';
+        return;
+    }
+
+    if (linkSeen && nowUs - lastValidFrameUs < COMMAND_KEY_LOCKOUT_US) {
+        droppedKeys++;
+    } else if (keyCount < maxKeys) {
+        keys[keyCount++] = (char)byte;
+    }
+}
+
+size_t CommandParser::feed(const uint8_t* data, size_t length, uint32_t nowUs, char* keys, size_t maxKeys) {
+    size_t keyCount = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        uint8_t byte = data[i];
+
+        if (!inFrame) {
+            if (byte == FRAME_DELIMITER) {
+                inFrame = true;
+                frameLength = 0;
+                overflow = false;
+                dropConsoleLine();
+            } else {
+                handleKey(byte, nowUs, keys, keyCount, maxKeys);
+            }
+            continue;
+        }
+
+        if (byte != FRAME_DELIMITER) {
+            if (frameLength < sizeof(frameBuffer)) {
+                frameBuffer[frameLength++] = byte;
+            } else {
+                overflow = true;
+            }
+            continue;
+        }
+
+        // Delimitadores seguidos: la trama aún no ha empezado
+        if (frameLength == 0 && !overflow) continue;
+
+        if (overflow) {
+            invalidFrames++;
+        } else {
+            handleFrame(nowUs);
+        }
+        inFrame = false;
+    }
+    return keyCount;
+}
+
+void CommandParser::handleFrame(uint32_t nowUs) {
+    CommandFrame frame;
+    size_t length = decodeFrame(frameBuffer, frameLength, (uint8_t*)&frame, sizeof(frame));
+    if (length != sizeof(frame) || frame.type != COMMAND_FRAME_STICKS) {
+        invalidFrames++;
+        return;
+    }
+
+    if (hasSequence) {
+        int16_t ahead = (int16_t)(frame.sequence - lastSequence);
+        if (ahead <= 0 && ahead >= -COMMAND_STALE_WINDOW) {
+            staleFrames++;
+            return;
+        }
+        if (ahead > 1) lostFrames += ahead - 1;
+    }
+    hasSequence = true;
+    lastSequence = frame.sequence;
+    validFrames++;
+    linkSeen = true;
+    lastValidFrameUs = nowUs;
+
+    bool newArmSwitch = (frame.flags & COMMAND_FLAG_ARM) != 0;
+    bool kill = (frame.flags & COMMAND_FLAG_KILL) != 0;
+
+    // Las órdenes de armado se acumulan hasta que se recoge el mando, para
+    // no perder un flanco si llegan varias tramas en el mismo bloque
+    bool armEdge = newArmSwitch && !armSwitch && !kill;
+    bool keepArm = fresh && latest.armCmd;
+    armSwitch = newArmSwitch;
+
+    latest.throttle = fromFixed(frame.throttle, 0.0f, 100.0f);
+    latest.rollCmd = fromFixed(frame.roll, -100.0f, 100.0f);
+    latest.pitchCmd = fromFixed(frame.pitch, -100.0f, 100.0f);
+    latest.yawCmd = fromFixed(frame.yaw, -100.0f, 100.0f);
+    latest.acroMode = (frame.flags & COMMAND_FLAG_ACRO) != 0;
+    latest.kill = kill;
+    latest.disarmCmd = kill || !newArmSwitch;
+    latest.armCmd = !latest.disarmCmd && (armEdge || keepArm);
+    fresh = true;
+}
+
+bool CommandParser::takeCommand(StickCommand& command) {
+    if (!fresh) return false;
+    command = latest;
+    fresh = false;
+    return true;
+}
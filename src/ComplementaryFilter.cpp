@@ -0,0 +1,28 @@
+#include "ComplementaryFilter.h"
+#include "FastMath.h"
+#include <math.h>
+
+ComplementaryFilter::ComplementaryFilter(const Config& config)
+    : gyroWeight(config.gyroWeight) {
+    reset();
+}
+
+void ComplementaryFilter::reset() {
+    roll = pitch = yaw = 0.0f;
+}
+
+void ComplementaryFilter::update(float gx, float gy, float gz, float ax, float ay, float az, float dt) {
+    // Calcular ángulos del acelerómetro (precisión simple)
+    float accelRoll = atan2f(ay, az) * RAD_TO_DEG_F;
+    float accelPitch = atan2f(-ax, sqrtf(ay * ay + az * az)) * RAD_TO_DEG_F;
+    
+    // Filtro complementario
+    float accelWeight = 1.0f - gyroWeight;
+    roll = gyroWeight * (roll + gx * RAD_TO_DEG_F * dt) + accelWeight * accelRoll;
+    pitch = gyroWeight * (pitch + gy * RAD_TO_DEG_F * dt) + accelWeight * accelPitch;
+    
+    // Mantener yaw en rango 0-360
+    yaw += gz * RAD_TO_DEG_F * dt;
+    if (yaw > 360) yaw -= 360;
+    if (yaw < 0) yaw += 360;
+}
@@ -0,0 +1,116 @@
+#include "EscOutput.h"
+
+#if ESC_PROTOCOL >= ESC_PROTOCOL_DSHOT150
+// Reloj del RMT: APB de 80 MHz / 2 = ticks de 25 ns
+static const uint8_t DSHOT_RMT_CLK_DIV = 2;
+static const uint32_t DSHOT_RMT_TICK_NS = 25;
+#elif ESC_PROTOCOL != ESC_PROTOCOL_PWM
+static const uint32_t LEDC_CLOCK_HZ = 80000000;
+#endif
+
+template <int MotorCount>
+EscOutput<MotorCount>::EscOutput() : initialized(false) {
+    for (int i = 0; i < MotorCount; i++) {
+        pins[i] = 0;
+    }
+}
+
+template <int MotorCount>
+bool EscOutput<MotorCount>::init(const uint8_t* motorPins) {
+    for (int i = 0; i < MotorCount; i++) {
+        pins[i] = motorPins[i];
+    }
+
+#if ESC_PROTOCOL == ESC_PROTOCOL_PWM
+    for (int i = 0; i < MotorCount; i++) {
+        servos[i].setPeriodHertz(ESC_PWM_FREQUENCY);
+        if (servos[i].attach(pins[i], ESC_MIN_PULSE, ESC_MAX_PULSE) < 0) return false;
+    }
+#elif ESC_PROTOCOL >= ESC_PROTOCOL_DSHOT150
+    if (!dshotBitTicks(ESC_PROTOCOL, DSHOT_RMT_TICK_NS, bitTicks)) return false;
+
+    for (int i = 0; i < MotorCount; i++) {
+        rmt_config_t config = {};
+        config.rmt_mode = RMT_MODE_TX;
+        config.channel = (rmt_channel_t)(ESC_RMT_CHANNEL + i);
+        config.gpio_num = (gpio_num_t)pins[i];
+        config.clk_div = DSHOT_RMT_CLK_DIV;
+        config.mem_block_num = 1;
+        config.tx_config.loop_en = false;
+        config.tx_config.carrier_en = false;
+        config.tx_config.idle_output_en = true;
+        config.tx_config.idle_level = RMT_IDLE_LEVEL_LOW;
+
+        if (rmt_config(&config) != ESP_OK) return false;
+        if (rmt_driver_install(config.channel, 0, 0) != ESP_OK) return false;
+
+        // La marca de fin (duración 0) detiene la transmisión tras el bit 16
+        items[i][DSHOT_FRAME_BITS].val = 0;
+    }
+#else
+    // Todos los canales comparten temporizador, así que los pulsos arrancan juntos
+    uint32_t frequency = escAnalogFrequencyHz(ESC_PROTOCOL);
+    ledcResolutionBits = 1;
+    while (ledcResolutionBits < 16 &&
+           (frequency << (ledcResolutionBits + 1)) <= LEDC_CLOCK_HZ) {
+        ledcResolutionBits++;
+    }
+    ledcPeriodNs = 1000000000UL / frequency;
+
+    for (int i = 0; i < MotorCount; i++) {
+        if (ledcSetup(ESC_LEDC_CHANNEL + i, frequency, ledcResolutionBits) == 0) return false;
+        ledcAttachPin(pins[i], ESC_LEDC_CHANNEL + i);
+    }
+#endif
+
+    initialized = true;
+    this->writeAll(ESC_MIN_PULSE);
+    return true;
+}
+
+#if ESC_PROTOCOL >= ESC_PROTOCOL_DSHOT150
+template <int MotorCount>
+void EscOutput<MotorCount>::encodeDshot(rmt_item32_t* frameItems, uint16_t frame) {
+    // Bit más significativo primero; cada bit es un pulso alto seguido de uno bajo
+    for (int bit = 0; bit < DSHOT_FRAME_BITS; bit++) {
+        bool one = frame & (0x8000 >> bit);
+        rmt_item32_t& item = frameItems[bit];
+        item.level0 = 1;
+        item.duration0 = one ? bitTicks.oneHigh : bitTicks.zeroHigh;
+        item.level1 = 0;
+        item.duration1 = one ? bitTicks.oneLow : bitTicks.zeroLow;
+    }
+}
+#endif
+
+template <int MotorCount>
+void EscOutput<MotorCount>::write(const int (&pulsesUs)[MotorCount]) {
+    if (!initialized) return;
+
+#if ESC_PROTOCOL == ESC_PROTOCOL_PWM
+    for (int i = 0; i < MotorCount; i++) {
+        servos[i].writeMicroseconds(pulsesUs[i]);
+    }
+#elif ESC_PROTOCOL >= ESC_PROTOCOL_DSHOT150
+    // Codificar todas las tramas antes de arrancar ningún canal para que las
+    // transmisiones salgan con pocos ciclos de diferencia
+    for (int i = 0; i < MotorCount; i++) {
+        uint16_t value = dshotValueFromPulse(pulsesUs[i], ESC_MIN_PULSE, ESC_MAX_PULSE);
+        encodeDshot(items[i], dshotEncodeFrame(value, false));
+        rmt_fill_tx_items((rmt_channel_t)(ESC_RMT_CHANNEL + i), items[i],
+                          DSHOT_FRAME_BITS + 1, 0);
+    }
+    for (int i = 0; i < MotorCount; i++) {
+        rmt_tx_start((rmt_channel_t)(ESC_RMT_CHANNEL + i), true);
+    }
+#else
+    for (int i = 0; i < MotorCount; i++) {
+        uint32_t pulseNs = escAnalogPulseNs(ESC_PROTOCOL, pulsesUs[i], ESC_MIN_PULSE, ESC_MAX_PULSE);
+        uint32_t duty = (uint32_t)(((uint64_t)pulseNs << ledcResolutionBits) / ledcPeriodNs);
+        ledcWrite(ESC_LEDC_CHANNEL + i, duty);
+    }
+#endif
+}
+
+// Salida del marco de config.h (ver EscOutput.h)
+template class EscOutput<NUM_MOTORS>;
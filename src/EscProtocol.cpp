@@ -0,0 +1,76 @@
+#include "EscProtocol.h"
+
+static const DshotTiming DSHOT_TIMINGS[] = {
+    { 6667, 5000, 2500 },   // DShot150
+    { 3333, 2500, 1250 },   // DShot300
+    { 1667, 1250,  625 },   // DShot600
+};
+
+bool escProtocolIsDshot(int protocol) {
+    return protocol >= ESC_PROTOCOL_DSHOT150 && protocol <= ESC_PROTOCOL_DSHOT600;
+}
+
+const DshotTiming* dshotTiming(int protocol) {
+    if (!escProtocolIsDshot(protocol)) return nullptr;
+    return &DSHOT_TIMINGS[protocol - ESC_PROTOCOL_DSHOT150];
+}
+
+bool dshotBitTicks(int protocol, uint32_t tickNs, DshotBitTicks& ticks) {
+    const DshotTiming* timing = dshotTiming(protocol);
+    if (timing == nullptr || tickNs == 0) return false;
+
+    // Redondear al tick más cercano
+    uint32_t bit = (timing->bitNs + tickNs / 2) / tickNs;
+    uint32_t oneHigh = (timing->oneHighNs + tickNs / 2) / tickNs;
+    uint32_t zeroHigh = (timing->zeroHighNs + tickNs / 2) / tickNs;
+    // Con un tick demasiado grueso el '1' y el '0' quedarían iguales
+    if (bit > 0x7FFF || zeroHigh == 0 || zeroHigh >= oneHigh || oneHigh >= bit) return false;
+
+    ticks.oneHigh = oneHigh;
+    ticks.oneLow = bit - oneHigh;
+    ticks.zeroHigh = zeroHigh;
+    ticks.zeroLow = bit - zeroHigh;
+    return true;
+}
+
+uint16_t dshotValueFromPulse(int pulseUs, int minPulseUs, int maxPulseUs) {
+    if (pulseUs <= minPulseUs) return 0;  // Motor parado
+    if (pulseUs >= maxPulseUs) return DSHOT_MAX_THROTTLE;
+
+    int32_t span = DSHOT_MAX_THROTTLE - DSHOT_MIN_THROTTLE;
+    return DSHOT_MIN_THROTTLE +
+           (uint16_t)((int32_t)(pulseUs - minPulseUs) * span / (maxPulseUs - minPulseUs));
+}
+
+uint16_t dshotEncodeFrame(uint16_t value, bool telemetryRequest) {
+    uint16_t packet = (uint16_t)(((value & 0x07FF) << 1) | (telemetryRequest ? 1 : 0));
+    uint16_t crc = (packet ^ (packet >> 4) ^ (packet >> 8)) & 0x0F;
+    return (uint16_t)((packet << 4) | crc);
+}
+
+uint32_t escAnalogPulseNs(int protocol, int pulseUs, int minPulseUs, int maxPulseUs) {
+    if (pulseUs < minPulseUs) pulseUs = minPulseUs;
+    if (pulseUs > maxPulseUs) pulseUs = maxPulseUs;
+    uint32_t fraction = (uint32_t)(pulseUs - minPulseUs);
+    uint32_t span = (uint32_t)(maxPulseUs - minPulseUs);
+
+    switch (protocol) {
+        case ESC_PROTOCOL_ONESHOT125:
+            return 125000 + fraction * 125000 / span;
+        case ESC_PROTOCOL_MULTISHOT:
+            return 5000 + fraction * 20000 / span;
+        default:
+            return (uint32_t)pulseUs * 1000;
+    }
+}
+
+uint32_t escAnalogFrequencyHz(int protocol) {
+    switch (protocol) {
+        case ESC_PROTOCOL_ONESHOT125:
+            return 2000;    // Periodo de 500 us > pulso máximo de 250 us
+        case ESC_PROTOCOL_MULTISHOT:
+            return 32000;   // Periodo de 31.25 us > pulso máximo de 25 us
+        default:
+            return 50;
+    }
+}
@@ -0,0 +1,69 @@
+#include "Failsafe.h"
+
+Failsafe::Failsafe(uint32_t holdUs, uint32_t landUs, uint32_t rampDurationUs)
+    : holdAfterUs(holdUs),
+      landAfterUs(landUs > holdUs ? landUs : holdUs),
+      rampUs(rampDurationUs > 0 ? rampDurationUs : 1) {
+    reset();
+}
+
+void Failsafe::reset() {
+    state = FAILSAFE_IDLE;
+    landingStartUs = 0;
+    landingThrottle = 0;
+    throttle = 0;
+    linkLost = false;
+}
+
+FailsafeState Failsafe::update(uint32_t nowUs, uint32_t lastFrameUs, bool linkActive,
+                               bool armed, float commandedThrottle) {
+    if (!linkActive) {
+        state = FAILSAFE_IDLE;
+        linkLost = false;
+        return state;
+    }
+
+    // La otra tarea puede marcar una trama justo después de leer el reloj
+    int32_t gap = (int32_t)(nowUs - lastFrameUs);
+    if (gap < 0) gap = 0;
+    bool linkFresh = (uint32_t)gap < holdAfterUs;
+    linkLost = !linkFresh;
+
+    switch (state) {
+        case FAILSAFE_IDLE:
+            if (armed && !linkFresh) {
+                state = FAILSAFE_HOLD;
+                throttle = commandedThrottle;
+            }
+            break;
+
+        case FAILSAFE_HOLD:
+            if (!armed || linkFresh) {
+                state = FAILSAFE_IDLE;
+            } else if ((uint32_t)gap >= landAfterUs) {
+                state = FAILSAFE_LANDING;
+                landingStartUs = nowUs;
+                landingThrottle = throttle;
+            }
+            break;
+
+        case FAILSAFE_LANDING: {
+            uint32_t elapsed = nowUs - landingStartUs;
+            if (!armed || elapsed >= rampUs) {
+                state = FAILSAFE_DISARMED;
+                throttle = 0;
+            } else {
+                throttle = landingThrottle * (1.0f - (float)elapsed / rampUs);
+            }
+            break;
+        }
+
+        case FAILSAFE_DISARMED:
+            // Para volver a volar hace falta enlace y un nuevo armado
+            if (linkFresh && !armed) {
+                state = FAILSAFE_IDLE;
+            }
+            break;
+    }
+    return state;
+}
@@ -0,0 +1,120 @@
+#include "Filters.h"
+#include <math.h>
+#include <string.h>
+
+// Coeficientes según el "Audio EQ Cookbook" de R. Bristow-Johnson
+
+void Biquad::setPassthrough() {
+    b0 = 1.0f;
+    b1 = b2 = a1 = a2 = 0.0f;
+    reset();
+}
+
+void Biquad::setLowpass(float cutoffHz, float sampleRateHz, float q) {
+    if (cutoffHz <= 0.0f || cutoffHz >= 0.5f * sampleRateHz) {
+        setPassthrough();
+        return;
+    }
+    float omega = 2.0f * (float)M_PI * cutoffHz / sampleRateHz;
+    float sn = sinf(omega);
+    float cs = cosf(omega);
+    float alpha = sn / (2.0f * q);
+    float a0 = 1.0f + alpha;
+
+    b0 = (1.0f - cs) * 0.5f / a0;
+    b1 = (1.0f - cs) / a0;
+    b2 = b0;
+    a1 = -2.0f * cs / a0;
+    a2 = (1.0f - alpha) / a0;
+}
+
+void Biquad::setNotch(float centerHz, float sampleRateHz, float q) {
+    if (centerHz <= 0.0f || centerHz >= 0.5f * sampleRateHz || q <= 0.0f) {
+        setPassthrough();
+        return;
+    }
+    float omega = 2.0f * (float)M_PI * centerHz / sampleRateHz;
+    float sn = sinf(omega);
+    float cs = cosf(omega);
+    float alpha = sn / (2.0f * q);
+    float a0 = 1.0f + alpha;
+
+    b0 = 1.0f / a0;
+    b1 = -2.0f * cs / a0;
+    b2 = b0;
+    a1 = b1;
+    a2 = (1.0f - alpha) / a0;
+}
+
+BiquadBank::BiquadBank() : stageCount(0), sampleRate(0.0f) {
+    memset(stages, 0, sizeof(stages));
+}
+
+void BiquadBank::init(float sampleRateHz) {
+    sampleRate = sampleRateHz;
+    stageCount = 0;
+    memset(stages, 0, sizeof(stages));
+}
+
+int BiquadBank::addStage(const Biquad& c) {
+    if (stageCount >= FILTER_MAX_STAGES) return -1;
+
+    Stage& stage = stages[stageCount];
+    for (int axis = 0; axis < FILTER_AXES; axis++) {
+        stage.b0[axis] = c.b0;
+        stage.b1[axis] = c.b1;
+        stage.b2[axis] = c.b2;
+        stage.a1[axis] = c.a1;
+        stage.a2[axis] = c.a2;
+        stage.z1[axis] = stage.z2[axis] = 0.0f;
+    }
+    return stageCount++;
+}
+
+int BiquadBank::addLowpass(float cutoffHz, float q) {
+    if (cutoffHz <= 0.0f || cutoffHz >= 0.5f * sampleRate) return -1;
+    Biquad c;
+    c.setLowpass(cutoffHz, sampleRate, q);
+    return addStage(c);
+}
+
+int BiquadBank::addNotch(float centerHz, float q) {
+    if (centerHz <= 0.0f || centerHz >= 0.5f * sampleRate || q <= 0.0f) return -1;
+    Biquad c;
+    c.setNotch(centerHz, sampleRate, q);
+    return addStage(c);
+}
+
+void BiquadBank::setNotch(int stage, int axis, float centerHz, float q) {
+    if (stage < 0 || stage >= stageCount || axis < 0 || axis >= FILTER_AXES) return;
+
+    Biquad c;
+    c.setNotch(centerHz, sampleRate, q);
+    Stage& s = stages[stage];
+    s.b0[axis] = c.b0;
+    s.b1[axis] = c.b1;
+    s.b2[axis] = c.b2;
+    s.a1[axis] = c.a1;
+    s.a2[axis] = c.a2;
+}
+
+void BiquadBank::apply(float values[FILTER_AXES]) {
+    for (int i = 0; i < stageCount; i++) {
+        Stage& s = stages[i];
+        for (int axis = 0; axis < FILTER_AXES; axis++) {
+            float x = values[axis];
+            float y = s.b0[axis] * x + s.z1[axis];
+            s.z1[axis] = s.b1[axis] * x - s.a1[axis] * y + s.z2[axis];
+            s.z2[axis] = s.b2[axis] * x - s.a2[axis] * y;
+            values[axis] = y;
+        }
+    }
+}
+
+void BiquadBank::reset() {
+    for (int i = 0; i < stageCount; i++) {
+        for (int axis = 0; axis < FILTER_AXES; axis++) {
+            stages[i].z1[axis] = stages[i].z2[axis] = 0.0f;
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#include "Framing.h"
+#include <string.h>
+
+uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc) {
+    // CRC16-CCITT (polinomio 0x1021)
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t cobsEncode(const uint8_t* input, size_t length, uint8_t* output) {
+    size_t readIndex = 0;
+    size_t writeIndex = 1;
+    size_t codeIndex = 0;
+    uint8_t code = 1;
+
+    while (readIndex < length) {
+        if (input[readIndex] == 0) {
+            output[codeIndex] = code;
+            code = 1;
+            codeIndex = writeIndex++;
+            readIndex++;
+        } else {
+            output[writeIndex++] = input[readIndex++];
+            code++;
+            if (code == 0xFF) {
+                output[codeIndex] = code;
+                code = 1;
+                codeIndex = writeIndex++;
+            }
+        }
+    }
+    output[codeIndex] = code;
+    return writeIndex;
+}
+
+size_t cobsDecode(const uint8_t* input, size_t length, uint8_t* output, size_t maxOutput) {
+    size_t readIndex = 0;
+    size_t writeIndex = 0;
+
+    while (readIndex < length) {
+        uint8_t code = input[readIndex++];
+        if (code == 0 || readIndex + code - 1 > length) return 0;
+
+        for (uint8_t i = 1; i < code; i++) {
+            if (writeIndex >= maxOutput || input[readIndex] == 0) return 0;
+            output[writeIndex++] = input[readIndex++];
+        }
+        if (code != 0xFF && readIndex < length) {
+            if (writeIndex >= maxOutput) return 0;
+            output[writeIndex++] = 0;
+        }
+    }
+    return writeIndex;
+}
+
+size_t encodeFrame(const uint8_t* payload, size_t length, uint8_t* output) {
+    if (length > FRAME_MAX_PAYLOAD) return 0;
+
+    uint8_t buffer[FRAME_MAX_PAYLOAD + FRAME_CRC_BYTES];
+    memcpy(buffer, payload, length);
+    uint16_t crc = crc16(payload, length);
+    buffer[length] = crc & 0xFF;
+    buffer[length + 1] = crc >> 8;
+
+    size_t encoded = cobsEncode(buffer, length + FRAME_CRC_BYTES, output);
+    output[encoded++] = FRAME_DELIMITER;
+    return encoded;
+}
+
+size_t decodeFrame(const uint8_t* input, size_t length, uint8_t* payload, size_t maxPayload) {
+    uint8_t buffer[FRAME_MAX_PAYLOAD + FRAME_CRC_BYTES];
+    size_t decoded = cobsDecode(input, length, buffer, sizeof(buffer));
+    if (decoded <= FRAME_CRC_BYTES || decoded - FRAME_CRC_BYTES > maxPayload) return 0;
+
+    size_t payloadLength = decoded - FRAME_CRC_BYTES;
+    uint16_t crc = buffer[payloadLength] | (buffer[payloadLength + 1] << 8);
+    if (crc != crc16(buffer, payloadLength)) return 0;
+
+    memcpy(payload, buffer, payloadLength);
+    return payloadLength;
+}
@@ -0,0 +1,122 @@
+#include "GyroCalibrator.h"
+
+// Media de `count` muestras en punto fijo, redondeada
+static int32_t fixedMean(int32_t sum, uint32_t count) {
+    int64_t scaled = (int64_t)sum * (1 << GYRO_OFFSET_FRACTION_BITS);
+    int64_t half = count / 2;
+    return (int32_t)((scaled + (scaled >= 0 ? half : -half)) / (int64_t)count);
+}
+
+StillnessDetector::StillnessDetector(uint16_t samplesPerBlock, int16_t stillRange)
+    : count(0),
+      blockSize(samplesPerBlock > 0 ? samplesPerBlock : 1),
+      maxRange(stillRange),
+      lastStill(false) {
+    for (int axis = 0; axis < 3; axis++) {
+        lastSum[axis] = 0;
+    }
+    reset();
+}
+
+void StillnessDetector::reset() {
+    count = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        minValue[axis] = INT16_MAX;
+        maxValue[axis] = INT16_MIN;
+        sum[axis] = 0;
+    }
+}
+
+bool StillnessDetector::addSample(const int16_t gyro[3]) {
+    for (int axis = 0; axis < 3; axis++) {
+        if (gyro[axis] < minValue[axis]) minValue[axis] = gyro[axis];
+        if (gyro[axis] > maxValue[axis]) maxValue[axis] = gyro[axis];
+        sum[axis] += gyro[axis];
+    }
+    if (++count < blockSize) return false;
+
+    lastStill = true;
+    for (int axis = 0; axis < 3; axis++) {
+        if ((int32_t)maxValue[axis] - minValue[axis] > maxRange) lastStill = false;
+        lastSum[axis] = sum[axis];
+    }
+    reset();
+    return true;
+}
+
+GyroCalibrator::GyroCalibrator(uint16_t samplesPerBlock, uint16_t blocksRequired,
+                               int16_t stillRange, int32_t toleranceFixed)
+    : detector(samplesPerBlock, stillRange),
+      state(CALIBRATION_IDLE),
+      offsetsValid(false),
+      stillBlocks(0),
+      requiredBlocks(blocksRequired > 0 ? blocksRequired : 1),
+      tolerance(toleranceFixed) {
+    for (int axis = 0; axis < 3; axis++) {
+        offsets[axis] = 0;
+        sum[axis] = 0;
+    }
+}
+
+void GyroCalibrator::begin(const int32_t* storedOffsets) {
+    detector.reset();
+    offsetsValid = storedOffsets != nullptr;
+    for (int axis = 0; axis < 3; axis++) {
+        offsets[axis] = offsetsValid ? storedOffsets[axis] : 0;
+    }
+
+    if (offsetsValid) {
+        state = CALIBRATION_VERIFYING;
+    } else {
+        startRunning();
+    }
+}
+
+void GyroCalibrator::startRunning() {
+    state = CALIBRATION_RUNNING;
+    stillBlocks = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        sum[axis] = 0;
+    }
+}
+
+bool GyroCalibrator::addSample(const int16_t gyro[3]) {
+    if (state != CALIBRATION_VERIFYING && state != CALIBRATION_RUNNING) return false;
+    if (!detector.addSample(gyro)) return false;
+
+    if (!detector.wasStill()) {
+        // Movimiento: lo acumulado ya no sirve
+        if (state == CALIBRATION_RUNNING) startRunning();
+        return false;
+    }
+
+    const int32_t* blockSum = detector.getBlockSum();
+    uint16_t blockSize = detector.getBlockSize();
+
+    if (state == CALIBRATION_VERIFYING) {
+        bool matches = true;
+        for (int axis = 0; axis < 3; axis++) {
+            int32_t difference = fixedMean(blockSum[axis], blockSize) - offsets[axis];
+            if (difference > tolerance || difference < -tolerance) matches = false;
+        }
+        if (matches) {
+            state = CALIBRATION_DONE;
+            return false;
+        }
+        // Offsets obsoletos: este bloque en reposo ya cuenta para la calibración
+        startRunning();
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        sum[axis] += blockSum[axis];
+    }
+    if (++stillBlocks < requiredBlocks) return false;
+
+    uint32_t samples = (uint32_t)stillBlocks * blockSize;
+    for (int axis = 0; axis < 3; axis++) {
+        offsets[axis] = fixedMean(sum[axis], samples);
+    }
+    offsetsValid = true;
+    state = CALIBRATION_DONE;
+    return true;
+}
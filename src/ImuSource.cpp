@@ -0,0 +1,52 @@
+#include "ImuSource.h"
+#include <Arduino.h>
+
+// Driver activo y tarea que espera sus datos. La ISR (IRAM) sólo usa estos
+// punteros, micros(), MPU6050Driver::handleDataReady y la notificación de
+// FreeRTOS, todos fuera de flash.
+static MPU6050Driver* dataReadyImu = nullptr;
+static volatile TaskHandle_t dataReadyTask = nullptr;
+
+static void IRAM_ATTR onImuDataReady() {
+    if (dataReadyImu) {
+        dataReadyImu->handleDataReady(micros());
+    }
+    TaskHandle_t task = dataReadyTask;
+    if (task) {
+        BaseType_t higherPriorityWoken = pdFALSE;
+        vTaskNotifyGiveFromISR(task, &higherPriorityWoken);
+        portYIELD_FROM_ISR(higherPriorityWoken);
+    }
+}
+
+Mpu6050Source::Mpu6050Source(I2CBus& bus)
+    : imu(bus) {
+}
+
+bool Mpu6050Source::init(const ImuConfig& config) {
+    return imu.begin() && imu.configure(config.dlpfConfig, config.sampleRateHz);
+}
+
+void Mpu6050Source::notifyOnDataReady(TaskHandle_t task) {
+    dataReadyTask = task;
+}
+
+bool Mpu6050Source::startFifo() {
+    if (!imu.enableFifo()) return false;
+    
+    dataReadyImu = &imu;
+    pinMode(PIN_MPU6050_INT, INPUT);
+    attachInterrupt(digitalPinToInterrupt(PIN_MPU6050_INT), onImuDataReady, RISING);
+    return true;
+}
+
+size_t Mpu6050Source::read(ImuSample* samples, size_t maxSamples) {
+    if (usesFifo) {
+        // Drenar todas las muestras pendientes en una sola ráfaga
+        return imu.readFifo(samples, maxSamples);
+    }
+    
+    // Leer el bloque de 14 bytes de registros en una transacción
+    if (maxSamples == 0 || !imu.readRaw(samples[0])) return 0;
+    return 1;
+}
@@ -0,0 +1,48 @@
+#include "InputInterpolator.h"
+
+InputInterpolator::InputInterpolator(uint32_t minPeriodUs, uint32_t maxPeriodUs)
+    : commandPeriod(maxPeriodUs / 1000000.0f),
+      minPeriod(minPeriodUs / 1000000.0f),
+      maxPeriod(maxPeriodUs / 1000000.0f),
+      lastCommandUs(0),
+      hasCommand(false) {
+    for (int axis = 0; axis < INTERPOLATOR_AXES; axis++) {
+        current[axis] = target[axis] = slope[axis] = 0.0f;
+    }
+}
+
+void InputInterpolator::setTarget(const float values[INTERPOLATOR_AXES], uint32_t nowUs) {
+    if (hasCommand) {
+        // Media móvil del intervalo para absorber el jitter del enlace
+        float interval = (nowUs - lastCommandUs) / 1000000.0f;
+        if (interval > maxPeriod) interval = maxPeriod;
+        commandPeriod += 0.25f * (interval - commandPeriod);
+    }
+    if (commandPeriod < minPeriod) commandPeriod = minPeriod;
+    lastCommandUs = nowUs;
+    hasCommand = true;
+
+    for (int axis = 0; axis < INTERPOLATOR_AXES; axis++) {
+        target[axis] = values[axis];
+        slope[axis] = (target[axis] - current[axis]) / commandPeriod;
+    }
+}
+
+void InputInterpolator::jumpTo(const float values[INTERPOLATOR_AXES]) {
+    for (int axis = 0; axis < INTERPOLATOR_AXES; axis++) {
+        current[axis] = target[axis] = values[axis];
+        slope[axis] = 0.0f;
+    }
+}
+
+void InputInterpolator::update(float dt) {
+    for (int axis = 0; axis < INTERPOLATOR_AXES; axis++) {
+        float next = current[axis] + slope[axis] * dt;
+        // Sin pasarse del objetivo
+        if ((slope[axis] > 0.0f && next > target[axis]) ||
+            (slope[axis] < 0.0f && next < target[axis])) {
+            next = target[axis];
+        }
+        current[axis] = next;
+    }
+}
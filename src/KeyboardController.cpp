@@ -1,6 +1,9 @@
 #include "KeyboardController.h"
+#include "Blackbox.h"
+#include "Profiler.h"
 
-KeyboardController::KeyboardController() : helpShown(false) {
+KeyboardController::KeyboardController(Logger& logOutput)
+    : logger(logOutput), helpShown(false), telemetryMode(false), benchmarkRequested(false), traceDumpRequested(false) {
     memset(&currentInputs, 0, sizeof(currentInputs));
 }
 
@@ -22,12 +25,31 @@ void KeyboardController::showHelp() {
     Serial.println("  T    - Desarmar motores");
     Serial.println("  X    - Parada de emergencia");
     Serial.println("");
+    Serial.println("MODO:");
+    Serial.println("  M    - Ángulo / acro (sólo velocidad)");
+    Serial.println("");
     Serial.println("OTROS:");
     Serial.println("  H    - Mostrar esta ayuda");
     Serial.println("  C    - Centrar controles");
     Serial.println("  Z    - Mostrar estado");
+    Serial.println("  B    - Telemetría binaria on/off");
+    Serial.println("  $    - Parámetros: $list, $get/$set <nombre> [valor], $save, $defaults");
+#if ENABLE_PROFILER
+    Serial.println("  P    - Perfil del loop (y reiniciar)");
+#endif
+#if ENABLE_BENCHMARKS
+    Serial.println("  J    - Benchmarks del lazo (JSON, desarmado)");
+#endif
+#if ENABLE_TRACE
+    Serial.println("  G    - Volcar la traza de eventos (tools/trace_to_chrome.py)");
+#endif
+#if ENABLE_BLACKBOX
+    Serial.println("  L    - Estado del blackbox");
+    Serial.println("  V    - Borrar el blackbox (desarmado)");
+#endif
     Serial.println("");
     Serial.println("Incrementos: ±5% por pulsación");
+    Serial.println("Mandos absolutos: tramas binarias (tools/command_send.py)");
     Serial.println("ADVERTENCIA: ¡Mantén el throttle bajo para armar!");
     Serial.println("==============================\n");
     helpShown = true;
@@ -42,7 +64,7 @@ bool KeyboardController::processInput(char key) {
         case 'I':
             currentInputs.throttle += 5;
             if (currentInputs.throttle > 100) currentInputs.throttle = 100;
-            Serial.printf("Throttle: %.0f%%\n", currentInputs.throttle);
+            logger.log(LOG_KEY_THROTTLE, currentInputs.throttle);
             inputChanged = true;
             break;
             
@@ -50,7 +72,7 @@ bool KeyboardController::processInput(char key) {
         case 'K':
             currentInputs.throttle -= 5;
             if (currentInputs.throttle < 0) currentInputs.throttle = 0;
-            Serial.printf("Throttle: %.0f%%\n", currentInputs.throttle);
+            logger.log(LOG_KEY_THROTTLE, currentInputs.throttle);
             inputChanged = true;
             break;
             
@@ -59,7 +81,7 @@ bool KeyboardController::processInput(char key) {
         case 'A':
             currentInputs.rollCmd -= 10;
             if (currentInputs.rollCmd < -100) currentInputs.rollCmd = -100;
-            Serial.printf("Roll: %.0f%%\n", currentInputs.rollCmd);
+            logger.log(LOG_KEY_ROLL, currentInputs.rollCmd);
             inputChanged = true;
             break;
             
@@ -67,7 +89,7 @@ bool KeyboardController::processInput(char key) {
         case 'D':
             currentInputs.rollCmd += 10;
             if (currentInputs.rollCmd > 100) currentInputs.rollCmd = 100;
-            Serial.printf("Roll: %.0f%%\n", currentInputs.rollCmd);
+            logger.log(LOG_KEY_ROLL, currentInputs.rollCmd);
             inputChanged = true;
             break;
             
@@ -76,7 +98,7 @@ bool KeyboardController::processInput(char key) {
         case 'W':
             currentInputs.pitchCmd += 10;
             if (currentInputs.pitchCmd > 100) currentInputs.pitchCmd = 100;
-            Serial.printf("Pitch: %.0f%%\n", currentInputs.pitchCmd);
+            logger.log(LOG_KEY_PITCH, currentInputs.pitchCmd);
             inputChanged = true;
             break;
             
@@ -84,7 +106,7 @@ bool KeyboardController::processInput(char key) {
         case 'S':
             currentInputs.pitchCmd -= 10;
             if (currentInputs.pitchCmd < -100) currentInputs.pitchCmd = -100;
-            Serial.printf("Pitch: %.0f%%\n", currentInputs.pitchCmd);
+            logger.log(LOG_KEY_PITCH, currentInputs.pitchCmd);
             inputChanged = true;
             break;
             
@@ -93,7 +115,7 @@ bool KeyboardController::processInput(char key) {
         case 'Q':
             currentInputs.yawCmd -= 10;
             if (currentInputs.yawCmd < -100) currentInputs.yawCmd = -100;
-            Serial.printf("Yaw: %.0f%%\n", currentInputs.yawCmd);
+            logger.log(LOG_KEY_YAW, currentInputs.yawCmd);
             inputChanged = true;
             break;
             
@@ -101,7 +123,7 @@ bool KeyboardController::processInput(char key) {
         case 'E':
             currentInputs.yawCmd += 10;
             if (currentInputs.yawCmd > 100) currentInputs.yawCmd = 100;
-            Serial.printf("Yaw: %.0f%%\n", currentInputs.yawCmd);
+            logger.log(LOG_KEY_YAW, currentInputs.yawCmd);
             inputChanged = true;
             break;
             
@@ -110,7 +132,7 @@ bool KeyboardController::processInput(char key) {
         case 'R':
             currentInputs.armCmd = true;
             currentInputs.disarmCmd = false;
-            Serial.printf("Comando: ARMAR (Throttle: %.1f%%)\n", currentInputs.throttle);
+            logger.log(LOG_KEY_ARM, currentInputs.throttle);
             inputChanged = true;
             break;
             
@@ -118,7 +140,15 @@ bool KeyboardController::processInput(char key) {
         case 'T':
             currentInputs.disarmCmd = true;
             currentInputs.armCmd = false;
-            Serial.println("Comando: DESARMAR");
+            logger.log(LOG_KEY_DISARM);
+            inputChanged = true;
+            break;
+            
+        // Modo de vuelo
+        case 'm':
+        case 'M':
+            currentInputs.acroMode = !currentInputs.acroMode;
+            logger.log(currentInputs.acroMode ? LOG_KEY_MODE_ACRO : LOG_KEY_MODE_ANGLE);
             inputChanged = true;
             break;
             
@@ -128,7 +158,7 @@ bool KeyboardController::processInput(char key) {
             currentInputs.rollCmd = 0;
             currentInputs.pitchCmd = 0;
             currentInputs.yawCmd = 0;
-            Serial.println("Controles centrados");
+            logger.log(LOG_KEY_CENTER);
             inputChanged = true;
             break;
             
@@ -141,7 +171,7 @@ bool KeyboardController::processInput(char key) {
             currentInputs.yawCmd = 0;
             currentInputs.disarmCmd = true;
             currentInputs.armCmd = false;
-            Serial.println("¡PARADA DE EMERGENCIA!");
+            logger.log(LOG_KEY_EMERGENCY);
             inputChanged = true;
             break;
             
@@ -151,12 +181,68 @@ bool KeyboardController::processInput(char key) {
             showHelp();
             break;
             
+        // Telemetría binaria
+        case 'b':
+        case 'B':
+            telemetryMode = !telemetryMode;
+            Serial.println(telemetryMode ? "Telemetría binaria activada" : "Telemetría binaria desactivada");
+            break;
+            
+#if ENABLE_PROFILER
+        // Perfil del loop
+        case 'p':
+        case 'P':
+            profiler.report(Serial);
+            break;
+#endif
+            
+#if ENABLE_BENCHMARKS
+        // Microbenchmarks (se ejecutan desde la tarea de comunicaciones)
+        case 'j':
+        case 'J':
+            benchmarkRequested = true;
+            break;
+#endif
+            
+#if ENABLE_TRACE
+        // Volcado de la traza de eventos
+        case 'g':
+        case 'G':
+            traceDumpRequested = true;
+            break;
+#endif
+            
+#if ENABLE_BLACKBOX
+        // Registro de vuelo
+        case 'l':
+        case 'L':
+            if (!blackbox.isReady()) {
+                Serial.println("Blackbox no disponible");
+                break;
+            }
+            Serial.printf("Blackbox: %u/%u KB en flash, %u KB en buffer, %lu registros, %lu perdidos%s%s\n",
+                         (unsigned)(blackbox.getUsedBytes() / 1024),
+                         (unsigned)(blackbox.getCapacity() / 1024),
+                         (unsigned)(blackbox.getBufferedBytes() / 1024),
+                         (unsigned long)blackbox.getRecordCount(),
+                         (unsigned long)blackbox.getDroppedRecords(),
+                         blackbox.isFull() ? " | LLENO" : "",
+                         blackbox.isErasing() ? " | BORRANDO" : "");
+            break;
+            
+        case 'v':
+        case 'V':
+            blackbox.requestErase();
+            Serial.println("Blackbox: borrado solicitado (se hace con los motores desarmados)");
+            break;
+#endif
+            
         // Estado
         case 'z':
         case 'Z':
-            Serial.printf("Estado actual - T:%.0f%% R:%.0f%% P:%.0f%% Y:%.0f%%\n",
-                         currentInputs.throttle, currentInputs.rollCmd, 
-                         currentInputs.pitchCmd, currentInputs.yawCmd);
+            logger.log(currentInputs.acroMode ? LOG_KEY_STATUS_ACRO : LOG_KEY_STATUS_ANGLE,
+                       currentInputs.throttle, currentInputs.rollCmd,
+                       currentInputs.pitchCmd, currentInputs.yawCmd);
             break;
             
         default:
@@ -173,20 +259,40 @@ bool KeyboardController::processInput(char key) {
     return inputChanged;
 }
 
-void KeyboardController::showStatus(const FlightData& data) {
-    Serial.printf("Estado: %s | R:%.1f° P:%.1f° Y:%.1f° | RRate:%.1f°/s PRate:%.1f°/s YRate:%.1f°/s\n",
-                  data.armed ? "ARMADO" : "DESARMADO",
-                  data.roll, data.pitch, data.yaw,
-                  data.rollRate, data.pitchRate, data.yawRate);
+bool KeyboardController::takeBenchmarkRequest() {
+    bool requested = benchmarkRequested;
+    benchmarkRequested = false;
+    return requested;
 }
 
-void KeyboardController::update(const FlightData& flightData) {
-    static unsigned long lastStatusTime = 0;
-    unsigned long currentTime = millis();
+bool KeyboardController::takeTraceDumpRequest() {
+    bool requested = traceDumpRequested;
+    traceDumpRequested = false;
+    return requested;
+}
+
+void KeyboardController::showStatus(const StateBus& bus) {
+    static const char* const failsafeNames[] = { "", " | FAILSAFE: NIVELANDO", " | FAILSAFE: BAJANDO", " | FAILSAFE: DESARMADO" };
+    
+    // Instantáneas coherentes de cada tema, sin acceder al FlightController
+    StatusState status;
+    AttitudeState attitude;
+    ImuState imu;
+    bus.status.read(status);
+    bus.attitude.read(attitude);
+    bus.imu.read(imu);
     
-    // Mostrar estado cada 2 segundos
-    if (currentTime - lastStatusTime > 2000) {
-        showStatus(flightData);
-        lastStatusTime = currentTime;
+    Serial.printf("Estado: %s%s | R:%.1f° P:%.1f° Y:%.1f° | RRate:%.1f°/s PRate:%.1f°/s YRate:%.1f°/s\n",
+                  status.armed ? "ARMADO" : status.calibrated ? "DESARMADO" : "SIN CALIBRAR",
+                  failsafeNames[status.failsafe & 0x03],
+                  attitude.roll, attitude.pitch, attitude.yaw,
+                  imu.rates[0], imu.rates[1], imu.rates[2]);
+}
+
+void KeyboardController::update(const StateBus& bus) {
+    // El Scheduler la llama cada STATUS_PERIOD_US
+    // (no mezclar texto con la telemetría binaria)
+    if (!telemetryMode) {
+        showStatus(bus);
     }
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "LinkMonitor.h"
+
+LinkMonitor::LinkMonitor(uint32_t dropoutThresholdUs)
+    : lastFrameUs(0),
+      active(false),
+      frameCount(0),
+      windowStartUs(0),
+      windowFrames(0),
+      rateHz(0),
+      maxGapUs(0),
+      dropoutCount(0),
+      dropoutUs(dropoutThresholdUs) {
+}
+
+void LinkMonitor::onFrame(uint32_t nowUs, uint32_t frames) {
+    if (active.load(std::memory_order_relaxed)) {
+        uint32_t gap = nowUs - lastFrameUs.load(std::memory_order_relaxed);
+        if (gap > maxGapUs) maxGapUs = gap;
+        if (gap > dropoutUs) dropoutCount++;
+    } else {
+        windowStartUs = nowUs;
+    }
+
+    frameCount += frames;
+    windowFrames += frames;
+    lastFrameUs.store(nowUs, std::memory_order_release);
+    active.store(true, std::memory_order_release);
+}
+
+void LinkMonitor::update(uint32_t nowUs) {
+    if (!active.load(std::memory_order_relaxed)) return;
+
+    uint32_t elapsed = nowUs - windowStartUs;
+    if (elapsed < 1000000) return;
+
+    rateHz = windowFrames * 1000000.0f / elapsed;
+    windowFrames = 0;
+    windowStartUs = nowUs;
+}
+
+void LinkMonitor::resetStats() {
+    maxGapUs = 0;
+    dropoutCount = 0;
+}
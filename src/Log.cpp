@@ -0,0 +1,120 @@
+#include "Log.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_INFO(id, types, format) { #id, types, format },
+static const LogMessageInfo logMessages[LOG_MESSAGE_COUNT] = {
+    LOG_MESSAGE_LIST(LOG_INFO)
+};
+#undef LOG_INFO
+
+static const LogMessageInfo unknownMessage = { "LOG_UNKNOWN", "", "Mensaje desconocido" };
+
+const LogMessageInfo& Logger::getMessage(uint16_t id) {
+    return id < LOG_MESSAGE_COUNT ? logMessages[id] : unknownMessage;
+}
+
+size_t Logger::format(const LogEntry& entry, char* output, size_t size) {
+    if (size == 0) return 0;
+    const LogMessageInfo& message = getMessage(entry.id);
+    const char* in = message.format;
+    size_t length = 0;
+    uint16_t arg = 0;
+
+    // Cada conversión se formatea por separado con el tipo declarado del
+    // argumento, así no hace falta reconstruir una lista variable
+    while (*in && length + 1 < size) {
+        if (*in != '%') {
+            output[length++] = *in++;
+            continue;
+        }
+        if (in[1] == '%') {
+            output[length++] = '%';
+            in += 2;
+            continue;
+        }
+
+        char spec[16];
+        size_t specLength = 0;
+        do {
+            spec[specLength++] = *in++;
+        } while (*in && specLength < sizeof(spec) - 1 && !strchr("diufFeEgGxX", in[-1]));
+        spec[specLength] = '\0';
+
+        int written = 0;
+        char type = arg < entry.argCount ? message.types[arg] : '\0';
+        if (type == 'f') {
+            written = snprintf(output + length, size - length, spec, (double)entry.args[arg].f);
+        } else if (type == 'i') {
+            written = snprintf(output + length, size - length, spec, (int)entry.args[arg].i);
+        } else if (type == 'u') {
+            written = snprintf(output + length, size - length, spec, (unsigned)entry.args[arg].u);
+        } else {
+            written = snprintf(output + length, size - length, "?");
+        }
+        arg++;
+        if (written < 0) break;
+        length += (size_t)written < size - length ? (size_t)written : size - length - 1;
+    }
+    output[length] = '\0';
+    return length;
+}
+
+size_t Logger::encode(const LogEntry& entry, uint8_t* output) {
+    LogFrame frame;
+    frame.type = LOG_FRAME_TYPE;
+    frame.id = entry.id;
+    frame.timestampUs = entry.timestampUs;
+    for (uint16_t i = 0; i < LOG_MAX_ARGS; i++) {
+        frame.args[i] = i < entry.argCount ? entry.args[i].u : 0;
+    }
+    return encodeFrame((const uint8_t*)&frame, sizeof(frame), output);
+}
+
+// Salida por la UART: sólo en la placa. El formato y la codificación de
+// arriba también se usan en el host.
+#if TARGET_BOARD
+#include <Arduino.h>
+
+bool Logger::emit(const LogEntry& entry, HardwareSerial& port, bool binary) {
+    if (binary) {
+        if (port.availableForWrite() < (int)LOG_FRAME_MAX_ENCODED) return false;
+        uint8_t encoded[LOG_FRAME_MAX_ENCODED];
+        port.write(encoded, encode(entry, encoded));
+    } else {
+        if (port.availableForWrite() < LOG_LINE_MAX + 2) return false;
+        char line[LOG_LINE_MAX];
+        size_t length = format(entry, line, sizeof(line));
+        port.write((const uint8_t*)line, length);
+        port.write((const uint8_t*)"\r\n", 2);
+    }
+    return true;
+}
+
+size_t Logger::drain(HardwareSerial& port, bool binary) {
+    // Avisar primero de los mensajes perdidos por cola llena
+    uint32_t lost = takeDropped();
+    if (lost > 0) {
+        LogEntry entry;
+        entry.timestampUs = clock();
+        entry.id = LOG_MESSAGES_DROPPED;
+        entry.argCount = 1;
+        entry.args[0] = LogArg((unsigned)lost);
+        if (!emit(entry, port, binary)) {
+            dropped.fetch_add(lost, std::memory_order_relaxed);
+            return 0;
+        }
+    }
+
+    // Comprobar el hueco antes de sacar la entrada: nada se pierde al vaciar
+    size_t count = 0;
+    LogEntry entry;
+    int room = binary ? (int)LOG_FRAME_MAX_ENCODED : LOG_LINE_MAX + 2;
+    while (port.availableForWrite() >= room && ring.pop(entry)) {
+        emit(entry, port, binary);
+        count++;
+    }
+    return count;
+}
+
+#endif
@@ -0,0 +1,160 @@
+#include "MPU6050Driver.h"
+
+// Muestras leídas por transacción I2C (el buffer de Wire es de 128 bytes)
+static const size_t FIFO_CHUNK_SAMPLES = 10;
+
+static inline int16_t readBE16(const uint8_t* p) {
+    return (int16_t)((p[0] << 8) | p[1]);
+}
+
+MPU6050Driver::MPU6050Driver(I2CBus& i2c, uint8_t addr)
+    : bus(i2c),
+      address(addr),
+      samplePeriodUs(1000),
+      pendingCount(0),
+      lastInterruptUs(0),
+      lastSampleUs(0),
+      timestampValid(false),
+      overflowCount(0) {
+}
+
+bool MPU6050Driver::begin() {
+    uint8_t whoAmI = 0;
+    if (!bus.readRegisters(address, MPU6050_REG_WHO_AM_I, &whoAmI, 1)) return false;
+    if (whoAmI != 0x68) return false;
+
+    // Despertar y usar el PLL del giroscopio X como reloj
+    if (!bus.writeRegister(address, MPU6050_REG_PWR_MGMT_1, 0x01)) return false;
+
+    // Rangos fijos: ±250°/s y ±2g (ver GYRO_SENSITIVITY / ACCEL_SENSITIVITY)
+    if (!bus.writeRegister(address, MPU6050_REG_GYRO_CONFIG, 0x00)) return false;
+    if (!bus.writeRegister(address, MPU6050_REG_ACCEL_CONFIG, 0x00)) return false;
+
+    return true;
+}
+
+bool MPU6050Driver::configure(uint8_t dlpfConfig, uint16_t sampleRateHz) {
+    dlpfConfig &= 0x07;
+
+    // Con el DLPF desactivado (0 o 7) el giroscopio muestrea a 8 kHz
+    uint32_t baseRate = (dlpfConfig == 0 || dlpfConfig == 7) ? 8000 : 1000;
+    uint32_t divider = sampleRateHz > 0 ? baseRate / sampleRateHz : 1;
+    if (divider < 1) divider = 1;
+    if (divider > 256) divider = 256;
+
+    if (!bus.writeRegister(address, MPU6050_REG_CONFIG, dlpfConfig)) return false;
+    if (!bus.writeRegister(address, MPU6050_REG_SMPLRT_DIV, (uint8_t)(divider - 1))) return false;
+
+    samplePeriodUs = 1000000UL * divider / baseRate;
+    return true;
+}
+
+bool MPU6050Driver::enableFifo() {
+    // Detener el FIFO mientras se reconfigura
+    if (!bus.writeRegister(address, MPU6050_REG_USER_CTRL, 0x00)) return false;
+
+    // Sólo acelerómetro y giroscopio; la temperatura no se usa
+    if (!bus.writeRegister(address, MPU6050_REG_FIFO_EN, 0x78)) return false;
+
+    // INT activo en alto, push-pull, pulso de 50 us, se limpia con cualquier lectura
+    if (!bus.writeRegister(address, MPU6050_REG_INT_PIN_CFG, 0x10)) return false;
+
+    // Interrupciones de datos listos y desbordamiento del FIFO
+    if (!bus.writeRegister(address, MPU6050_REG_INT_ENABLE, 0x11)) return false;
+
+    return resetFifo();
+}
+
+bool MPU6050Driver::resetFifo() {
+    timestampValid = false;
+    pendingCount.store(0, std::memory_order_release);
+    return bus.writeRegister(address, MPU6050_REG_USER_CTRL, 0x44);  // FIFO_EN | FIFO_RESET
+}
+
+bool MPU6050Driver::readRaw(ImuSample& sample) {
+    uint8_t buffer[14];
+    if (!bus.readRegisters(address, MPU6050_REG_ACCEL_XOUT_H, buffer, sizeof(buffer))) return false;
+
+    // Acelerómetro (0-5), temperatura (6-7, ignorada), giroscopio (8-13)
+    sample.accel[0] = readBE16(buffer + 0);
+    sample.accel[1] = readBE16(buffer + 2);
+    sample.accel[2] = readBE16(buffer + 4);
+    sample.gyro[0] = readBE16(buffer + 8);
+    sample.gyro[1] = readBE16(buffer + 10);
+    sample.gyro[2] = readBE16(buffer + 12);
+    sample.timestampUs = 0;
+    return true;
+}
+
+size_t MPU6050Driver::readFifo(ImuSample* samples, size_t maxSamples) {
+    // Capturar el último flanco de INT antes de leer el contador del FIFO
+    uint32_t anchorUs = lastInterruptUs.load(std::memory_order_relaxed);
+
+    uint8_t status = 0;
+    if (!bus.readRegisters(address, MPU6050_REG_INT_STATUS, &status, 1)) return 0;
+    if (status & 0x10) {
+        // Desbordamiento: el FIFO puede estar desalineado, descartarlo
+        overflowCount++;
+        resetFifo();
+        return 0;
+    }
+
+    uint8_t countBytes[2];
+    if (!bus.readRegisters(address, MPU6050_REG_FIFO_COUNTH, countBytes, 2)) return 0;
+    size_t available = ((countBytes[0] << 8) | countBytes[1]) / MPU6050_FIFO_SAMPLE_BYTES;
+    size_t count = available < maxSamples ? available : maxSamples;
+
+    // Lectura en ráfaga, en bloques que caben en el buffer de I2C
+    uint8_t buffer[FIFO_CHUNK_SAMPLES * MPU6050_FIFO_SAMPLE_BYTES];
+    size_t done = 0;
+    while (done < count) {
+        size_t chunk = count - done;
+        if (chunk > FIFO_CHUNK_SAMPLES) chunk = FIFO_CHUNK_SAMPLES;
+
+        if (!bus.readRegisters(address, MPU6050_REG_FIFO_R_W, buffer,
+                               chunk * MPU6050_FIFO_SAMPLE_BYTES)) {
+            // Lectura incompleta: no se puede confiar en la alineación
+            resetFifo();
+            break;
+        }
+
+        for (size_t i = 0; i < chunk; i++) {
+            const uint8_t* p = buffer + i * MPU6050_FIFO_SAMPLE_BYTES;
+            ImuSample& s = samples[done + i];
+            s.accel[0] = readBE16(p + 0);
+            s.accel[1] = readBE16(p + 2);
+            s.accel[2] = readBE16(p + 4);
+            s.gyro[0] = readBE16(p + 6);
+            s.gyro[1] = readBE16(p + 8);
+            s.gyro[2] = readBE16(p + 10);
+        }
+        done += chunk;
+    }
+    if (done == 0) return 0;
+
+    // Las muestras están separadas exactamente un periodo del reloj del sensor.
+    // La más reciente del FIFO corresponde al último flanco de INT; se mantiene
+    // la continuidad y sólo se reancla si la deriva supera un periodo.
+    uint32_t newestUs = anchorUs - (uint32_t)(available - done) * samplePeriodUs;
+    uint32_t predictedUs = lastSampleUs + (uint32_t)done * samplePeriodUs;
+    int32_t drift = (int32_t)(predictedUs - newestUs);
+    if (!timestampValid || (anchorUs != 0 &&
+        (drift > (int32_t)samplePeriodUs || drift < -(int32_t)samplePeriodUs))) {
+        predictedUs = newestUs;
+    }
+    for (size_t i = 0; i < done; i++) {
+        samples[i].timestampUs = predictedUs - (uint32_t)(done - 1 - i) * samplePeriodUs;
+    }
+    lastSampleUs = predictedUs;
+    timestampValid = true;
+
+    // Descontar las muestras consumidas sin bajar de cero
+    uint32_t pending = pendingCount.load(std::memory_order_acquire);
+    uint32_t remaining;
+    do {
+        remaining = pending > done ? pending - (uint32_t)done : 0;
+    } while (!pendingCount.compare_exchange_weak(pending, remaining,
+                                                 std::memory_order_acq_rel));
+
+    return done;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#include "MahonyAHRS.h"
+#include "FastMath.h"
+#include <math.h>
+
+MahonyAHRS::MahonyAHRS(float kp, float ki)
+    : twoKp(2.0f * kp),
+      twoKi(2.0f * ki) {
+    reset();
+}
+
+void MahonyAHRS::reset() {
+    q0 = 1.0f;
+    q1 = q2 = q3 = 0.0f;
+    integralX = integralY = integralZ = 0.0f;
+    initialized = false;
+}
+
+void MahonyAHRS::initFromAccel(float ax, float ay, float az) {
+    // Arrancar con roll y pitch del acelerómetro para no esperar a que converja
+    float roll = fastAtan2(ay, az);
+    float pitch = fastAtan2(-ax, fastSqrt(ay * ay + az * az));
+
+    float cr = cosf(roll * 0.5f), sr = sinf(roll * 0.5f);
+    float cp = cosf(pitch * 0.5f), sp = sinf(pitch * 0.5f);
+    q0 = cr * cp;
+    q1 = sr * cp;
+    q2 = cr * sp;
+    q3 = -sr * sp;
+    initialized = true;
+}
+
+void MahonyAHRS::update(float gx, float gy, float gz, float ax, float ay, float az, float dt) {
+    float accelNormSq = ax * ax + ay * ay + az * az;
+
+    if (accelNormSq > 0.0f) {
+        if (!initialized) initFromAccel(ax, ay, az);
+
+        float recipNorm = fastInvSqrt(accelNormSq);
+        ax *= recipNorm;
+        ay *= recipNorm;
+        az *= recipNorm;
+
+        // Dirección estimada de la gravedad (mitad)
+        float halfVx = q1 * q3 - q0 * q2;
+        float halfVy = q0 * q1 + q2 * q3;
+        float halfVz = q0 * q0 - 0.5f + q3 * q3;
+
+        // Error: producto vectorial entre gravedad medida y estimada
+        float halfEx = ay * halfVz - az * halfVy;
+        float halfEy = az * halfVx - ax * halfVz;
+        float halfEz = ax * halfVy - ay * halfVx;
+
+        if (twoKi > 0.0f) {
+            integralX += twoKi * halfEx * dt;
+            integralY += twoKi * halfEy * dt;
+            integralZ += twoKi * halfEz * dt;
+            gx += integralX;
+            gy += integralY;
+            gz += integralZ;
+        }
+
+        gx += twoKp * halfEx;
+        gy += twoKp * halfEy;
+        gz += twoKp * halfEz;
+    }
+
+    // Integrar la derivada del cuaternión
+    gx *= 0.5f * dt;
+    gy *= 0.5f * dt;
+    gz *= 0.5f * dt;
+    float qa = q0, qb = q1, qc = q2;
+    q0 += -qb * gx - qc * gy - q3 * gz;
+    q1 += qa * gx + qc * gz - q3 * gy;
+    q2 += qa * gy - qb * gz + q3 * gx;
+    q3 += qa * gz + qb * gy - qc * gx;
+
+    float recipNorm = fastInvSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
+    q0 *= recipNorm;
+    q1 *= recipNorm;
+    q2 *= recipNorm;
+    q3 *= recipNorm;
+}
+
+float MahonyAHRS::getRoll() const {
+    return fastAtan2(q0 * q1 + q2 * q3, 0.5f - q1 * q1 - q2 * q2) * RAD_TO_DEG_F;
+}
+
+float MahonyAHRS::getPitch() const {
+    return fastAsin(-2.0f * (q1 * q3 - q0 * q2)) * RAD_TO_DEG_F;
+}
+
+float MahonyAHRS::getYaw() const {
+    float yaw = fastAtan2(q1 * q2 + q0 * q3, 0.5f - q2 * q2 - q3 * q3) * RAD_TO_DEG_F;
+    return yaw < 0.0f ? yaw + 360.0f : yaw;
+}
@@ -0,0 +1,124 @@
+#include "Mixer.h"
+
+// Motores numerados en sentido horario desde el delantero derecho (o el
+// delantero en las configuraciones +). El primero gira en sentido antihorario.
+static const MixerRule QUAD_X_RULES[] = {
+    {  1.0f, -1.0f, -1.0f },  // Delantero derecho (CCW)
+    {  1.0f,  1.0f,  1.0f },  // Trasero derecho (CW)
+    { -1.0f,  1.0f, -1.0f },  // Trasero izquierdo (CCW)
+    { -1.0f, -1.0f,  1.0f },  // Delantero izquierdo (CW)
+};
+
+static const MixerRule QUAD_PLUS_RULES[] = {
+    {  0.0f, -1.0f, -1.0f },  // Delantero (CCW)
+    {  1.0f,  0.0f,  1.0f },  // Derecho (CW)
+    {  0.0f,  1.0f, -1.0f },  // Trasero (CCW)
+    { -1.0f,  0.0f,  1.0f },  // Izquierdo (CW)
+};
+
+// Hexa X: motores a 30° + 60°·n
+static const MixerRule HEX_X_RULES[] = {
+    {  0.5f, -0.866025f, -1.0f },  // Delantero derecho (CCW)
+    {  1.0f,  0.0f,       1.0f },  // Derecho (CW)
+    {  0.5f,  0.866025f, -1.0f },  // Trasero derecho (CCW)
+    { -0.5f,  0.866025f,  1.0f },  // Trasero izquierdo (CW)
+    { -1.0f,  0.0f,      -1.0f },  // Izquierdo (CCW)
+    { -0.5f, -0.866025f,  1.0f },  // Delantero izquierdo (CW)
+};
+
+// Octo X: motores a 22.5° + 45°·n, normalizados a 1 en el brazo más largo
+static const MixerRule OCTO_X_RULES[] = {
+    {  0.414214f, -1.0f,      -1.0f },
+    {  1.0f,      -0.414214f,  1.0f },
+    {  1.0f,       0.414214f, -1.0f },
+    {  0.414214f,  1.0f,       1.0f },
+    { -0.414214f,  1.0f,      -1.0f },
+    { -1.0f,       0.414214f,  1.0f },
+    { -1.0f,      -0.414214f, -1.0f },
+    { -0.414214f, -1.0f,       1.0f },
+};
+
+Mixer::Mixer() : motorCount(0), airmode(false), saturated(false), saturationCount(0) {
+    setFrame(FRAME_QUAD_X);
+}
+
+bool Mixer::setFrame(int frameType) {
+    switch (frameType) {
+        case FRAME_QUAD_X:
+            return setRules(QUAD_X_RULES, sizeof(QUAD_X_RULES) / sizeof(QUAD_X_RULES[0]));
+        case FRAME_QUAD_PLUS:
+            return setRules(QUAD_PLUS_RULES, sizeof(QUAD_PLUS_RULES) / sizeof(QUAD_PLUS_RULES[0]));
+        case FRAME_HEX_X:
+            return setRules(HEX_X_RULES, sizeof(HEX_X_RULES) / sizeof(HEX_X_RULES[0]));
+        case FRAME_OCTO_X:
+            return setRules(OCTO_X_RULES, sizeof(OCTO_X_RULES) / sizeof(OCTO_X_RULES[0]));
+        default:
+            return false;
+    }
+}
+
+bool Mixer::setRules(const MixerRule* rules, int count) {
+    if (count <= 0 || count > MIXER_MAX_MOTORS) return false;
+
+    for (int i = 0; i < count; i++) {
+        rollGain[i] = rules[i].roll;
+        pitchGain[i] = rules[i].pitch;
+        yawGain[i] = rules[i].yaw;
+    }
+    motorCount = count;
+    return true;
+}
+
+void Mixer::mix(float throttle, float roll, float pitch, float yaw, float* outputs) {
+    if (throttle < 0.0f) throttle = 0.0f;
+    if (throttle > 1.0f) throttle = 1.0f;
+
+    // Producto matriz-vector y extremos de las correcciones en una pasada
+    float minCorrection = 0.0f;
+    float maxCorrection = 0.0f;
+    for (int i = 0; i < motorCount; i++) {
+        float correction = roll * rollGain[i] + pitch * pitchGain[i] + yaw * yawGain[i];
+        outputs[i] = correction;
+        if (correction < minCorrection) minCorrection = correction;
+        if (correction > maxCorrection) maxCorrection = correction;
+    }
+
+    saturated = false;
+
+    // Correcciones más amplias que todo el rango: escalarlas conservando la proporción entre ejes
+    float range = maxCorrection - minCorrection;
+    if (range > 1.0f) {
+        float scale = 1.0f / range;
+        for (int i = 0; i < motorCount; i++) {
+            outputs[i] *= scale;
+        }
+        minCorrection *= scale;
+        maxCorrection *= scale;
+        saturated = true;
+    }
+
+    // Bajar el throttle para que el motor más cargado no pase de 1
+    if (throttle + maxCorrection > 1.0f) {
+        throttle = 1.0f - maxCorrection;
+        saturated = true;
+    }
+
+    // Con airmode subirlo para que el menos cargado no baje de 0; sin él se recorta
+    if (throttle + minCorrection < 0.0f) {
+        if (airmode) {
+            throttle = -minCorrection;
+        }
+        saturated = true;
+    }
+
+    for (int i = 0; i < motorCount; i++) {
+        float output = throttle + outputs[i];
+        if (output < 0.0f) output = 0.0f;
+        else if (output > 1.0f) output = 1.0f;
+        outputs[i] = output;
+    }
+
+    if (saturated) {
+        saturationCount++;
+    }
+}
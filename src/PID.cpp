@@ -1,21 +1,32 @@
 #include "PID.h"
 
-float PIDController::compute(float setpoint, float input, float dt) {
+float PIDController::compute(float setpoint, float input, float dt, float feedforwardReference) {
     float error = setpoint - input;
     
     // Término proporcional
-    float pTerm = kp * error;
+    pTerm = kp * error;
     
     // Término integral
     integral += error * dt;
-    float iTerm = ki * integral;
+    iTerm = ki * integral;
+    
+    // Derivadas respecto a la muestra anterior (cero en la primera tras reset)
+    float derivative = 0.0f;
+    float referenceRate = 0.0f;
+    if (hasHistory) {
+        derivative = derivativeOnMeasurement ? -(input - lastInput) / dt
+                                             : (error - lastError) / dt;
+        referenceRate = (feedforwardReference - lastReference) / dt;
+    }
     
     // Término derivativo
-    float derivative = (error - lastError) / dt;
-    float dTerm = kd * derivative;
+    dTerm = kd * dTermFilter.apply(derivative);
+    
+    // Feedforward: actúa en cuanto se mueve la consigna, sin esperar al error
+    fTerm = kf * feedforwardFilter.apply(referenceRate);
     
     // Calcular salida
-    float output = pTerm + iTerm + dTerm;
+    float output = pTerm + iTerm + dTerm + fTerm;
     
     // Limitar salida
     if (output > maxOutput) output = maxOutput;
@@ -27,6 +38,9 @@ float PIDController::compute(float setpoint, float input, float dt) {
     }
     
     lastError = error;
+    lastReference = feedforwardReference;
+    lastInput = input;
+    hasHistory = true;
     
     return output;
 }
@@ -34,6 +48,10 @@ float PIDController::compute(float setpoint, float input, float dt) {
 void PIDController::reset() {
     integral = 0;
     lastError = 0;
+    hasHistory = false;
+    pTerm = iTerm = dTerm = fTerm = 0;
+    dTermFilter.reset();
+    feedforwardFilter.reset();
 }
 
 void PIDController::setTunings(float p, float i, float d) {
@@ -44,4 +62,12 @@ void PIDController::setTunings(float p, float i, float d) {
 
 void PIDController::setOutputLimits(float maxOut) {
     maxOutput = maxOut;
+}
+
+void PIDController::setDerivativeFilter(float cutoffHz, float sampleRateHz) {
+    dTermFilter.setLowpass(cutoffHz, sampleRateHz);
+}
+
+void PIDController::setFeedforwardFilter(float cutoffHz, float sampleRateHz) {
+    feedforwardFilter.setLowpass(cutoffHz, sampleRateHz);
 }
\ No newline at end of file
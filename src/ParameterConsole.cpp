@@ -0,0 +1,100 @@
+#include "ParameterConsole.h"
+#include <stdlib.h>
+#include <string.h>
+
+ParameterConsole::ParameterConsole(ParameterRegistry& parameterRegistry, ParameterStore& parameterStore)
+    : registry(parameterRegistry),
+      store(parameterStore),
+      length(0),
+      collecting(false),
+      changed(false) {
+    line[0] = '\0';
+}
+
+bool ParameterConsole::processKey(char key, bool armed) {
+    if (!collecting) {
+        if (key != '$') return false;
+        collecting = true;
+        length = 0;
+        return true;
+    }
+
+    if (key == '\r' || key == '\n') {
+        line[length] = '\0';
+        collecting = false;
+        execute(armed);
+    } else if (key == '\b' || key == 0x7F) {
+        if (length > 0) length--;
+    } else if (length < PARAMETER_LINE_LENGTH - 1) {
+        line[length++] = key;
+    }
+    return true;
+}
+
+bool ParameterConsole::takeChanged() {
+    bool result = changed;
+    changed = false;
+    return result;
+}
+
+void ParameterConsole::printParameter(int id) {
+    const ParameterDescriptor& descriptor = ParameterRegistry::getDescriptor(id);
+    if (descriptor.type == PARAMETER_INT) {
+        Serial.printf("%s = %ld\n", descriptor.name, (long)registry.get(id));
+    } else {
+        Serial.printf("%s = %.4g\n", descriptor.name, registry.get(id));
+    }
+}
+
+void ParameterConsole::execute(bool armed) {
+    char* context = nullptr;
+    const char* command = strtok_r(line, " \t", &context);
+    const char* name = strtok_r(nullptr, " \t", &context);
+    const char* valueText = strtok_r(nullptr, " \t", &context);
+    if (command == nullptr) return;
+
+    if (strcmp(command, "list") == 0) {
+        for (int id = 0; id < ParameterRegistry::getCount(); id++) {
+            printParameter(id);
+        }
+    } else if (strcmp(command, "get") == 0) {
+        int id = name ? ParameterRegistry::find(name) : -1;
+        if (id < 0) {
+            Serial.printf("ERROR: Parámetro desconocido: %s\n", name ? name : "");
+            return;
+        }
+        printParameter(id);
+    } else if (strcmp(command, "set") == 0) {
+        char* end = nullptr;
+        float value = valueText ? strtof(valueText, &end) : 0.0f;
+        if (valueText == nullptr || end == valueText || *end != '\0') {
+            Serial.println("ERROR: Uso: $set <nombre> <valor>");
+            return;
+        }
+        int id = name ? ParameterRegistry::find(name) : -1;
+        ParameterStatus status = registry.set(id, value);
+        if (status == PARAMETER_UNKNOWN) {
+            Serial.printf("ERROR: Parámetro desconocido: %s\n", name ? name : "");
+        } else if (status == PARAMETER_OUT_OF_RANGE) {
+            const ParameterDescriptor& descriptor = ParameterRegistry::getDescriptor(id);
+            Serial.printf("ERROR: %s fuera de rango [%.4g, %.4g]\n",
+                          descriptor.name, descriptor.minValue, descriptor.maxValue);
+        } else {
+            changed = true;
+            printParameter(id);
+        }
+    } else if (strcmp(command, "save") == 0) {
+        // Escribir en NVS detiene la caché de la flash: sólo en tierra
+        if (armed) {
+            Serial.println("ERROR: Guardar parámetros sólo con los motores desarmados");
+        } else {
+            Serial.println(store.save(registry) ? "Parámetros guardados" : "ERROR al guardar los parámetros");
+        }
+    } else if (strcmp(command, "defaults") == 0) {
+        registry.resetToDefaults();
+        changed = true;
+        Serial.println("Parámetros por defecto (usa $save para guardarlos)");
+    } else {
+        Serial.println("Órdenes: $list, $get <nombre>, $set <nombre> <valor>, $save, $defaults");
+    }
+}
@@ -0,0 +1,45 @@
+#include "ParameterStore.h"
+#include <Preferences.h>
+
+int ParameterStore::load(ParameterRegistry& registry) {
+    Preferences preferences;
+    if (!preferences.begin(nvsNamespace, true)) return 0;
+
+    int loaded = 0;
+    for (int id = 0; id < ParameterRegistry::getCount(); id++) {
+        const ParameterDescriptor& descriptor = ParameterRegistry::getDescriptor(id);
+        if (!preferences.isKey(descriptor.name)) continue;
+
+        float value = descriptor.type == PARAMETER_INT
+            ? (float)preferences.getInt(descriptor.name, (int32_t)registry.get(id))
+            : preferences.getFloat(descriptor.name, registry.get(id));
+        if (registry.set(id, value) == PARAMETER_OK) loaded++;
+    }
+    preferences.end();
+    return loaded;
+}
+
+bool ParameterStore::save(const ParameterRegistry& registry) {
+    Preferences preferences;
+    if (!preferences.begin(nvsNamespace, false)) return false;
+
+    bool saved = true;
+    for (int id = 0; id < ParameterRegistry::getCount(); id++) {
+        const ParameterDescriptor& descriptor = ParameterRegistry::getDescriptor(id);
+        if (descriptor.type == PARAMETER_INT) {
+            saved &= preferences.putInt(descriptor.name, (int32_t)registry.get(id)) == sizeof(int32_t);
+        } else {
+            saved &= preferences.putFloat(descriptor.name, registry.get(id)) == sizeof(float);
+        }
+    }
+    preferences.end();
+    return saved;
+}
+
+bool ParameterStore::clear() {
+    Preferences preferences;
+    if (!preferences.begin(nvsNamespace, false)) return false;
+    bool cleared = preferences.clear();
+    preferences.end();
+    return cleared;
+}
@@ -0,0 +1,70 @@
+#include "Parameters.h"
+#include <string.h>
+
+template <typename T> struct ParameterTypeOf;
+template <> struct ParameterTypeOf<float> { static const ParameterType value = PARAMETER_FLOAT; };
+template <> struct ParameterTypeOf<int32_t> { static const ParameterType value = PARAMETER_INT; };
+
+#define PARAMETER_DESCRIPTOR(field, name, type, initial, min, max) \
+    { name, ParameterTypeOf<type>::value, offsetof(FlightParameters, field), \
+      (float)(min), (float)(max) },
+static const ParameterDescriptor descriptors[PARAMETER_COUNT] = {
+    PARAMETER_LIST(PARAMETER_DESCRIPTOR)
+};
+#undef PARAMETER_DESCRIPTOR
+
+ParameterRegistry::ParameterRegistry(const FlightParameters& defaults)
+    : defaultValues(defaults),
+      values(defaults),
+      revision(0) {
+}
+
+const ParameterDescriptor& ParameterRegistry::getDescriptor(int id) {
+    return descriptors[id];
+}
+
+int ParameterRegistry::find(const char* name) {
+    for (int id = 0; id < PARAMETER_COUNT; id++) {
+        if (strcmp(descriptors[id].name, name) == 0) return id;
+    }
+    return -1;
+}
+
+float ParameterRegistry::get(int id) const {
+    const ParameterDescriptor& descriptor = descriptors[id];
+    const uint8_t* field = (const uint8_t*)&values + descriptor.offset;
+    if (descriptor.type == PARAMETER_INT) {
+        int32_t value;
+        memcpy(&value, field, sizeof(value));
+        return (float)value;
+    }
+    float value;
+    memcpy(&value, field, sizeof(value));
+    return value;
+}
+
+ParameterStatus ParameterRegistry::set(int id, float value) {
+    if (id < 0 || id >= PARAMETER_COUNT) return PARAMETER_UNKNOWN;
+
+    const ParameterDescriptor& descriptor = descriptors[id];
+    if (!(value >= descriptor.minValue && value <= descriptor.maxValue)) return PARAMETER_OUT_OF_RANGE;
+
+    uint8_t* field = (uint8_t*)&values + descriptor.offset;
+    if (descriptor.type == PARAMETER_INT) {
+        int32_t integer = (int32_t)(value >= 0 ? value + 0.5f : value - 0.5f);
+        memcpy(field, &integer, sizeof(integer));
+    } else {
+        memcpy(field, &value, sizeof(value));
+    }
+    revision++;
+    return PARAMETER_OK;
+}
+
+ParameterStatus ParameterRegistry::set(const char* name, float value) {
+    return set(find(name), value);
+}
+
+void ParameterRegistry::resetToDefaults() {
+    values = defaultValues;
+    revision++;
+}
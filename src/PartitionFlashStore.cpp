@@ -0,0 +1,25 @@
+#include "PartitionFlashStore.h"
+
+bool PartitionFlashStore::begin(const char* label) {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    return partition != nullptr;
+}
+
+size_t PartitionFlashStore::size() const {
+    return partition ? partition->size : 0;
+}
+
+bool PartitionFlashStore::read(size_t offset, uint8_t* data, size_t length) {
+    if (partition == nullptr) return false;
+    return esp_partition_read(partition, offset, data, length) == ESP_OK;
+}
+
+bool PartitionFlashStore::write(size_t offset, const uint8_t* data, size_t length) {
+    if (partition == nullptr) return false;
+    return esp_partition_write(partition, offset, data, length) == ESP_OK;
+}
+
+bool PartitionFlashStore::eraseSector(size_t offset) {
+    if (partition == nullptr) return false;
+    return esp_partition_erase_range(partition, offset, SPI_FLASH_SEC_SIZE) == ESP_OK;
+}
@@ -0,0 +1,95 @@
+#include "Profiler.h"
+
+#if ENABLE_PROFILER
+
+static const char* const STAGE_NAMES[PROFILE_STAGE_COUNT] = {
+    "readSensors",
+    "dynamicNotch",
+    "calculateAngles",
+    "armLogic",
+    "computePID",
+    "updateMotors",
+    "controlLoop",
+    "input",
+    "status",
+};
+
+Profiler profiler;
+
+Profiler::Profiler() : overrunCycles(0) {
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        clear(stats[i]);
+        resetPending[i].store(false, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::clear(ProfileStats& s) {
+    memset(&s, 0, sizeof(s));
+    s.minCycles = UINT32_MAX;
+}
+
+void Profiler::record(ProfileStage stage, uint32_t elapsedCycles) {
+    ProfileStats& s = stats[stage];
+
+    // El reinicio lo aplica el propio escritor de la etapa
+    if (resetPending[stage].load(std::memory_order_relaxed)) {
+        clear(s);
+        resetPending[stage].store(false, std::memory_order_relaxed);
+    }
+
+    s.count++;
+    s.totalCycles += elapsedCycles;
+    if (elapsedCycles < s.minCycles) s.minCycles = elapsedCycles;
+    if (elapsedCycles > s.maxCycles) s.maxCycles = elapsedCycles;
+
+    int bucket = elapsedCycles ? 32 - __builtin_clz(elapsedCycles) : 0;
+    if (bucket >= PROFILER_BUCKETS) bucket = PROFILER_BUCKETS - 1;
+    s.histogram[bucket]++;
+
+    if (stage == PROFILE_CONTROL_LOOP) {
+        if (overrunCycles == 0) {
+            overrunCycles = (uint32_t)LOOP_TIME_US * ESP.getCpuFreqMHz();
+        }
+        if (elapsedCycles > overrunCycles) s.overruns++;
+    }
+}
+
+void Profiler::report(HardwareSerial& port) {
+    float cyclesPerUs = ESP.getCpuFreqMHz();
+
+    port.println("\n--- PERFIL DEL LOOP (us) ---");
+    port.println("etapa            n        min      media    max      excesos");
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        ProfileStats s = stats[i];  // Copia: el escritor puede seguir actualizando
+        if (s.count == 0) {
+            port.printf("%-16s sin datos\n", STAGE_NAMES[i]);
+            continue;
+        }
+        port.printf("%-16s %-8lu %-8.1f %-8.1f %-8.1f %lu\n",
+                    STAGE_NAMES[i], (unsigned long)s.count,
+                    s.minCycles / cyclesPerUs,
+                    (float)s.totalCycles / s.count / cyclesPerUs,
+                    s.maxCycles / cyclesPerUs,
+                    (unsigned long)s.overruns);
+
+        // Histograma: sólo los cubos con muestras, límite superior en us
+        port.print("  hist:");
+        for (int b = 0; b < PROFILER_BUCKETS; b++) {
+            if (s.histogram[b] == 0) continue;
+            port.printf(" <%.1f:%lu", (float)(1UL << b) / cyclesPerUs,
+                        (unsigned long)s.histogram[b]);
+        }
+        port.println();
+    }
+    port.println("----------------------------");
+
+    reset();
+}
+
+void Profiler::reset() {
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        resetPending[i].store(true, std::memory_order_relaxed);
+    }
+}
+
+#endif
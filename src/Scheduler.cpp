@@ -0,0 +1,103 @@
+#include "Scheduler.h"
+#include <string.h>
+
+Scheduler::Scheduler(SchedulerClock clockSource, uint32_t tickPeriod)
+    : taskCount(0),
+      clock(clockSource),
+      tickPeriodUs(tickPeriod),
+      nextTickUs(0),
+      tickCount(0),
+      started(false) {
+    memset(tasks, 0, sizeof(tasks));
+}
+
+int Scheduler::addTask(const char* name, SchedulerCallback callback, void* context,
+                       uint32_t periodUs, uint8_t priority, uint32_t budgetUs) {
+    if (taskCount >= SCHEDULER_MAX_TASKS || callback == nullptr) return -1;
+
+    // Mantener la tabla ordenada por prioridad (inserción estable)
+    int index = taskCount;
+    while (index > 0 && tasks[index - 1].priority > priority) {
+        tasks[index] = tasks[index - 1];
+        index--;
+    }
+
+    SchedulerTask& task = tasks[index];
+    memset(&task, 0, sizeof(task));
+    task.name = name;
+    task.callback = callback;
+    task.context = context;
+    task.periodUs = periodUs;
+    task.priority = priority;
+    task.budgetUs = budgetUs;
+    task.nextRunUs = clock();
+
+    taskCount++;
+    return index;
+}
+
+bool Scheduler::poll() {
+    uint32_t now = clock();
+    if (!started) {
+        nextTickUs = now;
+        started = true;
+    }
+    if ((int32_t)(now - nextTickUs) < 0) return false;
+
+    // Si se perdieron ticks enteros no se recuperan en ráfaga
+    nextTickUs += tickPeriodUs;
+    if ((int32_t)(now - nextTickUs) >= 0) {
+        nextTickUs = now + tickPeriodUs;
+    }
+
+    runTick(now);
+    return true;
+}
+
+void Scheduler::runTick(uint32_t tickStartUs) {
+    uint32_t deadline = tickStartUs + tickPeriodUs;
+    tickCount++;
+
+    for (int i = 0; i < taskCount; i++) {
+        SchedulerTask& task = tasks[i];
+        uint32_t now = clock();
+
+        bool critical = task.priority == SCHEDULER_PRIORITY_CRITICAL || task.periodUs == 0;
+        if (!critical && (int32_t)(now - task.nextRunUs) < 0) continue;
+
+        // Aplazar si no cabe en lo que queda del tick
+        if (!critical && (int32_t)(deadline - now) < (int32_t)task.budgetUs) {
+            task.deferCount++;
+            if ((int32_t)(now - task.nextRunUs) >= (int32_t)task.periodUs) {
+                // Lleva un periodo entero esperando: se da por perdido
+                task.skipCount++;
+                task.nextRunUs += task.periodUs;
+            }
+            continue;
+        }
+
+        task.callback(task.context);
+
+        uint32_t duration = clock() - now;
+        task.runCount++;
+        if (duration > task.maxDurationUs) task.maxDurationUs = duration;
+        if (task.budgetUs && duration > task.budgetUs) task.overrunCount++;
+
+        if (task.periodUs) {
+            task.nextRunUs += task.periodUs;
+            if ((int32_t)(now - task.nextRunUs) >= 0) {
+                task.nextRunUs = now + task.periodUs;
+            }
+        }
+    }
+}
+
+void Scheduler::resetStats() {
+    for (int i = 0; i < taskCount; i++) {
+        tasks[i].runCount = 0;
+        tasks[i].overrunCount = 0;
+        tasks[i].deferCount = 0;
+        tasks[i].skipCount = 0;
+        tasks[i].maxDurationUs = 0;
+    }
+}
@@ -0,0 +1,127 @@
+#include "SpectrumAnalyzer.h"
+#include <math.h>
+#include <string.h>
+#include "FastMath.h"
+
+// Amortiguamiento de la SDFT: los errores de redondeo se olvidan en vez de acumularse
+static const float SDFT_DAMPING = 0.9999f;
+
+SpectrumAnalyzer::SpectrumAnalyzer() {
+    init(DYN_NOTCH_SDFT_SIZE, 0.0f, 0.0f, 0, 1.0f, 1.0f);
+}
+
+void SpectrumAnalyzer::init(float sampleRateHz, float minHz, float maxHz, int peaks,
+                            float peakThreshold, float peakSmoothing) {
+    memset(history, 0, sizeof(history));
+    memset(binRe, 0, sizeof(binRe));
+    memset(binIm, 0, sizeof(binIm));
+    memset(peakHz, 0, sizeof(peakHz));
+    historyIndex = 0;
+    nextAxis = 0;
+    peakCount = peaks < 0 ? 0 : peaks > SPECTRUM_MAX_PEAKS ? SPECTRUM_MAX_PEAKS : peaks;
+    threshold = peakThreshold;
+    smoothing = peakSmoothing;
+
+    binWidth = sampleRateHz / DYN_NOTCH_SDFT_SIZE;
+    int lowBin = (int)(minHz / binWidth);
+    int highBin = (int)(maxHz / binWidth + 0.5f);
+    if (lowBin < 2) lowBin = 2;
+    if (highBin > DYN_NOTCH_SDFT_SIZE / 2 - 1) highBin = DYN_NOTCH_SDFT_SIZE / 2 - 1;
+    firstBin = lowBin - 1;
+    binCount = highBin >= lowBin ? highBin - lowBin + 3 : 0;
+
+    for (int i = 0; i < binCount; i++) {
+        float omega = 2.0f * FAST_PI * (firstBin + i) / DYN_NOTCH_SDFT_SIZE;
+        twiddleRe[i] = SDFT_DAMPING * cosf(omega);
+        twiddleIm[i] = SDFT_DAMPING * sinf(omega);
+    }
+    dampingN = powf(SDFT_DAMPING, DYN_NOTCH_SDFT_SIZE);
+}
+
+void SpectrumAnalyzer::addSample(const float values[FILTER_AXES]) {
+    for (int axis = 0; axis < FILTER_AXES; axis++) {
+        // X_k = r·W^k·(X_k + x(n) - r^N·x(n-N))
+        float delta = values[axis] - dampingN * history[axis][historyIndex];
+        history[axis][historyIndex] = values[axis];
+
+        float* re = binRe[axis];
+        float* im = binIm[axis];
+        for (int i = 0; i < binCount; i++) {
+            float r = re[i] + delta;
+            float m = im[i];
+            re[i] = r * twiddleRe[i] - m * twiddleIm[i];
+            im[i] = r * twiddleIm[i] + m * twiddleRe[i];
+        }
+    }
+    historyIndex = (historyIndex + 1) & (DYN_NOTCH_SDFT_SIZE - 1);
+}
+
+int SpectrumAnalyzer::step() {
+    if (binCount == 0 || peakCount == 0) return -1;
+    int axis = nextAxis;
+    nextAxis = (nextAxis + 1) % FILTER_AXES;
+
+    // Magnitudes con ventana de Hann aplicada en frecuencia:
+    // H_k = 0.5·X_k - 0.25·(X_k-1 + X_k+1)
+    const float* re = binRe[axis];
+    const float* im = binIm[axis];
+    float magnitude[SPECTRUM_MAX_BINS];
+    int count = binCount - 2;
+    float sum = 0.0f;
+    for (int i = 0; i < count; i++) {
+        float hr = 0.5f * re[i + 1] - 0.25f * (re[i] + re[i + 2]);
+        float hi = 0.5f * im[i + 1] - 0.25f * (im[i] + im[i + 2]);
+        magnitude[i] = fastSqrt(hr * hr + hi * hi);
+        sum += magnitude[i];
+    }
+    float minMagnitude = threshold * sum / count;
+
+    // Máximos locales más altos que destacan sobre la media del rango
+    float found[SPECTRUM_MAX_PEAKS];
+    float foundMagnitude[SPECTRUM_MAX_PEAKS];
+    int foundCount = 0;
+    for (int i = 0; i < count; i++) {
+        float m = magnitude[i];
+        if (m <= minMagnitude) continue;
+        if ((i > 0 && magnitude[i - 1] > m) || (i + 1 < count && magnitude[i + 1] >= m)) continue;
+
+        // Interpolación parabólica entre bins vecinos
+        float offset = 0.0f;
+        if (i > 0 && i + 1 < count) {
+            float left = magnitude[i - 1];
+            float right = magnitude[i + 1];
+            float denominator = left - 2.0f * m + right;
+            if (denominator < 0.0f) offset = 0.5f * (left - right) / denominator;
+        }
+        float hz = (firstBin + 1 + i + offset) * binWidth;
+
+        // Insertar conservando los `peakCount` de mayor magnitud
+        int slot = foundCount < peakCount ? foundCount++ : peakCount;
+        while (slot > 0 && foundMagnitude[slot - 1] < m) {
+            if (slot < peakCount) {
+                found[slot] = found[slot - 1];
+                foundMagnitude[slot] = foundMagnitude[slot - 1];
+            }
+            slot--;
+        }
+        if (slot < peakCount) {
+            found[slot] = hz;
+            foundMagnitude[slot] = m;
+        }
+    }
+    if (foundCount == 0) return axis;  // Sin picos claros: conservar los anteriores
+
+    // Ordenar por frecuencia para que cada muesca siga siempre al mismo pico
+    for (int i = 1; i < foundCount; i++) {
+        for (int j = i; j > 0 && found[j - 1] > found[j]; j--) {
+            float hz = found[j];
+            found[j] = found[j - 1];
+            found[j - 1] = hz;
+        }
+    }
+    for (int p = 0; p < foundCount; p++) {
+        float& tracked = peakHz[axis][p];
+        tracked = tracked > 0.0f ? tracked + smoothing * (found[p] - tracked) : found[p];
+    }
+    return axis;
+}
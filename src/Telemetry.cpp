@@ -0,0 +1,86 @@
+#include "Telemetry.h"
+
+static int16_t toFixed(float value, float scale) {
+    float scaled = value * scale;
+    if (scaled > 32767.0f) return 32767;
+    if (scaled < -32768.0f) return -32768;
+    return (int16_t)lroundf(scaled);
+}
+
+Telemetry::Telemetry()
+    : enabled(false),
+      droppedFrames(0),
+      sequence(0) {
+}
+
+void Telemetry::setEnabled(bool enable) {
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+void Telemetry::sample(const FlightController& controller, uint32_t timestampUs, uint32_t loopTimeUs) {
+    if (!isEnabled()) return;
+
+    FlightData data = controller.getFlightData();
+    ControlInputs inputs = controller.getInputs();
+    const PIDController* pids[3] = {
+        &controller.getRollPID(), &controller.getPitchPID(), &controller.getYawPID()
+    };
+    const int* motors = controller.getMotorOutputs();
+
+    TelemetryFrame frame;
+    frame.type = TELEMETRY_FRAME_STATE;
+    frame.sequence = sequence++;
+    frame.timestampUs = timestampUs;
+    frame.loopTimeUs = loopTimeUs > 0xFFFF ? 0xFFFF : loopTimeUs;
+
+    frame.attitude[0] = toFixed(data.roll, 100.0f);
+    frame.attitude[1] = toFixed(data.pitch, 100.0f);
+    frame.attitude[2] = toFixed(data.yaw > 180.0f ? data.yaw - 360.0f : data.yaw, 100.0f);
+    frame.rates[0] = toFixed(data.rollRate, 10.0f);
+    frame.rates[1] = toFixed(data.pitchRate, 10.0f);
+    frame.rates[2] = toFixed(data.yawRate, 10.0f);
+    frame.accel[0] = toFixed(data.accelX, 100.0f);
+    frame.accel[1] = toFixed(data.accelY, 100.0f);
+    frame.accel[2] = toFixed(data.accelZ, 100.0f);
+
+    frame.inputs[0] = toFixed(inputs.throttle, 10.0f);
+    frame.inputs[1] = toFixed(inputs.rollCmd, 10.0f);
+    frame.inputs[2] = toFixed(inputs.pitchCmd, 10.0f);
+    frame.inputs[3] = toFixed(inputs.yawCmd, 10.0f);
+
+    for (int axis = 0; axis < 3; axis++) {
+        frame.pid[axis][0] = toFixed(pids[axis]->getPTerm(), 10.0f);
+        frame.pid[axis][1] = toFixed(pids[axis]->getITerm(), 10.0f);
+        frame.pid[axis][2] = toFixed(pids[axis]->getDTerm(), 10.0f);
+    }
+    for (int i = 0; i < MIXER_MAX_MOTORS; i++) {
+        frame.motors[i] = i < FlightController::motorCount ? motors[i] : 0;
+    }
+
+    frame.flags = (data.armed ? 0x01 : 0) |
+                  (inputs.armCmd ? 0x02 : 0) |
+                  (inputs.disarmCmd ? 0x04 : 0) |
+                  (inputs.acroMode ? 0x08 : 0) |
+                  ((data.failsafe & 0x03) << 4);
+
+    uint8_t encoded[COBS_MAX_ENCODED(sizeof(TelemetryFrame) + FRAME_CRC_BYTES) + 1];
+    size_t length = encodeFrame((const uint8_t*)&frame, sizeof(frame), encoded);
+    if (!txRing.push(encoded, length)) {
+        droppedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+size_t Telemetry::flush(HardwareSerial& port) {
+    uint8_t chunk[64];
+    size_t total = 0;
+
+    int room = port.availableForWrite();
+    while (room > 0) {
+        size_t count = txRing.pop(chunk, (size_t)room < sizeof(chunk) ? (size_t)room : sizeof(chunk));
+        if (count == 0) break;
+        port.write(chunk, count);
+        total += count;
+        room -= count;
+    }
+    return total;
+}
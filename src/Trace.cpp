@@ -0,0 +1,81 @@
+#include "Trace.h"
+
+#if ENABLE_TRACE
+
+#define TRACE_NAME(id, name) name,
+static const char* const EVENT_NAMES[TRACE_EVENT_COUNT] = {
+    TRACE_EVENT_LIST(TRACE_NAME)
+};
+#undef TRACE_NAME
+
+// Espacio libre mínimo en la UART para escribir una línea de evento
+static const int TRACE_LINE_MAX = 48;
+
+Tracer tracer;
+
+Tracer::Tracer()
+    : recording(true),
+      nextCorrelation(1),
+      dumping(false),
+      dumpCore(0),
+      dumpIndex(0) {
+    for (int core = 0; core < TRACE_CORES; core++) {
+        buffers[core].head.store(0, std::memory_order_relaxed);
+        buffers[core].writing.store(false, std::memory_order_relaxed);
+        dumpEnd[core] = 0;
+    }
+}
+
+void Tracer::beginDump(HardwareSerial& port) {
+    if (dumping) return;
+    recording.store(false, std::memory_order_seq_cst);
+
+    // Esperar a un escritor que ya vio recording = true, aunque lo hayan
+    // expulsado a mitad del evento. El de este núcleo es esta misma tarea,
+    // así que la espera es sólo por el otro y dura lo que un record().
+    for (int core = 0; core < TRACE_CORES; core++) {
+        while (buffers[core].writing.load(std::memory_order_acquire)) {
+        }
+    }
+
+    dumping = true;
+    dumpCore = 0;
+    for (int core = 0; core < TRACE_CORES; core++) {
+        dumpEnd[core] = buffers[core].head.load(std::memory_order_acquire);
+    }
+    dumpIndex = dumpEnd[0] > TRACE_BUFFER_EVENTS ? dumpEnd[0] - TRACE_BUFFER_EVENTS : 0;
+
+    // Cabecera: frecuencia de la CPU para pasar de ciclos a tiempo
+    port.printf("TRACE_BEGIN cpu_mhz=%u cores=%d\n", (unsigned)ESP.getCpuFreqMHz(), TRACE_CORES);
+}
+
+bool Tracer::continueDump(HardwareSerial& port) {
+    if (!dumping) return true;
+
+    while (port.availableForWrite() >= TRACE_LINE_MAX) {
+        if (dumpIndex == dumpEnd[dumpCore]) {
+            if (++dumpCore >= TRACE_CORES) {
+                port.println("TRACE_END");
+                dumping = false;
+                for (int core = 0; core < TRACE_CORES; core++) {
+                    buffers[core].head.store(0, std::memory_order_relaxed);
+                }
+                recording.store(true, std::memory_order_release);
+                return true;
+            }
+            uint32_t end = dumpEnd[dumpCore];
+            dumpIndex = end > TRACE_BUFFER_EVENTS ? end - TRACE_BUFFER_EVENTS : 0;
+            continue;
+        }
+
+        // núcleo,ciclos,fase,nombre,correlación
+        const TraceEvent& event = buffers[dumpCore].events[dumpIndex & (TRACE_BUFFER_EVENTS - 1)];
+        port.printf("T,%d,%lu,%c,%s,%lu\n", dumpCore, (unsigned long)event.cycles, (char)event.phase,
+                    event.id < TRACE_EVENT_COUNT ? EVENT_NAMES[event.id] : "?",
+                    (unsigned long)event.correlation);
+        dumpIndex++;
+    }
+    return false;
+}
+
+#endif
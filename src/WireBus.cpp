@@ -0,0 +1,24 @@
+#include "WireBus.h"
+
+bool WireBus::writeRegister(uint8_t address, uint8_t reg, uint8_t value) {
+    wire.beginTransmission(address);
+    wire.write(reg);
+    wire.write(value);
+    return wire.endTransmission() == 0;
+}
+
+bool WireBus::readRegisters(uint8_t address, uint8_t reg, uint8_t* buffer, size_t length) {
+    if (length == 0 || length > MAX_READ_LENGTH) return false;
+    
+    // Escribir dirección de registro sin STOP y leer en ráfaga
+    wire.beginTransmission(address);
+    wire.write(reg);
+    if (wire.endTransmission(false) != 0) return false;
+    
+    if (wire.requestFrom((uint16_t)address, length, true) != length) return false;
+    
+    for (size_t i = 0; i < length; i++) {
+        buffer[i] = wire.read();
+    }
+    return true;
+}
@@ -1,100 +1,498 @@
 #include <Arduino.h>
+#include <atomic>
+#include <Wire.h>
+#include "Benchmark.h"
+#include "Blackbox.h"
+#include "CalibrationStore.h"
+#include "CommandParser.h"
+#include "EscOutput.h"
 #include "FlightController.h"
+#include "ImuSource.h"
 #include "KeyboardController.h"
+#include "LinkMonitor.h"
+#include "Log.h"
+#include "ParameterConsole.h"
+#include "ParameterStore.h"
+#include "Parameters.h"
+#include "PartitionFlashStore.h"
+#include "Profiler.h"
+#include "Scheduler.h"
+#include "SpscChannel.h"
+#include "StateBus.h"
+#include "Telemetry.h"
+#include "Trace.h"
+#include "WireBus.h"
 #include "config.h"
 
+static uint32_t systemClock() {
+    return micros();
+}
+
+// Hardware de la placa
+WireBus imuBus(Wire);
+FlightController::Sensor imuSource(imuBus);
+FlightController::Output escOutput;
+
+// Estado publicado por la tarea de control para el resto del sistema
+StateBus stateBus;
+
+// Registro diferido: un productor por tarea, vaciado desde comunicaciones
+Logger controlLog(systemClock);
+Logger commsLog(systemClock);
+
 // Instancias globales
-FlightController flightController;
-KeyboardController keyboardController;
+FlightController flightController(imuSource, escOutput, systemClock, controlLog, stateBus);
+KeyboardController keyboardController(commsLog);
+CommandParser commandParser;
+LinkMonitor linkMonitor(LINK_DROPOUT_US);
+ParameterRegistry parameterRegistry(FlightController::config.parameters);
+ParameterStore parameterStore(PARAMETER_NVS_NAMESPACE);
+ParameterConsole parameterConsole(parameterRegistry, parameterStore);
+Telemetry telemetry;
+PartitionFlashStore blackboxFlash;
+CalibrationStore calibrationStore(GYRO_CAL_NVS_NAMESPACE);
+
+// Un planificador por tarea de FreeRTOS
+Scheduler controlScheduler(systemClock, LOOP_TIME_US);
+Scheduler commsScheduler(systemClock, COMMS_TICK_US);
+
+// Canales entre tareas: entrada y parámetros -> control
+SpscChannel<ControlInputs> inputsChannel;
+SpscChannel<FlightParameters> parametersChannel;
+
+// Offsets del giroscopio recién calibrados, para guardarlos en NVS
+struct GyroCalibration {
+    int32_t offsets[3];
+};
+SpscChannel<GyroCalibration> calibrationChannel;
+
+// Estadísticas del loop de control, escritas sólo por la tarea de control
+std::atomic<uint32_t> loopCounter(0);
+std::atomic<uint32_t> lastLoopDuration(0);
+std::atomic<uint32_t> slowLoopCount(0);
+
+// Petición de parada de emergencia desde la tarea de comunicaciones
+std::atomic<bool> emergencyStopRequest(false);
+
+// Estado visto por la tarea de comunicaciones
+Subscriber<StatusState> statusSubscriber(stateBus.status);
+StatusState commsStatus;
+unsigned long lastSerialActivity = 0;
+uint32_t linkFramesSeen = 0;
+uint32_t reportedSlowLoops = 0;
+
+TaskHandle_t controlTaskHandle = nullptr;
+TaskHandle_t commsTaskHandle = nullptr;
+
+// ---- Trabajos de la tarea de control ----
+
+void controlJob(void* context) {
+    PROFILE_SCOPE(PROFILE_CONTROL_LOOP);
+    TRACE_SCOPE(TRACE_CONTROL_TICK, 0);
+    unsigned long startTime = micros();
+
+    // Parámetros nuevos: instantánea completa, aplicada antes de usarlos
+    FlightParameters parameters;
+    if (parametersChannel.consume(parameters)) {
+        flightController.applyParameters(parameters);
+    }
+    
+    // Aplicar los últimos comandos recibidos
+    ControlInputs inputs;
+    if (inputsChannel.consume(inputs)) {
+        flightController.setInputs(inputs);
+    }
+
+    if (emergencyStopRequest.exchange(false)) {
+        flightController.emergencyStop();
+    }
+
+    // Failsafe: el control mide el hueco del enlace con su propio reloj
+    flightController.setLinkStatus(linkMonitor.isActive(), linkMonitor.getLastFrameTime());
+    
+    // Actualizar flight controller (publica su estado en el bus)
+    flightController.update();
+    
+    // La escritura en NVS se hace desde la tarea de comunicaciones
+    GyroCalibration calibration;
+    if (flightController.takeCalibration(calibration.offsets)) {
+        calibrationChannel.publish(calibration);
+    }
+    
+    // Actualizar LED de estado
+    digitalWrite(PIN_LED_STATUS, flightController.isArmed() ? HIGH : LOW);
+
+    // Verificar si hay problemas de timing (se informa desde la otra tarea)
+    unsigned long loopTime = micros() - startTime;
+    lastLoopDuration.store(loopTime, std::memory_order_relaxed);
+    if (loopTime > LOOP_TIME_US * 1.2) {  // Si el loop toma más del 120% del tiempo esperado
+        slowLoopCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    loopCounter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void telemetryJob(void* context) {
+    telemetry.sample(flightController, micros(),
+                     lastLoopDuration.load(std::memory_order_relaxed));
+}
+
+void blackboxJob(void* context) {
+    blackbox.sample(flightController, micros());
+}
+
+// ---- Trabajos de la tarea de comunicaciones ----
+
+void inputJob(void* context) {
+    PROFILE_SCOPE(PROFILE_INPUT);
+    TRACE_SCOPE(TRACE_INPUT_JOB, 0);
+
+    // Vaciar todo el buffer de recepción: tramas de mandos y teclas sueltas
+    uint8_t rxBuffer[COMMAND_RX_CHUNK];
+    char keys[COMMAND_RX_CHUNK + COMMAND_CONSOLE_LINE];
+    bool inputChanged = false;
+    uint32_t traceId = 0;  // Correlación del último bloque recibido
+    int available;
+    while ((available = Serial.available()) > 0) {
+        size_t count = Serial.readBytes(rxBuffer, (size_t)available < sizeof(rxBuffer) ? available : sizeof(rxBuffer));
+        if (count == 0) break;
+        lastSerialActivity = micros();
+        traceId = TRACE_NEW_CORRELATION();
+        TRACE_INSTANT(TRACE_UART_RX, traceId);
+        
+        size_t keyCount = commandParser.feed(rxBuffer, count, lastSerialActivity, keys, sizeof(keys));
+        for (size_t i = 0; i < keyCount; i++) {
+            if (parameterConsole.processKey(keys[i], commsStatus.armed)) continue;
+            TRACE_INSTANT(TRACE_KEY, traceId);
+            if (keyboardController.processInput(keys[i])) {
+                inputChanged = true;
+            }
+        }
+    }
+    
+    if (parameterConsole.takeChanged()) {
+        parametersChannel.publish(parameterRegistry.getValues());
+    }
+    
+    // Marcar todas las tramas válidas para el failsafe y las estadísticas
+    uint32_t validFrames = commandParser.getValidFrames();
+    if (validFrames != linkFramesSeen) {
+        linkMonitor.onFrame(micros(), validFrames - linkFramesSeen);
+        linkFramesSeen = validFrames;
+    }
+    
+    // Sólo el mando binario más reciente llega al control
+    StickCommand command;
+    if (commandParser.takeCommand(command)) {
+        TRACE_INSTANT(TRACE_COMMAND_FRAME, traceId);
+        ControlInputs inputs = keyboardController.getInputs();
+        inputs.throttle = command.throttle;
+        inputs.rollCmd = command.rollCmd;
+        inputs.pitchCmd = command.pitchCmd;
+        inputs.yawCmd = command.yawCmd;
+        inputs.armCmd = command.armCmd;
+        inputs.disarmCmd = command.disarmCmd;
+        inputs.acroMode = command.acroMode;
+        keyboardController.setInputs(inputs);
+        if (command.kill && commsStatus.armed) {
+            emergencyStopRequest.store(true);
+        }
+        inputChanged = true;
+    }
+    
+    // Enviar inputs a la tarea de control una sola vez por tick
+    if (inputChanged) {
+        ControlInputs inputs = keyboardController.getInputs();
+        inputs.traceId = traceId;
+        TRACE_INSTANT(TRACE_INPUTS_PUBLISH, traceId);
+        inputsChannel.publish(inputs);
+    }
+    statusSubscriber.read(commsStatus);
+
+    telemetry.setEnabled(keyboardController.isTelemetryMode());
+
+#if ENABLE_BENCHMARKS
+    // Los benchmarks bloquean esta tarea unas decenas de ms: sólo en tierra
+    if (keyboardController.takeBenchmarkRequest()) {
+        if (commsStatus.armed) {
+            Serial.println("Benchmarks sólo con los motores desarmados");
+        } else {
+            runBenchmarks(Serial);
+        }
+    }
+#endif
+}
+
+void telemetryTxJob(void* context) {
+    // Enviar la telemetría binaria pendiente sin bloquear
+    if (telemetry.isEnabled()) {
+        telemetry.flush(Serial);
+    }
+}
+
+void safetyJob(void* context) {
+    unsigned long currentTime = micros();
+    linkMonitor.update(currentTime);
+    
+    // Con enlace binario el failsafe lo gestiona la tarea de control
+    if (linkMonitor.isActive()) return;
+    
+    // Sólo teclado: si no hay actividad serial en mucho tiempo y está armado, desarmar
+    if (commsStatus.armed &&
+        (currentTime - lastSerialActivity > KEYBOARD_TIMEOUT_US)) {
+        commsLog.log(LOG_SERIAL_TIMEOUT);
+        emergencyStopRequest.store(true);
+        lastSerialActivity = currentTime;
+    }
+}
+
+void statusJob(void* context) {
+    PROFILE_SCOPE(PROFILE_STATUS);
+
+    // Actualizar keyboard controller (para mostrar estado)
+    keyboardController.update(stateBus);
+}
+
+void monitorJob(void* context) {
+    // Informar de loops lentos detectados por la tarea de control
+    uint32_t slowLoops = slowLoopCount.load(std::memory_order_relaxed);
+    if (slowLoops != reportedSlowLoops) {
+        if (!telemetry.isEnabled()) {
+            Serial.printf("ADVERTENCIA: Loop lento! %lu us (esperado: %lu us, total: %lu)\n",
+                         (unsigned long)lastLoopDuration.load(std::memory_order_relaxed),
+                         (unsigned long)LOOP_TIME_US, (unsigned long)slowLoops);
+        }
+        reportedSlowLoops = slowLoops;
+    }
+    
+    // Guardar una calibración nueva (sólo se produce con los motores desarmados)
+    GyroCalibration calibration;
+    if (calibrationChannel.consume(calibration)) {
+        const float scale = 1.0f / (GYRO_SENSITIVITY * (1 << GYRO_OFFSET_FRACTION_BITS));
+        bool saved = calibrationStore.save(calibration.offsets);
+        if (!telemetry.isEnabled()) {
+            Serial.printf("Calibración completada%s - Offsets (°/s) X: %.4f, Y: %.4f, Z: %.4f\n",
+                          saved ? "" : " (ERROR al guardar en NVS)",
+                          calibration.offsets[0] * scale, calibration.offsets[1] * scale,
+                          calibration.offsets[2] * scale);
+        }
+    }
+}
+
+void logJob(void* context) {
+    // Formatear (o enviar como tramas en modo telemetría) lo que quepa en la UART
+    bool binary = telemetry.isEnabled();
+    controlLog.drain(Serial, binary);
+    commsLog.drain(Serial, binary);
+}
+
+#if ENABLE_TRACE
+void traceJob(void* context) {
+    // El volcado ocupa la UART varios segundos: no se mezcla con la telemetría
+    if (keyboardController.takeTraceDumpRequest() && !telemetry.isEnabled()) {
+        tracer.beginDump(Serial);
+    }
+    if (tracer.isDumping()) {
+        tracer.continueDump(Serial);
+    }
+}
+#endif
 
-// Variables de timing
-unsigned long lastLoopTime = 0;
-unsigned long loopCounter = 0;
+void blackboxFlushJob(void* context) {
+    // Volcar el buffer de PSRAM a la flash fuera del camino de control
+    blackbox.flush(commsStatus.armed);
+}
+
+void blackboxEraseJob(void* context) {
+    // Un sector por tick; no cabe en ningún margen, por eso es crítica
+    blackbox.continueErase(commsStatus.armed);
+}
+
+static void printSchedulerStats(const char* label, Scheduler& scheduler) {
+    for (int i = 0; i < scheduler.getTaskCount(); i++) {
+        const SchedulerTask& task = scheduler.getTask(i);
+        Serial.printf("  %s/%-12s runs:%-8lu max:%-6lu us excesos:%-4lu aplazadas:%-4lu perdidas:%lu\n",
+                      label, task.name,
+                      (unsigned long)task.runCount, (unsigned long)task.maxDurationUs,
+                      (unsigned long)task.overrunCount, (unsigned long)task.deferCount,
+                      (unsigned long)task.skipCount);
+    }
+}
+
+void statsJob(void* context) {
+    // Estadísticas periódicas (incluidas en la telemetría binaria)
+    if (telemetry.isEnabled()) return;
+
+    float loopTimeMs = lastLoopDuration.load(std::memory_order_relaxed) / 1000.0;
+    Serial.printf("Estadísticas: Último loop: %.2f ms | Frecuencia: %d Hz | Loops: %lu\n",
+                 loopTimeMs, LOOP_FREQUENCY,
+                 (unsigned long)loopCounter.load(std::memory_order_relaxed));
+    if (linkMonitor.isActive()) {
+        Serial.printf("Enlace: %.1f tramas/s | hueco máx: %lu ms | cortes: %lu | inválidas: %lu | perdidas: %lu\n",
+                      linkMonitor.getRateHz(), (unsigned long)(linkMonitor.getMaxGapUs() / 1000),
+                      (unsigned long)linkMonitor.getDropoutCount(),
+                      (unsigned long)commandParser.getInvalidFrames(),
+                      (unsigned long)commandParser.getLostFrames());
+        linkMonitor.resetStats();
+    }
+    printSchedulerStats("control", controlScheduler);
+    printSchedulerStats("comms", commsScheduler);
+}
+
+// Registra un trabajo; si la tabla del planificador está llena se avisa en
+// lugar de perderlo en silencio
+void addJob(Scheduler& scheduler, const char* name, SchedulerCallback callback,
+            uint32_t periodUs, uint8_t priority, uint32_t budgetUs) {
+    if (scheduler.addTask(name, callback, nullptr, periodUs, priority, budgetUs) < 0) {
+        Serial.printf("ERROR: sin hueco en el planificador para '%s'\n", name);
+    }
+}
+
+// Tarea de control: alta prioridad, fijada a su propio núcleo. Entre ticks
+// queda bloqueada para no acaparar el núcleo (el vigilante de la tarea ociosa
+// y las tareas del sistema en él también necesitan correr).
+void controlTask(void* parameter) {
+#if IMU_USE_FIFO
+    // El ritmo lo marca la interrupción de datos listos del MPU6050: cada
+    // muestra despierta la tarea y el tick corre cuando hay las del lazo. Si
+    // se perdiera una interrupción, el tiempo de espera evita quedarse parado.
+    const TickType_t waitTicks = pdMS_TO_TICKS(2 * LOOP_TIME_US / 1000) + 1;
+    Mpu6050Source::notifyOnDataReady(xTaskGetCurrentTaskHandle());
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, waitTicks);
+        if (flightController.dataReady()) {
+            controlScheduler.runTick(micros());
+        }
+    }
+#else
+    // Sin FIFO, ritmo fijo del tick de FreeRTOS: vTaskDelayUntil no acumula
+    // la deriva del tiempo de cada tick
+    static_assert(LOOP_TIME_US % (portTICK_PERIOD_MS * 1000) == 0,
+                  "LOOP_TIME_US debe ser múltiplo del tick de FreeRTOS");
+    const TickType_t periodTicks = pdMS_TO_TICKS(LOOP_TIME_US / 1000);
+    TickType_t lastWake = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&lastWake, periodTicks);
+        controlScheduler.runTick(micros());
+    }
+#endif
+}
+
+// Tarea de comunicaciones: entrada del teclado y salida por consola
+void commsTask(void* parameter) {
+    memset(&commsStatus, 0, sizeof(commsStatus));
+    lastSerialActivity = micros();
+
+    for (;;) {
+        commsScheduler.poll();
+        vTaskDelay(1);
+    }
+}
 
 void setup() {
+    Serial.setRxBufferSize(SERIAL_RX_BUFFER_SIZE);
     Serial.begin(SERIAL_BAUD);
-    delay(2000);  // Esperar a que se establezca la conexión serial
-    
+
     Serial.println("\n========================================");
     Serial.println("    CONTROLADOR DE VUELO ESP32");
     Serial.println("       Basado en DroneIno");
     Serial.println("========================================");
+
+    // Configurar LED de estado e I2C del MPU6050
+    pinMode(PIN_LED_STATUS, OUTPUT);
+    Wire.begin(PIN_MPU6050_SDA, PIN_MPU6050_SCL);
+    Wire.setClock(400000);
+    
+    // Parámetros guardados en NVS sobre los valores por defecto de config.h
+    int loadedParameters = parameterStore.load(parameterRegistry);
+    if (loadedParameters > 0) {
+        Serial.printf("Parámetros: %d cargados de NVS\n", loadedParameters);
+    }
+    flightController.applyParameters(parameterRegistry.getValues());
     
-    // Inicializar flight controller
-    if (!flightController.init()) {
+    // Inicializar flight controller con los offsets guardados, si los hay
+    int32_t storedGyroOffsets[3];
+    bool hasStoredOffsets = calibrationStore.load(storedGyroOffsets);
+    bool initialized = flightController.init(hasStoredOffsets ? storedGyroOffsets : nullptr);
+    while (controlLog.pending() > 0) {
+        controlLog.drain(Serial, false);  // Aún no hay tareas: vaciar aquí
+    }
+    if (!initialized) {
         Serial.println("ERROR FATAL: No se pudo inicializar el flight controller!");
         while (1) {
             digitalWrite(PIN_LED_STATUS, !digitalRead(PIN_LED_STATUS));
             delay(200);
         }
     }
+
+#if ENABLE_BLACKBOX
+    // El registro de vuelo es opcional: sin PSRAM o sin partición se vuela igual
+    if (blackboxFlash.begin(BLACKBOX_PARTITION) && blackbox.init(blackboxFlash)) {
+        Serial.printf("Blackbox: %u KB usados de %u KB\n",
+                      (unsigned)(blackbox.getUsedBytes() / 1024),
+                      (unsigned)(blackbox.getCapacity() / 1024));
+    } else {
+        Serial.println("ADVERTENCIA: Blackbox no disponible (PSRAM o partición)");
+    }
+#endif
     
     // Inicializar keyboard controller
     keyboardController.init();
-    
+
+    // Registrar trabajos: el control en cada tick, el resto a su frecuencia
+    addJob(controlScheduler, "control", controlJob, 0,
+           SCHEDULER_PRIORITY_CRITICAL, LOOP_TIME_US);
+    addJob(controlScheduler, "telemetria", telemetryJob, 1000000 / TELEMETRY_RATE_HZ,
+           1, TELEMETRY_BUDGET_US);
+#if ENABLE_BLACKBOX
+    if (blackbox.isReady()) {
+        addJob(controlScheduler, "blackbox", blackboxJob, LOOP_TIME_US * BLACKBOX_RATE_DIVIDER,
+               2, BLACKBOX_BUDGET_US);
+    }
+#endif
+
+    addJob(commsScheduler, "entrada", inputJob, 0,
+           SCHEDULER_PRIORITY_CRITICAL, COMMS_TICK_US);
+    addJob(commsScheduler, "seguridad", safetyJob, SAFETY_PERIOD_US,
+           1, SAFETY_BUDGET_US);
+    addJob(commsScheduler, "telemetriaTx", telemetryTxJob, TELEMETRY_TX_PERIOD_US,
+           2, TELEMETRY_TX_BUDGET_US);
+#if ENABLE_BLACKBOX
+    if (blackbox.isReady()) {
+        addJob(commsScheduler, "blackboxFlash", blackboxFlushJob, BLACKBOX_FLUSH_PERIOD_US,
+               4, BLACKBOX_FLUSH_BUDGET_US);
+        addJob(commsScheduler, "blackboxBorrado", blackboxEraseJob, 0,
+               SCHEDULER_PRIORITY_CRITICAL, BLACKBOX_ERASE_BUDGET_US);
+    }
+#endif
+    addJob(commsScheduler, "log", logJob, LOG_DRAIN_PERIOD_US,
+           2, LOG_DRAIN_BUDGET_US);
+#if ENABLE_TRACE
+    addJob(commsScheduler, "traza", traceJob, TRACE_DUMP_PERIOD_US,
+           3, TRACE_DUMP_BUDGET_US);
+#endif
+    addJob(commsScheduler, "monitor", monitorJob, MONITOR_PERIOD_US,
+           3, STATUS_BUDGET_US);
+    addJob(commsScheduler, "estado", statusJob, STATUS_PERIOD_US,
+           3, STATUS_BUDGET_US);
+    addJob(commsScheduler, "estadisticas", statsJob, STATS_PERIOD_US,
+           4, STATS_BUDGET_US);
+
     Serial.println("\nSistema listo! Usa 'H' para ver la ayuda.");
     Serial.println("IMPORTANTE: Mantén el throttle en 0% antes de armar!");
     Serial.println("========================================\n");
-    
-    lastLoopTime = micros();
+
+    // Repartir el trabajo entre los dos núcleos
+    // Comunicaciones primero: setup() corre en el núcleo del control y la
+    // tarea de control le quitaría la CPU en cuanto existiera
+    xTaskCreatePinnedToCore(commsTask, "comms", COMMS_TASK_STACK, nullptr,
+                            COMMS_TASK_PRIORITY, &commsTaskHandle, COMMS_TASK_CORE);
+    xTaskCreatePinnedToCore(controlTask, "control", CONTROL_TASK_STACK, nullptr,
+                            CONTROL_TASK_PRIORITY, &controlTaskHandle, CONTROL_TASK_CORE);
 }
 
 void loop() {
-    unsigned long currentTime = micros();
-    
-    // Control de frecuencia del loop principal
-    if (currentTime - lastLoopTime >= LOOP_TIME_US) {
-        
-        // Procesar entrada del teclado
-        if (Serial.available()) {
-            char key = Serial.read();
-            if (keyboardController.processInput(key)) {
-                // Actualizar inputs del flight controller
-                ControlInputs inputs = keyboardController.getInputs();
-                flightController.setInputs(inputs);
-            }
-        }
-        
-        // Actualizar flight controller
-        flightController.update();
-        
-        // Actualizar keyboard controller (para mostrar estado)
-        keyboardController.update(flightController.getFlightData());
-        
-        // Verificar si hay problemas de timing
-        unsigned long loopTime = micros() - currentTime;
-        if (loopTime > LOOP_TIME_US * 1.2) {  // Si el loop toma más del 120% del tiempo esperado
-            Serial.printf("ADVERTENCIA: Loop lento! %lu us (esperado: %lu us)\n", 
-                         loopTime, LOOP_TIME_US);
-        }
-        
-        lastLoopTime = currentTime;
-        loopCounter++;
-        
-        // Mostrar estadísticas cada 10 segundos
-        if (loopCounter % (LOOP_FREQUENCY * 10) == 0) {
-            float avgLoopTime = loopTime / 1000.0;
-            Serial.printf("Estadísticas: Loop promedio: %.2f ms | Frecuencia: %d Hz\n", 
-                         avgLoopTime, LOOP_FREQUENCY);
-        }
-    }
-    
-    // Verificación de seguridad adicional
-    static unsigned long lastSafetyCheck = 0;
-    if (currentTime - lastSafetyCheck > 1000000) {  // Cada segundo
-        
-        // Si no hay comunicación serial por mucho tiempo y está armado, desarmar
-        static unsigned long lastSerialActivity = 0;
-        if (Serial.available()) {
-            lastSerialActivity = currentTime;
-        }
-        
-        if (flightController.isArmed() && 
-            (currentTime - lastSerialActivity > 10000000)) {  // 10 segundos sin actividad
-            Serial.println("ADVERTENCIA: Sin actividad serial - desarmando por seguridad");
-            flightController.emergencyStop();
-        }
-        
-        lastSafetyCheck = currentTime;
-    }
+    // Todo el trabajo se hace en las tareas de control y comunicaciones
+    vTaskDelete(nullptr);
 }
\ No newline at end of file
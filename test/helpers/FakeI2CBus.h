@@ -0,0 +1,94 @@
+#ifndef FAKE_I2C_BUS_H
+#define FAKE_I2C_BUS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "I2CBus.h"
+#include "MPU6050Driver.h"
+
+// Bus I2C simulado con el mapa de registros de un MPU6050: lecturas con
+// autoincremento, FIFO en FIFO_R_W y contador en FIFO_COUNTH/L.
+class FakeI2CBus : public I2CBus {
+private:
+    static const size_t FIFO_CAPACITY = 4096;
+
+    uint8_t fifo[FIFO_CAPACITY];
+    size_t fifoHead;
+    size_t fifoTail;
+
+    size_t fifoBytes() const { return fifoTail - fifoHead; }
+
+public:
+    uint8_t address;
+    uint8_t registers[256];
+    uint8_t lastWriteValue[256];
+    int writeCount[256];
+    int readTransactions;
+    size_t lastReadLength;
+    int failAfter;          // Transacciones que funcionan antes de empezar a fallar (-1 = nunca)
+    bool failFifoReads;     // Simula una ráfaga de FIFO_R_W interrumpida
+
+    FakeI2CBus() : fifoHead(0), fifoTail(0), address(MPU6050_I2C_ADDRESS),
+                   readTransactions(0), lastReadLength(0), failAfter(-1),
+                   failFifoReads(false) {
+        memset(registers, 0, sizeof(registers));
+        memset(lastWriteValue, 0, sizeof(lastWriteValue));
+        memset(writeCount, 0, sizeof(writeCount));
+        registers[MPU6050_REG_WHO_AM_I] = 0x68;
+    }
+
+    // Añade una muestra al FIFO en el orden del sensor (accel XYZ, gyro XYZ, big endian)
+    void pushFifoSample(const int16_t accel[3], const int16_t gyro[3]) {
+        int16_t words[6] = { accel[0], accel[1], accel[2], gyro[0], gyro[1], gyro[2] };
+        for (int i = 0; i < 6; i++) {
+            fifo[fifoTail++ % FIFO_CAPACITY] = (uint8_t)((uint16_t)words[i] >> 8);
+            fifo[fifoTail++ % FIFO_CAPACITY] = (uint8_t)(words[i] & 0xFF);
+        }
+    }
+
+    // Escribe un valor de 16 bits en un par de registros H/L
+    void setWord(uint8_t reg, int16_t value) {
+        registers[reg] = (uint8_t)((uint16_t)value >> 8);
+        registers[reg + 1] = (uint8_t)(value & 0xFF);
+    }
+
+    size_t fifoSamples() const { return fifoBytes() / MPU6050_FIFO_SAMPLE_BYTES; }
+
+    bool writeRegister(uint8_t addr, uint8_t reg, uint8_t value) override {
+        if (!transactionAllowed(addr)) return false;
+        registers[reg] = value;
+        lastWriteValue[reg] = value;
+        writeCount[reg]++;
+        if (reg == MPU6050_REG_USER_CTRL && (value & 0x04)) {
+            fifoHead = fifoTail = 0;  // FIFO_RESET
+            registers[MPU6050_REG_INT_STATUS] &= (uint8_t)~0x10;
+        }
+        return true;
+    }
+
+    bool readRegisters(uint8_t addr, uint8_t reg, uint8_t* buffer, size_t length) override {
+        if (!transactionAllowed(addr)) return false;
+        readTransactions++;
+        lastReadLength = length;
+        if (reg == MPU6050_REG_FIFO_R_W) {
+            if (failFifoReads || length > fifoBytes()) return false;
+            for (size_t i = 0; i < length; i++) buffer[i] = fifo[fifoHead++ % FIFO_CAPACITY];
+            return true;
+        }
+        registers[MPU6050_REG_FIFO_COUNTH] = (uint8_t)(fifoBytes() >> 8);
+        registers[MPU6050_REG_FIFO_COUNTH + 1] = (uint8_t)(fifoBytes() & 0xFF);
+        for (size_t i = 0; i < length; i++) buffer[i] = registers[(reg + i) & 0xFF];
+        return true;
+    }
+
+private:
+    bool transactionAllowed(uint8_t addr) {
+        if (addr != address) return false;
+        if (failAfter == 0) return false;
+        if (failAfter > 0) failAfter--;
+        return true;
+    }
+};
+
+#endif
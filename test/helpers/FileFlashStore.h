@@ -0,0 +1,95 @@
+#ifndef FILE_FLASH_STORE_H
+#define FILE_FLASH_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "FlashStore.h"
+
+// Flash NOR en un fichero: la imagen es la misma que leería
+// tools/blackbox_decode.py de la partición. Como en el chip, escribir sólo
+// pasa bits de 1 a 0 y borrar deja el sector a 0xFF. Cuenta las operaciones
+// y la página más larga programada de una vez.
+class FileFlashStore : public FlashStore {
+private:
+    FILE* file;
+    size_t capacity;
+    size_t sector;
+
+public:
+    static const size_t pageSize = 256;
+
+    int writeCount;
+    int eraseCount;
+    size_t largestWrite;
+    bool crossedPage;       // Alguna escritura cruzó el límite de una página
+    bool programmedZeroBit; // Alguna escritura intentó pasar un 0 a 1
+
+    FileFlashStore(const char* path, size_t size, size_t sectorSize = 4096)
+        : file(nullptr), capacity(size), sector(sectorSize),
+          writeCount(0), eraseCount(0), largestWrite(0),
+          crossedPage(false), programmedZeroBit(false) {
+        // Reutilizar la imagen si ya existe (como la flash tras un reinicio)
+        file = fopen(path, "r+b");
+        if (file == nullptr) {
+            file = fopen(path, "w+b");
+            uint8_t blank[256];
+            memset(blank, 0xFF, sizeof(blank));
+            for (size_t done = 0; file && done < capacity; done += sizeof(blank)) {
+                fwrite(blank, 1, sizeof(blank), file);
+            }
+        }
+    }
+
+    ~FileFlashStore() override {
+        if (file) fclose(file);
+    }
+
+    bool isOpen() const { return file != nullptr; }
+
+    size_t size() const override { return file ? capacity : 0; }
+    size_t sectorSize() const override { return sector; }
+
+    bool read(size_t offset, uint8_t* data, size_t length) override {
+        if (!file || offset + length > capacity) return false;
+        return fseek(file, (long)offset, SEEK_SET) == 0 && fread(data, 1, length, file) == length;
+    }
+
+    bool write(size_t offset, const uint8_t* data, size_t length) override {
+        if (!file || offset + length > capacity) return false;
+        writeCount++;
+        if (length > largestWrite) largestWrite = length;
+        if (length > 0 && offset / pageSize != (offset + length - 1) / pageSize) crossedPage = true;
+
+        uint8_t current[pageSize];
+        for (size_t done = 0; done < length; ) {
+            size_t count = length - done < pageSize ? length - done : pageSize;
+            if (!read(offset + done, current, count)) return false;
+            for (size_t i = 0; i < count; i++) {
+                if (data[done + i] & ~current[i]) programmedZeroBit = true;
+                current[i] &= data[done + i];
+            }
+            if (fseek(file, (long)(offset + done), SEEK_SET) != 0 ||
+                fwrite(current, 1, count, file) != count) return false;
+            done += count;
+        }
+        fflush(file);
+        return true;
+    }
+
+    bool eraseSector(size_t offset) override {
+        if (!file || offset % sector != 0 || offset + sector > capacity) return false;
+        eraseCount++;
+        uint8_t blank[256];
+        memset(blank, 0xFF, sizeof(blank));
+        if (fseek(file, (long)offset, SEEK_SET) != 0) return false;
+        for (size_t done = 0; done < sector; done += sizeof(blank)) {
+            if (fwrite(blank, 1, sizeof(blank), file) != sizeof(blank)) return false;
+        }
+        fflush(file);
+        return true;
+    }
+};
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef SIM_HARNESS_H
+#define SIM_HARNESS_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "ComplementaryFilter.h"
+#include "FlightPipeline.h"
+#include "LinkMonitor.h"
+#include "MahonyAHRS.h"
+#include "Mixer.h"
+#include "PID.h"
+#include "SimQuad.h"
+
+// Simulación en el host: el FlightPipeline real contra SimQuad. El reloj es
+// simulado, así que se corre tan rápido como da la CPU; los escenarios
+// (armar, escalones, perturbaciones, failsafe) son las pruebas de test_sim.
+
+inline uint32_t simNowUs = 0;
+
+inline uint32_t simClock() {
+    return simNowUs;
+}
+
+// Sensor: lectura directa de registros, cuantizada y saturada como el MPU6050
+class SimImu {
+private:
+    SimQuad& quad;
+    float gyroSensitivity;
+    float accelSensitivity;
+    uint32_t samplePeriodUs;
+
+    static int16_t toCounts(float value) {
+        float counts = roundf(value);
+        if (counts > 32767.0f) return 32767;
+        if (counts < -32768.0f) return -32768;
+        return (int16_t)counts;
+    }
+
+public:
+    static constexpr bool usesFifo = false;
+
+    explicit SimImu(SimQuad& simulatedQuad)
+        : quad(simulatedQuad), gyroSensitivity(0), accelSensitivity(0), samplePeriodUs(0) {}
+
+    bool init(const ImuConfig& config) {
+        gyroSensitivity = config.gyroSensitivity;
+        accelSensitivity = config.accelSensitivity;
+        samplePeriodUs = 1000000 / config.sampleRateHz;
+        return true;
+    }
+    bool startFifo() { return true; }
+
+    size_t read(ImuSample* samples, size_t maxSamples) {
+        if (maxSamples == 0) return 0;
+        float dps[3], g[3];
+        quad.readGyro(dps);
+        quad.readAccel(g);
+        for (int axis = 0; axis < 3; axis++) {
+            samples[0].gyro[axis] = toCounts(dps[axis] * gyroSensitivity);
+            samples[0].accel[axis] = toCounts(g[axis] * accelSensitivity);
+        }
+        samples[0].timestampUs = simNowUs;
+        return 1;
+    }
+
+    uint32_t pendingSamples() const { return 1; }
+    uint32_t getSamplePeriodUs() const { return samplePeriodUs; }
+};
+
+// Salida: el pulso de cada ESC se normaliza al mando del motor simulado
+class SimMotors final : public MotorOutput<SimQuad::motorCount> {
+private:
+    SimQuad& quad;
+    int minPulse;
+    int maxPulse;
+
+public:
+    int pulses[SimQuad::motorCount];
+
+    SimMotors(SimQuad& simulatedQuad, int minPulseUs, int maxPulseUs)
+        : quad(simulatedQuad), minPulse(minPulseUs), maxPulse(maxPulseUs) {
+        for (int i = 0; i < SimQuad::motorCount; i++) pulses[i] = minPulseUs;
+    }
+
+    bool init(const uint8_t* motorPins) override {
+        (void)motorPins;
+        return true;
+    }
+
+    void write(const int (&pulsesUs)[SimQuad::motorCount]) override {
+        for (int i = 0; i < SimQuad::motorCount; i++) {
+            pulses[i] = pulsesUs[i];
+            quad.setMotorCommand(i, (float)(pulsesUs[i] - minPulse) / (maxPulse - minPulse));
+        }
+    }
+};
+
+// Marco de config.h con el hardware simulado; el resto de políticas y la
+// configuración son las del vuelo real (FlightController.h)
+struct SimAirframe {
+    static constexpr AirframeConfig config = DEFAULT_AIRFRAME_CONFIG;
+
+    using Sensor = SimImu;
+    using Controller = PIDController;
+    using MotorMixer = Mixer;
+    using Output = SimMotors;
+
+#if ATTITUDE_ESTIMATOR == ESTIMATOR_MAHONY
+    using Estimator = MahonyAHRS;
+    static constexpr MahonyAHRS::Config estimatorConfig = { MAHONY_KP, MAHONY_KI };
+#else
+    using Estimator = ComplementaryFilter;
+    static constexpr ComplementaryFilter::Config estimatorConfig = { GYRO_FILTER_ALPHA };
+#endif
+};
+
+// Métricas de un escalón de `start` a `target`
+struct StepMetrics {
+    float riseTimeS;        // 10% -> 90% del escalón
+    float overshootPct;     // Pico más allá del objetivo, en % del escalón
+    float settlingTimeS;    // Desde el escalón hasta quedarse en la banda
+    float finalError;       // Error medio del último 10%
+};
+
+inline StepMetrics measureStep(const std::vector<float>& trace, float dt, float start, float target,
+                               float band) {
+    StepMetrics metrics = { -1.0f, 0.0f, -1.0f, 0.0f };
+    float step = target - start;
+    float direction = step >= 0.0f ? 1.0f : -1.0f;
+    int rise10 = -1;
+    float peak = 0.0f;
+
+    for (size_t i = 0; i < trace.size(); i++) {
+        float progress = (trace[i] - start) / step;
+        if (rise10 < 0 && progress >= 0.1f) rise10 = (int)i;
+        if (metrics.riseTimeS < 0.0f && rise10 >= 0 && progress >= 0.9f) {
+            metrics.riseTimeS = (i - rise10) * dt;
+        }
+        float beyond = (trace[i] - target) * direction;
+        if (beyond > peak) peak = beyond;
+        if (fabsf(trace[i] - target) > band) metrics.settlingTimeS = (i + 1) * dt;
+    }
+    if (metrics.settlingTimeS < 0.0f) metrics.settlingTimeS = 0.0f;
+    if (metrics.settlingTimeS >= trace.size() * dt) metrics.settlingTimeS = -1.0f;  // Nunca se asentó
+    metrics.overshootPct = 100.0f * peak / fabsf(step);
+
+    size_t tail = trace.size() / 10 > 0 ? trace.size() / 10 : 1;
+    float sum = 0.0f;
+    for (size_t i = trace.size() - tail; i < trace.size(); i++) sum += trace[i] - target;
+    metrics.finalError = sum / tail;
+    return metrics;
+}
+
+// Escenario: quad, sensor, motores, enlace y el lazo real. El piloto manda
+// tramas a frameHz como el enlace binario; linkUp = false las corta.
+template <typename Airframe = SimAirframe>
+class SimRunner {
+public:
+    static constexpr AirframeConfig config = Airframe::config;
+    static constexpr uint32_t loopPeriodUs = 1000000 / config.loop.rateHz;
+    static constexpr uint32_t physicsStepUs = loopPeriodUs < 250 ? loopPeriodUs : 250;
+
+    SimQuad quad;
+    SimImu imu;
+    SimMotors motors;
+    Logger logger;
+    StateBus stateBus;
+    LinkMonitor link;
+    FlightPipeline<Airframe> pipeline;
+
+    ControlInputs pilot;
+    uint32_t frameIntervalUs;
+    bool linkUp;
+
+private:
+    uint32_t nextFrameUs;
+    uint32_t physicsClockUs;
+
+public:
+    explicit SimRunner(const SimQuadParams& params = SIM_QUAD_DEFAULT, uint32_t seed = 1)
+        : quad(params, seed),
+          imu(quad),
+          motors(quad, config.esc.minPulse, config.esc.maxPulse),
+          logger(simClock),
+          link(LINK_DROPOUT_US),
+          pipeline(imu, motors, simClock, logger, stateBus),
+          frameIntervalUs(20000),
+          linkUp(true),
+          nextFrameUs(0),
+          physicsClockUs(0) {
+        simNowUs = 1000;
+        memset(&pilot, 0, sizeof(pilot));
+    }
+
+    float time() const { return simNowUs / 1000000.0f; }
+
+    // Un tick del lazo: física hasta el instante del tick, trama del piloto
+    // si toca, estado del enlace y FlightPipeline::update
+    void tick() {
+        uint32_t tickEnd = simNowUs + loopPeriodUs;
+        while ((int32_t)(tickEnd - physicsClockUs) > 0) {
+            quad.step(physicsStepUs / 1000000.0f);
+            physicsClockUs += physicsStepUs;
+        }
+        simNowUs = tickEnd;
+
+        if (linkUp && (int32_t)(simNowUs - nextFrameUs) >= 0) {
+            pipeline.setInputs(pilot);
+            link.onFrame(simNowUs);
+            pilot.armCmd = pilot.disarmCmd = false;  // Un solo flanco por orden
+            nextFrameUs = simNowUs + frameIntervalUs;
+        }
+        pipeline.setLinkStatus(link.isActive(), link.getLastFrameTime());
+        pipeline.update();
+    }
+
+    void runFor(float seconds) {
+        uint32_t ticks = (uint32_t)(seconds * config.loop.rateHz + 0.5f);
+        for (uint32_t i = 0; i < ticks; i++) tick();
+    }
+
+    // Arranque sin offsets guardados: calibración en reposo y espera de los ESC
+    bool start() {
+        physicsClockUs = simNowUs;
+        nextFrameUs = simNowUs;
+        if (!pipeline.init(nullptr)) return false;
+        for (int i = 0; i < 10 * (int)config.loop.rateHz; i++) {
+            tick();
+            if (pipeline.isCalibrated() && simNowUs > config.esc.armTimeUs + 100000) return true;
+        }
+        return false;
+    }
+
+    bool arm() {
+        pilot.throttle = 0;
+        pilot.armCmd = true;
+        runFor(0.1f);
+        return pipeline.isArmed();
+    }
+
+    // Despegar con un impulso de throttle y quedarse a `hoverThrottle`
+    bool takeOff(float hoverThrottle, float seconds = 2.0f) {
+        if (!arm()) return false;
+        pilot.throttle = hoverThrottle + 15.0f;
+        runFor(0.5f);
+        pilot.throttle = hoverThrottle;
+        runFor(seconds);
+        return !quad.isGrounded();
+    }
+
+    // Registra `value(*this)` en cada tick durante `seconds`
+    template <typename Probe>
+    std::vector<float> record(float seconds, Probe value) {
+        std::vector<float> trace;
+        uint32_t ticks = (uint32_t)(seconds * config.loop.rateHz + 0.5f);
+        trace.reserve(ticks);
+        for (uint32_t i = 0; i < ticks; i++) {
+            tick();
+            trace.push_back(value(*this));
+        }
+        return trace;
+    }
+};
+
+#endif
@@ -0,0 +1,258 @@
+#ifndef SIM_QUAD_H
+#define SIM_QUAD_H
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+// Modelo de cuerpo rígido de un quad X para la simulación en el host.
+//
+// Los ejes siguen los convenios del firmware (ver Mixer.h y los estimadores):
+// roll positivo sube los motores de la derecha, pitch positivo los de atrás
+// y yaw positivo es el par de reacción de los que giran en sentido horario.
+// La actitud es un cuaternión; el acelerómetro mide la fuerza específica
+// (empuje y rozamiento, no la gravedad en vuelo), como el sensor real. Con
+// idealAccel sólo ve la gravedad: en un alabeo sostenido el sensor real dice
+// "nivelado" y arrastra al estimador, lo que tapa la respuesta del lazo de
+// ángulo que se quiere medir en los escalones.
+struct SimQuadParams {
+    float mass;                 // kg
+    float armLever;             // m, brazo efectivo de cada motor en roll y pitch
+    float inertia[3];           // kg·m²
+    float maxThrust;            // N por motor con mando 1
+    float thrustQuadratic;      // Empuje = maxThrust * ((1 - a) * w + a * w²)
+    float motorTimeConstant;    // s, retardo de primer orden de la velocidad del motor
+    float yawTorquePerThrust;   // m, par de reacción por newton de empuje
+    float linearDrag;           // N / (m/s)
+    float angularDrag;          // N·m / (rad/s)
+    float gyroNoiseDps;         // Desviación típica por muestra
+    float gyroBiasDps[3];
+    float accelNoiseG;
+    bool idealAccel;            // El acelerómetro mide la gravedad, no la fuerza específica
+};
+
+// Quad de 250 mm con empuje/peso 2 y la linealización de config.h
+static const SimQuadParams SIM_QUAD_DEFAULT = {
+    0.6f,
+    0.078f,
+    { 3.0e-3f, 3.0e-3f, 5.5e-3f },
+    2.94f,
+    0.4f,
+    0.02f,
+    0.015f,
+    0.3f,
+    2.0e-4f,
+    0.05f,
+    { 0.8f, -0.5f, 0.3f },
+    0.004f,
+    false,
+};
+
+class SimQuad {
+public:
+    static const int motorCount = 4;
+    static constexpr float gravity = 9.80665f;
+
+private:
+    // Geometría en el orden de motores del firmware (Mixer.cpp, QUAD_X_RULES)
+    struct MotorGeometry {
+        float roll, pitch, yaw;
+    };
+
+    SimQuadParams params;
+    MotorGeometry geometry[motorCount];
+
+    float q[4];             // Cuerpo -> mundo (w, x, y, z)
+    float rates[3];         // rad/s en ejes del cuerpo
+    float position[3];      // m, z hacia arriba
+    float velocity[3];      // m/s en ejes del mundo
+    float specificForce[3]; // m/s² en ejes del cuerpo
+    float motorSpeed[motorCount];    // 0-1
+    float motorCommand[motorCount];  // 0-1
+    float disturbance[3];   // N·m externos en ejes del cuerpo
+    uint32_t noiseState;
+    bool grounded;
+
+    float gaussian() {
+        // Suma de 4 uniformes: aproximación barata de una normal
+        float sum = 0.0f;
+        for (int i = 0; i < 4; i++) {
+            noiseState = noiseState * 1664525u + 1013904223u;
+            sum += (float)(noiseState >> 8) / 16777216.0f - 0.5f;
+        }
+        return sum * 1.7320508f;
+    }
+
+    void bodyToWorld(const float body[3], float world[3]) const {
+        float w = q[0], x = q[1], y = q[2], z = q[3];
+        world[0] = (1 - 2 * (y * y + z * z)) * body[0] + 2 * (x * y - w * z) * body[1] + 2 * (x * z + w * y) * body[2];
+        world[1] = 2 * (x * y + w * z) * body[0] + (1 - 2 * (x * x + z * z)) * body[1] + 2 * (y * z - w * x) * body[2];
+        world[2] = 2 * (x * z - w * y) * body[0] + 2 * (y * z + w * x) * body[1] + (1 - 2 * (x * x + y * y)) * body[2];
+    }
+
+    void worldToBody(const float world[3], float body[3]) const {
+        float w = q[0], x = q[1], y = q[2], z = q[3];
+        body[0] = (1 - 2 * (y * y + z * z)) * world[0] + 2 * (x * y + w * z) * world[1] + 2 * (x * z - w * y) * world[2];
+        body[1] = 2 * (x * y - w * z) * world[0] + (1 - 2 * (x * x + z * z)) * world[1] + 2 * (y * z + w * x) * world[2];
+        body[2] = 2 * (x * z + w * y) * world[0] + 2 * (y * z - w * x) * world[1] + (1 - 2 * (x * x + y * y)) * world[2];
+    }
+
+public:
+    explicit SimQuad(const SimQuadParams& quadParams = SIM_QUAD_DEFAULT, uint32_t seed = 1)
+        : params(quadParams), noiseState(seed) {
+        const MotorGeometry quadX[motorCount] = {
+            {  1.0f, -1.0f, -1.0f },  // Delantero derecho (CCW)
+            {  1.0f,  1.0f,  1.0f },  // Trasero derecho (CW)
+            { -1.0f,  1.0f, -1.0f },  // Trasero izquierdo (CCW)
+            { -1.0f, -1.0f,  1.0f },  // Delantero izquierdo (CW)
+        };
+        memcpy(geometry, quadX, sizeof(geometry));
+        reset();
+    }
+
+    void reset() {
+        q[0] = 1.0f;
+        q[1] = q[2] = q[3] = 0.0f;
+        for (int axis = 0; axis < 3; axis++) {
+            rates[axis] = position[axis] = velocity[axis] = disturbance[axis] = 0.0f;
+            specificForce[axis] = 0.0f;
+        }
+        specificForce[2] = gravity;
+        for (int i = 0; i < motorCount; i++) {
+            motorSpeed[i] = motorCommand[i] = 0.0f;
+        }
+        grounded = true;
+    }
+
+    // Mando de cada motor en [0, 1] (pulso del ESC normalizado)
+    void setMotorCommand(int motor, float command) {
+        if (command < 0.0f) command = 0.0f;
+        if (command > 1.0f) command = 1.0f;
+        motorCommand[motor] = command;
+    }
+
+    // Par externo (ráfaga, golpe) en ejes del cuerpo
+    void setDisturbance(float roll, float pitch, float yaw) {
+        disturbance[0] = roll;
+        disturbance[1] = pitch;
+        disturbance[2] = yaw;
+    }
+
+    void step(float dt) {
+        float thrust = 0.0f;
+        float torque[3] = { disturbance[0], disturbance[1], disturbance[2] };
+        for (int i = 0; i < motorCount; i++) {
+            motorSpeed[i] += (motorCommand[i] - motorSpeed[i]) * (dt / params.motorTimeConstant);
+            float w = motorSpeed[i];
+            float motorThrust = params.maxThrust * ((1.0f - params.thrustQuadratic) * w + params.thrustQuadratic * w * w);
+            thrust += motorThrust;
+            torque[0] += geometry[i].roll * params.armLever * motorThrust;
+            torque[1] += geometry[i].pitch * params.armLever * motorThrust;
+            torque[2] += geometry[i].yaw * params.yawTorquePerThrust * motorThrust;
+        }
+
+        // Fuerzas en el mundo: empuje a lo largo del eje z del cuerpo y rozamiento
+        float bodyThrust[3] = { 0.0f, 0.0f, thrust };
+        float force[3];
+        bodyToWorld(bodyThrust, force);
+        for (int axis = 0; axis < 3; axis++) {
+            force[axis] -= params.linearDrag * velocity[axis];
+        }
+
+        // En el suelo, mientras el empuje no levante el peso, todo queda quieto
+        if (grounded && force[2] <= params.mass * gravity) {
+            for (int axis = 0; axis < 3; axis++) {
+                rates[axis] = velocity[axis] = 0.0f;
+            }
+            float up[3] = { 0.0f, 0.0f, gravity };
+            worldToBody(up, specificForce);
+            return;
+        }
+        grounded = false;
+
+        float accel[3] = { force[0] / params.mass, force[1] / params.mass, force[2] / params.mass - gravity };
+        for (int axis = 0; axis < 3; axis++) {
+            velocity[axis] += accel[axis] * dt;
+            position[axis] += velocity[axis] * dt;
+        }
+
+        // El acelerómetro mide la aceleración menos la gravedad
+        float measured[3] = { accel[0], accel[1], accel[2] + gravity };
+        worldToBody(measured, specificForce);
+
+        // Ecuaciones de Euler con inercia diagonal
+        const float* inertia = params.inertia;
+        float gyroscopic[3] = {
+            (inertia[1] - inertia[2]) * rates[1] * rates[2],
+            (inertia[2] - inertia[0]) * rates[2] * rates[0],
+            (inertia[0] - inertia[1]) * rates[0] * rates[1],
+        };
+        for (int axis = 0; axis < 3; axis++) {
+            float net = torque[axis] - params.angularDrag * rates[axis] + gyroscopic[axis];
+            rates[axis] += net / inertia[axis] * dt;
+        }
+
+        // Integración del cuaternión
+        float half = 0.5f * dt;
+        float w = q[0], x = q[1], y = q[2], z = q[3];
+        q[0] += (-x * rates[0] - y * rates[1] - z * rates[2]) * half;
+        q[1] += (w * rates[0] + y * rates[2] - z * rates[1]) * half;
+        q[2] += (w * rates[1] - x * rates[2] + z * rates[0]) * half;
+        q[3] += (w * rates[2] + x * rates[1] - y * rates[0]) * half;
+        float norm = 1.0f / sqrtf(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        for (int i = 0; i < 4; i++) q[i] *= norm;
+
+        // Aterrizaje: se apoya y se nivela
+        if (position[2] <= 0.0f && velocity[2] <= 0.0f) {
+            position[2] = 0.0f;
+            grounded = true;
+            q[0] = 1.0f;
+            q[1] = q[2] = q[3] = 0.0f;
+        }
+    }
+
+    // Lecturas del sensor con ruido y sesgo, en grados/s y en g
+    void readGyro(float dps[3]) {
+        for (int axis = 0; axis < 3; axis++) {
+            dps[axis] = rates[axis] * 57.29578f + params.gyroBiasDps[axis] + params.gyroNoiseDps * gaussian();
+        }
+    }
+
+    void readAccel(float g[3]) {
+        float force[3];
+        const float up[3] = { 0.0f, 0.0f, gravity };
+        if (params.idealAccel) {
+            worldToBody(up, force);
+        } else {
+            memcpy(force, specificForce, sizeof(force));
+        }
+        for (int axis = 0; axis < 3; axis++) {
+            g[axis] = force[axis] / gravity + params.accelNoiseG * gaussian();
+        }
+    }
+
+    // Actitud real con las mismas fórmulas que los estimadores (grados)
+    float getRoll() const {
+        return atan2f(2.0f * (q[0] * q[1] + q[2] * q[3]), 1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2])) * 57.29578f;
+    }
+    float getPitch() const {
+        float s = 2.0f * (q[0] * q[2] - q[3] * q[1]);
+        if (s > 1.0f) s = 1.0f;
+        if (s < -1.0f) s = -1.0f;
+        return asinf(s) * 57.29578f;
+    }
+    float getRate(int axis) const { return rates[axis] * 57.29578f; }
+    float getAltitude() const { return position[2]; }
+    float getVerticalSpeed() const { return velocity[2]; }
+    bool isGrounded() const { return grounded; }
+    float getMotorSpeed(int motor) const { return motorSpeed[motor]; }
+
+    // Mando por motor que equilibra el peso (para comprobar el throttle de vuelo)
+    float hoverCommand() const {
+        float share = params.mass * gravity / (motorCount * params.maxThrust);
+        float a = params.thrustQuadratic;
+        return (sqrtf((1.0f - a) * (1.0f - a) + 4.0f * a * share) - (1.0f - a)) / (2.0f * a);
+    }
+};
+
+#endif
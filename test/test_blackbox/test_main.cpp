@@ -0,0 +1,307 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "BlackboxEncoder.h"
+#include "BlackboxWriter.h"
+#include "FileFlashStore.h"
+#include "Scheduler.h"
+#include "config.h"
+
+static const char* const IMAGE_PATH = "test_blackbox.bin";
+static const size_t IMAGE_SIZE = 64 * 1024;
+static const size_t SECTOR_SIZE = 4096;
+
+static uint8_t ringStorage[32 * 1024];
+static SpscByteRing ring;
+static uint8_t image[IMAGE_SIZE];
+
+static uint32_t rngState;
+
+static uint32_t randomWord() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return rngState >> 8;
+}
+
+static size_t drain(BlackboxWriter& writer) {
+    size_t steps = 0;
+    while (writer.writeStep()) steps++;
+    return steps;
+}
+
+static void readImage(FileFlashStore& flash) {
+    TEST_ASSERT_TRUE(flash.read(0, image, IMAGE_SIZE));
+}
+
+static uint32_t readVarint(const uint8_t* data, size_t& pos) {
+    uint32_t value = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        uint8_t byte = data[pos++];
+        value |= (uint32_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) break;
+    }
+    return value;
+}
+
+// Sesión de registros con campos pseudoaleatorios; deja una copia en `fields`
+static void pushSession(BlackboxEncoder& encoder, int32_t (*fields)[BLACKBOX_FIELD_COUNT], int records) {
+    uint8_t buffer[BLACKBOX_MAX_RECORD + 8 + BLACKBOX_FIELD_COUNT * 20];
+    size_t length = BlackboxEncoder::writeHeader(buffer, sizeof(buffer), 500);
+    TEST_ASSERT_GREATER_THAN(0, length);
+    TEST_ASSERT_TRUE(ring.push(buffer, length));
+
+    encoder.forceKeyframe();
+    for (int n = 0; n < records; n++) {
+        for (int f = 0; f < BLACKBOX_FIELD_COUNT; f++) {
+            // Valores pequeños y algún salto grande para probar los deltas
+            int32_t step = (int32_t)(randomWord() % 64) - 32;
+            int32_t previous = n > 0 ? fields[n - 1][f] : 0;
+            fields[n][f] = (randomWord() % 50 == 0) ? (int32_t)(randomWord() << 8) : previous + step;
+        }
+        length = encoder.encode(fields[n], buffer);
+        TEST_ASSERT_TRUE(ring.push(buffer, length));
+    }
+}
+
+// Decodifica una sesión desde `pos` como lo hace tools/blackbox_decode.py
+static int decodeSession(const uint8_t* data, size_t& pos, int32_t (*fields)[BLACKBOX_FIELD_COUNT], int maxRecords) {
+    TEST_ASSERT_EQUAL_MEMORY(BLACKBOX_MAGIC, data + pos, 4);
+    TEST_ASSERT_EQUAL_UINT8(BLACKBOX_VERSION, data[pos + 4]);
+    TEST_ASSERT_EQUAL_UINT8(BLACKBOX_FIELD_COUNT, data[pos + 5]);
+    TEST_ASSERT_EQUAL_UINT16(500, data[pos + 6] | (data[pos + 7] << 8));
+    pos += 8;
+    for (int f = 0; f < BLACKBOX_FIELD_COUNT; f++) {
+        pos += strlen((const char*)data + pos) + 1;
+    }
+
+    int count = 0;
+    int32_t previous[BLACKBOX_FIELD_COUNT] = { 0 };
+    while (count < maxRecords && (data[pos] == BLACKBOX_KEYFRAME || data[pos] == BLACKBOX_DELTA)) {
+        bool keyframe = data[pos++] == BLACKBOX_KEYFRAME;
+        for (int f = 0; f < BLACKBOX_FIELD_COUNT; f++) {
+            uint32_t zigzag = readVarint(data, pos);
+            int32_t value = (int32_t)((zigzag >> 1) ^ (0u - (zigzag & 1)));
+            previous[f] = keyframe ? value : (int32_t)((uint32_t)previous[f] + (uint32_t)value);
+            fields[count][f] = previous[f];
+        }
+        count++;
+    }
+    return count;
+}
+
+void setUp(void) {
+    remove(IMAGE_PATH);
+    TEST_ASSERT_TRUE(ring.attach(ringStorage, sizeof(ringStorage)));
+    rngState = 99;
+}
+
+void tearDown(void) {
+    remove(IMAGE_PATH);
+}
+
+void test_write_steps_are_single_pages(void) {
+    FileFlashStore flash(IMAGE_PATH, IMAGE_SIZE, SECTOR_SIZE);
+    BlackboxWriter writer;
+    TEST_ASSERT_TRUE(writer.begin(flash, ring));
+    TEST_ASSERT_EQUAL_size_t(0, writer.getUsedBytes());
+    TEST_ASSERT_FALSE(writer.writeStep());
+
+    // Un trozo que no empieza ni acaba en límite de página
+    uint8_t data[1000];
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 7 + 1);
+    TEST_ASSERT_TRUE(ring.push(data, 100));
+    TEST_ASSERT_EQUAL_size_t(1, drain(writer));
+    TEST_ASSERT_TRUE(ring.push(data + 100, sizeof(data) - 100));
+    TEST_ASSERT_EQUAL_size_t(4, drain(writer));
+
+    TEST_ASSERT_EQUAL_size_t(sizeof(data), writer.getUsedBytes());
+    TEST_ASSERT_EQUAL_size_t(BLACKBOX_PAGE_SIZE, flash.largestWrite);
+    TEST_ASSERT_FALSE(flash.crossedPage);
+    TEST_ASSERT_FALSE(flash.programmedZeroBit);
+
+    readImage(flash);
+    TEST_ASSERT_EQUAL_MEMORY(data, image, sizeof(data));
+    TEST_ASSERT_EQUAL_HEX8(0xFF, image[sizeof(data)]);
+}
+
+void test_sessions_round_trip_through_flash(void) {
+    static int32_t written[2][200][BLACKBOX_FIELD_COUNT];
+    static int32_t decoded[200][BLACKBOX_FIELD_COUNT];
+    BlackboxEncoder encoder(BLACKBOX_KEYFRAME_INTERVAL);
+
+    {
+        FileFlashStore flash(IMAGE_PATH, IMAGE_SIZE, SECTOR_SIZE);
+        BlackboxWriter writer;
+        TEST_ASSERT_TRUE(writer.begin(flash, ring));
+        pushSession(encoder, written[0], 200);
+        drain(writer);
+        TEST_ASSERT_EQUAL_UINT32(0, writer.getWriteErrors());
+    }
+
+    // Tras un reinicio se continúa en el sector siguiente al último usado
+    {
+        FileFlashStore flash(IMAGE_PATH, IMAGE_SIZE, SECTOR_SIZE);
+        BlackboxWriter writer;
+        TEST_ASSERT_TRUE(writer.begin(flash, ring));
+        size_t resume = writer.getUsedBytes();
+        TEST_ASSERT_EQUAL_size_t(0, resume % SECTOR_SIZE);
+        TEST_ASSERT_GREATER_THAN(0, resume);
+
+        pushSession(encoder, written[1], 200);
+        drain(writer);
+        TEST_ASSERT_FALSE(flash.programmedZeroBit);
+        readImage(flash);
+
+        size_t pos = 0;
+        TEST_ASSERT_EQUAL_INT(200, decodeSession(image, pos, decoded, 200));
+        TEST_ASSERT_EQUAL_INT32_ARRAY(&written[0][0][0], &decoded[0][0], 200 * BLACKBOX_FIELD_COUNT);
+
+        pos = resume;
+        TEST_ASSERT_EQUAL_INT(200, decodeSession(image, pos, decoded, 200));
+        TEST_ASSERT_EQUAL_INT32_ARRAY(&written[1][0][0], &decoded[0][0], 200 * BLACKBOX_FIELD_COUNT);
+        TEST_ASSERT_EQUAL_HEX8(0xFF, image[pos]);
+    }
+}
+
+void test_erase_is_stepped_and_only_when_disarmed(void) {
+    FileFlashStore flash(IMAGE_PATH, IMAGE_SIZE, SECTOR_SIZE);
+    BlackboxWriter writer;
+    TEST_ASSERT_TRUE(writer.begin(flash, ring));
+
+    uint8_t data[BLACKBOX_PAGE_SIZE];
+    memset(data, 0x5A, sizeof(data));
+    for (int i = 0; i < 40; i++) {
+        TEST_ASSERT_TRUE(ring.push(data, sizeof(data)));
+        drain(writer);
+    }
+    TEST_ASSERT_EQUAL_size_t(40 * BLACKBOX_PAGE_SIZE, writer.getUsedBytes());
+
+    TEST_ASSERT_FALSE(writer.eraseStep(false));
+    writer.requestErase();
+    TEST_ASSERT_TRUE(writer.isErasing());
+
+    // Armado no se borra ni se escribe nada
+    TEST_ASSERT_TRUE(ring.push(data, sizeof(data)));
+    TEST_ASSERT_FALSE(writer.eraseStep(true));
+    TEST_ASSERT_FALSE(writer.writeStep());
+    TEST_ASSERT_EQUAL_INT(0, flash.eraseCount);
+
+    // 40 páginas = 2.5 sectores: tres borrados y un paso de cierre
+    int steps = 0;
+    while (writer.eraseStep(false)) steps++;
+    TEST_ASSERT_EQUAL_INT(4, steps);
+    TEST_ASSERT_EQUAL_INT(3, flash.eraseCount);
+    TEST_ASSERT_FALSE(writer.isErasing());
+    TEST_ASSERT_EQUAL_UINT32(1, writer.getEraseCount());
+    TEST_ASSERT_EQUAL_size_t(0, writer.getUsedBytes());
+    TEST_ASSERT_EQUAL_size_t(0, ring.size());
+
+    readImage(flash);
+    for (size_t i = 0; i < IMAGE_SIZE; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0xFF, image[i]);
+    }
+
+    // Se vuelve a escribir desde el principio
+    TEST_ASSERT_TRUE(ring.push(data, sizeof(data)));
+    TEST_ASSERT_TRUE(writer.writeStep());
+    TEST_ASSERT_EQUAL_size_t(sizeof(data), writer.getUsedBytes());
+    TEST_ASSERT_FALSE(flash.programmedZeroBit);
+}
+
+void test_full_partition_discards_pending_data(void) {
+    FileFlashStore flash(IMAGE_PATH, 2 * SECTOR_SIZE, SECTOR_SIZE);
+    BlackboxWriter writer;
+    TEST_ASSERT_TRUE(writer.begin(flash, ring));
+
+    uint8_t data[1024];
+    memset(data, 0x11, sizeof(data));
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_TRUE(ring.push(data, sizeof(data)));
+    }
+    drain(writer);
+
+    TEST_ASSERT_TRUE(writer.isFull());
+    TEST_ASSERT_EQUAL_size_t(2 * SECTOR_SIZE, writer.getUsedBytes());
+    TEST_ASSERT_EQUAL_size_t(0, ring.size());
+    TEST_ASSERT_EQUAL_UINT32(0, writer.getWriteErrors());
+
+    // Un registro lleno al arrancar se reconoce como tal
+    BlackboxWriter reopened;
+    TEST_ASSERT_TRUE(reopened.begin(flash, ring));
+    TEST_ASSERT_TRUE(reopened.isFull());
+}
+
+// Planificador de comunicaciones con las tareas y presupuestos de config.h
+static uint32_t fakeNowUs;
+static BlackboxWriter* scheduledWriter;
+static bool scheduledArmed;
+
+static uint32_t fakeClock() {
+    return fakeNowUs;
+}
+
+static void inputJob(void* context) {
+    (void)context;
+    fakeNowUs += 50;
+}
+
+static void flushJob(void* context) {
+    (void)context;
+    if (scheduledWriter->writeStep()) fakeNowUs += 500;  // Programar una página
+}
+
+static void eraseJob(void* context) {
+    (void)context;
+    if (scheduledWriter->eraseStep(scheduledArmed)) fakeNowUs += 45000;  // Borrar un sector
+}
+
+static void runTicks(Scheduler& scheduler, int ticks) {
+    for (int n = 0; n < ticks; n++) {
+        while (!scheduler.poll()) fakeNowUs += 10;
+    }
+}
+
+void test_scheduled_flush_and_erase_make_progress(void) {
+    FileFlashStore flash(IMAGE_PATH, IMAGE_SIZE, SECTOR_SIZE);
+    BlackboxWriter writer;
+    TEST_ASSERT_TRUE(writer.begin(flash, ring));
+    scheduledWriter = &writer;
+    scheduledArmed = false;
+    fakeNowUs = 0;
+
+    Scheduler scheduler(fakeClock, COMMS_TICK_US);
+    scheduler.addTask("entrada", inputJob, nullptr, 0, SCHEDULER_PRIORITY_CRITICAL, COMMS_TICK_US);
+    int flushTask = scheduler.addTask("blackboxFlash", flushJob, nullptr, BLACKBOX_FLUSH_PERIOD_US,
+                                      4, BLACKBOX_FLUSH_BUDGET_US);
+    scheduler.addTask("blackboxBorrado", eraseJob, nullptr, 0,
+                      SCHEDULER_PRIORITY_CRITICAL, BLACKBOX_ERASE_BUDGET_US);
+
+    uint8_t data[8 * BLACKBOX_PAGE_SIZE];
+    memset(data, 0x42, sizeof(data));
+    TEST_ASSERT_TRUE(ring.push(data, sizeof(data)));
+
+    // El presupuesto de una página cabe en el tick: no se aplaza siempre
+    runTicks(scheduler, 20);
+    TEST_ASSERT_EQUAL_size_t(sizeof(data), writer.getUsedBytes());
+    TEST_ASSERT_EQUAL_size_t(0, ring.size());
+    TEST_ASSERT_GREATER_OR_EQUAL(8, scheduler.getTask(flushTask).runCount);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getTask(flushTask).overrunCount);
+
+    // El borrado dura mucho más que un tick y aun así avanza
+    writer.requestErase();
+    runTicks(scheduler, 5);
+    TEST_ASSERT_FALSE(writer.isErasing());
+    TEST_ASSERT_EQUAL_INT(1, flash.eraseCount);
+    TEST_ASSERT_EQUAL_size_t(0, writer.getUsedBytes());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_write_steps_are_single_pages);
+    RUN_TEST(test_sessions_round_trip_through_flash);
+    RUN_TEST(test_erase_is_stepped_and_only_when_disarmed);
+    RUN_TEST(test_full_partition_discards_pending_data);
+    RUN_TEST(test_scheduled_flush_and_erase_make_progress);
+    return UNITY_END();
+}
@@ -0,0 +1,294 @@
+#include <unity.h>
+#include <string.h>
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+#include "CommandParser.h"
+
+// Generador congruencial: las mismas entradas en cada ejecución
+static uint32_t randomState;
+
+static uint32_t nextRandom() {
+    randomState = randomState * 1664525u + 1013904223u;
+    return randomState >> 8;
+}
+
+// Trama completa en el cable: delimitador de apertura, COBS y delimitador final
+static size_t makeFrame(uint16_t sequence, int16_t throttle, int16_t roll, uint8_t flags, uint8_t* output) {
+    CommandFrame frame = {};
+    frame.type = COMMAND_FRAME_STICKS;
+    frame.sequence = sequence;
+    frame.throttle = throttle;
+    frame.roll = roll;
+    frame.pitch = -roll;
+    frame.yaw = roll / 2;
+    frame.flags = flags;
+    output[0] = FRAME_DELIMITER;
+    return 1 + encodeFrame((const uint8_t*)&frame, sizeof(frame), output + 1);
+}
+
+static size_t feedFrame(CommandParser& parser, uint16_t sequence, uint8_t flags, uint32_t nowUs = 0) {
+    uint8_t wire[64];
+    char keys[64];
+    size_t length = makeFrame(sequence, 500, 0, flags, wire);
+    return parser.feed(wire, length, nowUs, keys, sizeof(keys));
+}
+
+static size_t feedText(CommandParser& parser, const char* text, uint32_t nowUs, char* keys, size_t maxKeys) {
+    return parser.feed((const uint8_t*)text, strlen(text), nowUs, keys, maxKeys);
+}
+
+void setUp(void) {
+    randomState = 12345;
+}
+
+void tearDown(void) {
+}
+
+void test_frame_decodes_sticks(void) {
+    CommandParser parser;
+    uint8_t wire[64];
+    char keys[8];
+    size_t length = makeFrame(7, 655, -1200, COMMAND_FLAG_ACRO, wire);
+    TEST_ASSERT_EQUAL_UINT32(0, parser.feed(wire, length, 0, keys, sizeof(keys)));
+
+    StickCommand command;
+    TEST_ASSERT_TRUE(parser.takeCommand(command));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 65.5f, command.throttle);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, -100.0f, command.rollCmd);  // Saturado
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 100.0f, command.pitchCmd);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, -60.0f, command.yawCmd);
+    TEST_ASSERT_TRUE(command.acroMode);
+    TEST_ASSERT_TRUE(command.disarmCmd);
+    TEST_ASSERT_FALSE(command.armCmd);
+    TEST_ASSERT_FALSE(parser.takeCommand(command));
+    TEST_ASSERT_EQUAL_UINT32(1, parser.getValidFrames());
+}
+
+void test_sequence_stale_lost_and_restart(void) {
+    CommandParser parser;
+    feedFrame(parser, 100, 0);
+    feedFrame(parser, 100, 0);    // Duplicada
+    feedFrame(parser, 90, 0);     // Desordenada
+    feedFrame(parser, 104, 0);    // Faltan 101-103
+    TEST_ASSERT_EQUAL_UINT32(2, parser.getValidFrames());
+    TEST_ASSERT_EQUAL_UINT32(2, parser.getStaleFrames());
+    TEST_ASSERT_EQUAL_UINT32(3, parser.getLostFrames());
+
+    // Muy por detrás: el emisor se ha reiniciado
+    feedFrame(parser, 1, 0);
+    TEST_ASSERT_EQUAL_UINT32(3, parser.getValidFrames());
+
+    // La secuencia da la vuelta sin contarse como desordenada
+    CommandParser wrapping;
+    feedFrame(wrapping, 0xFFFF, 0);
+    feedFrame(wrapping, 0x0000, 0);
+    TEST_ASSERT_EQUAL_UINT32(2, wrapping.getValidFrames());
+    TEST_ASSERT_EQUAL_UINT32(0, wrapping.getStaleFrames());
+    TEST_ASSERT_EQUAL_UINT32(0, wrapping.getLostFrames());
+}
+
+void test_arm_needs_switch_seen_low(void) {
+    CommandParser parser;
+    StickCommand command;
+
+    // Primera trama tras el arranque con el interruptor ya subido: no arma
+    feedFrame(parser, 1, COMMAND_FLAG_ARM);
+    TEST_ASSERT_TRUE(parser.takeCommand(command));
+    TEST_ASSERT_FALSE(command.armCmd);
+    TEST_ASSERT_FALSE(command.disarmCmd);
+    feedFrame(parser, 2, COMMAND_FLAG_ARM);
+    TEST_ASSERT_TRUE(parser.takeCommand(command));
+    TEST_ASSERT_FALSE(command.armCmd);
+
+    // Bajado y subido: ahora sí es un flanco
+    feedFrame(parser, 3, 0);
+    TEST_ASSERT_TRUE(parser.takeCommand(command));
+    TEST_ASSERT_TRUE(command.disarmCmd);
+    feedFrame(parser, 4, COMMAND_FLAG_ARM);
+    TEST_ASSERT_TRUE(parser.takeCommand(command));
+    TEST_ASSERT_TRUE(command.armCmd);
+
+    // Con la parada de emergencia no hay flanco
+    feedFrame(parser, 5, 0);
+    feedFrame(parser, 6, COMMAND_FLAG_ARM | COMMAND_FLAG_KILL);
+    TEST_ASSERT_TRUE(parser.takeCommand(command));
+    TEST_ASSERT_FALSE(command.armCmd);
+    TEST_ASSERT_TRUE(command.kill);
+    TEST_ASSERT_TRUE(command.disarmCmd);
+}
+
+void test_arm_edge_survives_later_frames_in_block(void) {
+    CommandParser parser;
+    uint8_t wire[256];
+    char keys[8];
+    size_t length = 0;
+    length += makeFrame(1, 0, 0, 0, wire + length);
+    length += makeFrame(2, 0, 0, COMMAND_FLAG_ARM, wire + length);
+    length += makeFrame(3, 0, 0, COMMAND_FLAG_ARM, wire + length);
+    parser.feed(wire, length, 0, keys, sizeof(keys));
+
+    StickCommand command;
+    TEST_ASSERT_TRUE(parser.takeCommand(command));
+    TEST_ASSERT_TRUE(command.armCmd);
+    TEST_ASSERT_EQUAL_UINT32(3, parser.getValidFrames());
+}
+
+void test_keys_pass_without_link(void) {
+    CommandParser parser;
+    char keys[16];
+    size_t count = feedText(parser, "wrx$a", 0, keys, sizeof(keys));
+    TEST_ASSERT_EQUAL_UINT32(3, count);
+    TEST_ASSERT_EQUAL_MEMORY("wrx", keys, 3);
+
+    // La línea '$' sale entera al terminar, aunque llegue en varios bloques
+    count = feedText(parser, "b\nw", 0, keys, sizeof(keys));
+    TEST_ASSERT_EQUAL_UINT32(5, count);
+    TEST_ASSERT_EQUAL_MEMORY("$ab\nw", keys, 5);
+    TEST_ASSERT_EQUAL_UINT32(0, parser.getDroppedKeys());
+}
+
+void test_link_blocks_keys_but_not_console(void) {
+    CommandParser parser;
+    char keys[32];
+    feedFrame(parser, 1, 0, 1000);
+
+    // Teclas de vuelo descartadas mientras el enlace binario está activo
+    TEST_ASSERT_EQUAL_UINT32(0, feedText(parser, "rRixm", 2000, keys, sizeof(keys)));
+    TEST_ASSERT_EQUAL_UINT32(5, parser.getDroppedKeys());
+
+    // Las líneas de la consola pasan enteras, aunque lleven teclas de vuelo
+    size_t count = feedText(parser, "$kp_roll r\nr", 3000, keys, sizeof(keys));
+    TEST_ASSERT_EQUAL_UINT32(11, count);
+    TEST_ASSERT_EQUAL_MEMORY("$kp_roll r\n", keys, 11);
+    TEST_ASSERT_EQUAL_UINT32(6, parser.getDroppedKeys());
+
+    // Una línea con bytes binarios o cortada por una trama no se entrega
+    const uint8_t binary[] = { '$', 'a', 0x81, 'r', '\n' };
+    TEST_ASSERT_EQUAL_UINT32(0, parser.feed(binary, sizeof(binary), 3000, keys, sizeof(keys)));
+    TEST_ASSERT_EQUAL_UINT32(0, feedText(parser, "$set", 3000, keys, sizeof(keys)));
+    feedFrame(parser, 2, 0, 3000);
+    TEST_ASSERT_EQUAL_UINT32(0, feedText(parser, " x 1\n", 3000, keys, sizeof(keys)));
+
+    // Sin tramas durante el bloqueo el teclado vuelve a mandar
+    TEST_ASSERT_EQUAL_UINT32(0, feedText(parser, "r", 3000 + COMMAND_KEY_LOCKOUT_US - 1, keys, sizeof(keys)));
+    TEST_ASSERT_EQUAL_UINT32(1, feedText(parser, "r", 3000 + COMMAND_KEY_LOCKOUT_US, keys, sizeof(keys)));
+}
+
+void test_lost_delimiter_does_not_leak_keys(void) {
+    CommandParser parser;
+    uint8_t wire[64];
+    char keys[64];
+    feedFrame(parser, 1, 0, 0);
+
+    // Se pierde el delimitador de apertura de cada trama: el cuerpo queda
+    // fuera de trama y su cierre abre la trama siguiente
+    size_t totalKeys = 0;
+    for (uint16_t sequence = 2; sequence < 200; sequence++) {
+        size_t length = makeFrame(sequence, (int16_t)(nextRandom() % 1000), (int16_t)(nextRandom() % 2000 - 1000),
+                                  COMMAND_FLAG_ARM, wire);
+        totalKeys += parser.feed(wire + 1, length - 1, sequence * 20000u, keys, sizeof(keys));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, totalKeys);
+}
+
+void test_fuzz_random_and_corrupted_input(void) {
+    CommandParser parser;
+    uint8_t wire[512];
+    char keys[512];
+    StickCommand command;
+    uint16_t sequence = 1;
+
+    for (int round = 0; round < 20000; round++) {
+        size_t length;
+        bool corrupted = false;
+        switch (nextRandom() % 3) {
+        case 0: {
+            // Ruido con ceros frecuentes
+            length = 1 + nextRandom() % 64;
+            for (size_t i = 0; i < length; i++) {
+                uint32_t r = nextRandom();
+                wire[i] = (r & 7) == 0 ? 0 : (uint8_t)(r >> 3);
+            }
+            corrupted = true;
+            break;
+        }
+        case 1: {
+            // Trama con un bit cambiado: el CRC o COBS la rechazan siempre
+            length = makeFrame(sequence++, 500, 0, 0, wire);
+            size_t bit = nextRandom() % ((length - 2) * 8);
+            wire[1 + bit / 8] ^= (uint8_t)(1u << (bit % 8));
+            corrupted = true;
+            break;
+        }
+        default:
+            length = makeFrame(sequence++, 500, 0, 0, wire);
+            break;
+        }
+
+        uint32_t validBefore = parser.getValidFrames();
+        size_t count = parser.feed(wire, length, round * 1000u, keys, sizeof(keys));
+        TEST_ASSERT_TRUE(count <= length);
+        if (corrupted) {
+            // Un trozo de ruido sólo cierra la trama anterior si ésta era válida
+            TEST_ASSERT_TRUE(parser.getValidFrames() - validBefore <= 1);
+        }
+        parser.takeCommand(command);
+    }
+
+    // Tras todo el ruido, una trama limpia se decodifica
+    uint8_t clean[64];
+    size_t length = makeFrame(sequence + 100, 250, 0, 0, clean);
+    uint8_t closing = FRAME_DELIMITER;
+    parser.feed(&closing, 1, 0, keys, sizeof(keys));
+    parser.feed(clean, length, 0, keys, sizeof(keys));
+    TEST_ASSERT_TRUE(parser.takeCommand(command));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 25.0f, command.throttle);
+    TEST_ASSERT_TRUE(parser.getInvalidFrames() > 0);
+}
+
+void test_throughput_keeps_only_newest(void) {
+    const int frames = 20000;
+    std::vector<uint8_t> stream(frames * 32);
+    size_t length = 0;
+    for (int i = 0; i < frames; i++) {
+        length += makeFrame((uint16_t)(i + 1), (int16_t)(i % 1001), 0, 0, &stream[length]);
+    }
+
+    CommandParser parser;
+    char keys[64];
+    auto start = std::chrono::steady_clock::now();
+    // En bloques como los de la UART
+    for (size_t offset = 0; offset < length; offset += 64) {
+        size_t chunk = length - offset < 64 ? length - offset : 64;
+        parser.feed(&stream[offset], chunk, 0, keys, sizeof(keys));
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    TEST_ASSERT_EQUAL_UINT32(frames, parser.getValidFrames());
+    TEST_ASSERT_EQUAL_UINT32(0, parser.getInvalidFrames());
+    StickCommand command;
+    TEST_ASSERT_TRUE(parser.takeCommand(command));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, ((frames - 1) % 1001) / 10.0f, command.throttle);
+
+    char message[80];
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    snprintf(message, sizeof(message), "%.1f ns por trama, %.1f MB/s", ns / frames, length * 1000.0 / ns);
+    TEST_MESSAGE(message);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_frame_decodes_sticks);
+    RUN_TEST(test_sequence_stale_lost_and_restart);
+    RUN_TEST(test_arm_needs_switch_seen_low);
+    RUN_TEST(test_arm_edge_survives_later_frames_in_block);
+    RUN_TEST(test_keys_pass_without_link);
+    RUN_TEST(test_link_blocks_keys_but_not_console);
+    RUN_TEST(test_lost_delimiter_does_not_leak_keys);
+    RUN_TEST(test_fuzz_random_and_corrupted_input);
+    RUN_TEST(test_throughput_keeps_only_newest);
+    return UNITY_END();
+}
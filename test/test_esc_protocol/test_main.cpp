@@ -0,0 +1,104 @@
+#include <unity.h>
+#include "EscProtocol.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_dshot_known_frame(void) {
+    // Ejemplo de referencia: acelerador 1046 sin telemetría
+    TEST_ASSERT_EQUAL_HEX16(0x82C6, dshotEncodeFrame(1046, false));
+    TEST_ASSERT_EQUAL_HEX16(0x0000, dshotEncodeFrame(0, false));
+    TEST_ASSERT_EQUAL_HEX16(0x0011, dshotEncodeFrame(0, true));
+}
+
+void test_dshot_frame_fields_and_crc(void) {
+    for (uint32_t value = 0; value <= DSHOT_MAX_THROTTLE; value++) {
+        for (int telemetry = 0; telemetry < 2; telemetry++) {
+            uint16_t frame = dshotEncodeFrame((uint16_t)value, telemetry != 0);
+            TEST_ASSERT_EQUAL_UINT16(value, frame >> 5);
+            TEST_ASSERT_EQUAL_INT(telemetry, (frame >> 4) & 1);
+
+            // El CRC es la XOR de los tres nibbles de datos
+            uint16_t data = frame >> 4;
+            uint16_t crc = (data ^ (data >> 4) ^ (data >> 8)) & 0x0F;
+            TEST_ASSERT_EQUAL_UINT16(crc, frame & 0x0F);
+        }
+    }
+
+    // Los bits por encima de 11 se descartan
+    TEST_ASSERT_EQUAL_HEX16(dshotEncodeFrame(5, false), dshotEncodeFrame(0x0800 | 5, false));
+}
+
+void test_dshot_value_from_pulse(void) {
+    TEST_ASSERT_EQUAL_UINT16(0, dshotValueFromPulse(900, 1000, 2000));
+    TEST_ASSERT_EQUAL_UINT16(0, dshotValueFromPulse(1000, 1000, 2000));
+    TEST_ASSERT_EQUAL_UINT16(DSHOT_MIN_THROTTLE + 1, dshotValueFromPulse(1001, 1000, 2000));
+    TEST_ASSERT_EQUAL_UINT16(DSHOT_MAX_THROTTLE, dshotValueFromPulse(2000, 1000, 2000));
+    TEST_ASSERT_EQUAL_UINT16(DSHOT_MAX_THROTTLE, dshotValueFromPulse(2500, 1000, 2000));
+    TEST_ASSERT_EQUAL_UINT16(DSHOT_MIN_THROTTLE + 999, dshotValueFromPulse(1500, 1000, 2000));
+
+    // Nunca cae en el rango de comandos especiales (1-47) y es monótono
+    uint16_t previous = 0;
+    for (int pulse = 1001; pulse < 2000; pulse++) {
+        uint16_t value = dshotValueFromPulse(pulse, 1000, 2000);
+        TEST_ASSERT_TRUE(value >= DSHOT_MIN_THROTTLE);
+        TEST_ASSERT_TRUE(value >= previous);
+        previous = value;
+    }
+}
+
+void test_dshot_bit_ticks(void) {
+    // RMT a 80 MHz / 2 -> 25 ns por tick
+    DshotBitTicks ticks;
+    TEST_ASSERT_TRUE(dshotBitTicks(ESC_PROTOCOL_DSHOT600, 25, ticks));
+    TEST_ASSERT_EQUAL_UINT16(50, ticks.oneHigh);
+    TEST_ASSERT_EQUAL_UINT16(17, ticks.oneLow);
+    TEST_ASSERT_EQUAL_UINT16(25, ticks.zeroHigh);
+    TEST_ASSERT_EQUAL_UINT16(42, ticks.zeroLow);
+
+    TEST_ASSERT_TRUE(dshotBitTicks(ESC_PROTOCOL_DSHOT150, 25, ticks));
+    TEST_ASSERT_EQUAL_UINT16(267, ticks.oneHigh + ticks.oneLow);
+    TEST_ASSERT_EQUAL_UINT16(267, ticks.zeroHigh + ticks.zeroLow);
+
+    // Un tick demasiado grueso no distingue los bits
+    TEST_ASSERT_FALSE(dshotBitTicks(ESC_PROTOCOL_DSHOT600, 1000, ticks));
+    TEST_ASSERT_FALSE(dshotBitTicks(ESC_PROTOCOL_DSHOT600, 0, ticks));
+    TEST_ASSERT_FALSE(dshotBitTicks(ESC_PROTOCOL_PWM, 25, ticks));
+}
+
+void test_protocol_classification(void) {
+    TEST_ASSERT_FALSE(escProtocolIsDshot(ESC_PROTOCOL_PWM));
+    TEST_ASSERT_FALSE(escProtocolIsDshot(ESC_PROTOCOL_MULTISHOT));
+    TEST_ASSERT_TRUE(escProtocolIsDshot(ESC_PROTOCOL_DSHOT150));
+    TEST_ASSERT_TRUE(escProtocolIsDshot(ESC_PROTOCOL_DSHOT600));
+    TEST_ASSERT_NULL(dshotTiming(ESC_PROTOCOL_ONESHOT125));
+    TEST_ASSERT_EQUAL_UINT32(3333, dshotTiming(ESC_PROTOCOL_DSHOT300)->bitNs);
+}
+
+void test_analog_pulse_widths(void) {
+    TEST_ASSERT_EQUAL_UINT32(125000, escAnalogPulseNs(ESC_PROTOCOL_ONESHOT125, 1000, 1000, 2000));
+    TEST_ASSERT_EQUAL_UINT32(187500, escAnalogPulseNs(ESC_PROTOCOL_ONESHOT125, 1500, 1000, 2000));
+    TEST_ASSERT_EQUAL_UINT32(250000, escAnalogPulseNs(ESC_PROTOCOL_ONESHOT125, 2600, 1000, 2000));
+    TEST_ASSERT_EQUAL_UINT32(5000, escAnalogPulseNs(ESC_PROTOCOL_MULTISHOT, 800, 1000, 2000));
+    TEST_ASSERT_EQUAL_UINT32(25000, escAnalogPulseNs(ESC_PROTOCOL_MULTISHOT, 2000, 1000, 2000));
+
+    // El periodo de LEDC siempre deja sitio al pulso más largo
+    TEST_ASSERT_TRUE(1000000000u / escAnalogFrequencyHz(ESC_PROTOCOL_ONESHOT125) > 250000u);
+    TEST_ASSERT_TRUE(1000000000u / escAnalogFrequencyHz(ESC_PROTOCOL_MULTISHOT) > 25000u);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_dshot_known_frame);
+    RUN_TEST(test_dshot_frame_fields_and_crc);
+    RUN_TEST(test_dshot_value_from_pulse);
+    RUN_TEST(test_dshot_bit_ticks);
+    RUN_TEST(test_protocol_classification);
+    RUN_TEST(test_analog_pulse_widths);
+    return UNITY_END();
+}
@@ -0,0 +1,163 @@
+#include <unity.h>
+#include "Failsafe.h"
+#include "LinkMonitor.h"
+
+static const uint32_t HOLD_US = 100000;
+static const uint32_t LAND_US = 500000;
+static const uint32_t RAMP_US = 1000000;
+static const uint32_t START_US = 1000000;
+
+static Failsafe failsafe(HOLD_US, LAND_US, RAMP_US);
+
+// Tramas hasta START_US y luego silencio: evalúa el failsafe `gapUs` después
+static FailsafeState afterGap(uint32_t gapUs, bool armed = true, float throttle = 40.0f) {
+    return failsafe.update(START_US + gapUs, START_US, true, armed, throttle);
+}
+
+void setUp(void) {
+    failsafe.reset();
+}
+
+void tearDown(void) {
+}
+
+void test_fresh_link_stays_idle(void) {
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_IDLE, afterGap(0));
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_IDLE, afterGap(HOLD_US - 1));
+    TEST_ASSERT_FALSE(failsafe.isActive());
+    TEST_ASSERT_FALSE(failsafe.isLinkLost());
+}
+
+void test_keyboard_only_never_triggers(void) {
+    // Sin enlace binario activo el hueco no significa nada
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_IDLE, failsafe.update(START_US + 10 * LAND_US, 0, false, true, 40.0f));
+    TEST_ASSERT_FALSE(failsafe.isLinkLost());
+}
+
+void test_disarmed_gap_only_flags_link_lost(void) {
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_IDLE, afterGap(LAND_US, false));
+    TEST_ASSERT_TRUE(failsafe.isLinkLost());
+}
+
+void test_hold_keeps_last_throttle(void) {
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_HOLD, afterGap(HOLD_US, true, 42.0f));
+    TEST_ASSERT_TRUE(failsafe.isActive());
+    TEST_ASSERT_TRUE(failsafe.isLinkLost());
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, failsafe.getThrottle());
+
+    // El throttle del piloto ya no cuenta
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_HOLD, afterGap(LAND_US - 1, true, 90.0f));
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, failsafe.getThrottle());
+}
+
+void test_hold_recovers_when_link_returns(void) {
+    afterGap(HOLD_US);
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_IDLE, failsafe.update(START_US + 200000, START_US + 190000, true, true, 40.0f));
+    TEST_ASSERT_FALSE(failsafe.isActive());
+    TEST_ASSERT_FALSE(failsafe.isLinkLost());
+}
+
+void test_landing_ramps_throttle_to_zero_then_disarms(void) {
+    afterGap(HOLD_US, true, 40.0f);
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_LANDING, afterGap(LAND_US));
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, failsafe.getThrottle());
+
+    afterGap(LAND_US + RAMP_US / 4);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 30.0f, failsafe.getThrottle());
+    afterGap(LAND_US + RAMP_US / 2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 20.0f, failsafe.getThrottle());
+
+    // Una trama a mitad de la rampa no la interrumpe
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_LANDING,
+                          failsafe.update(START_US + LAND_US + 600000, START_US + LAND_US + 590000, true, true, 40.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 16.0f, failsafe.getThrottle());
+
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_DISARMED, afterGap(LAND_US + RAMP_US));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, failsafe.getThrottle());
+    TEST_ASSERT_FALSE(failsafe.isActive());
+}
+
+void test_disarming_during_landing_ends_it(void) {
+    afterGap(HOLD_US);
+    afterGap(LAND_US);
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_DISARMED, afterGap(LAND_US + 1000, false));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, failsafe.getThrottle());
+}
+
+void test_disarmed_needs_link_and_disarm_to_clear(void) {
+    afterGap(HOLD_US);
+    afterGap(LAND_US);
+    afterGap(LAND_US + RAMP_US);
+    uint32_t now = START_US + LAND_US + RAMP_US;
+
+    // Vuelve el enlace pero el control sigue armado: no se libera
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_DISARMED, failsafe.update(now + 1000, now + 1000, true, true, 0.0f));
+    // Desarmado pero sin enlace: tampoco
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_DISARMED, failsafe.update(now + 2000, START_US, true, false, 0.0f));
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_IDLE, failsafe.update(now + 3000, now + 3000, true, false, 0.0f));
+}
+
+void test_frame_newer_than_clock_counts_as_fresh(void) {
+    // La tarea de comunicaciones marca una trama después de leer el reloj
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_IDLE, failsafe.update(START_US, START_US + 50, true, true, 40.0f));
+    TEST_ASSERT_FALSE(failsafe.isLinkLost());
+}
+
+void test_clock_wraparound(void) {
+    const uint32_t last = 0xFFFFFFFFu - 20000;
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_IDLE, failsafe.update(last + 50000, last, true, true, 40.0f));
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_HOLD, failsafe.update(last + HOLD_US, last, true, true, 40.0f));
+}
+
+void test_land_threshold_is_never_before_hold(void) {
+    Failsafe inverted(HOLD_US, HOLD_US / 2, RAMP_US);
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_HOLD, inverted.update(START_US + HOLD_US, START_US, true, true, 40.0f));
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_LANDING, inverted.update(START_US + HOLD_US, START_US, true, true, 40.0f));
+}
+
+void test_link_monitor_feeds_failsafe(void) {
+    LinkMonitor link(50000);
+    TEST_ASSERT_FALSE(link.isActive());
+
+    // Tramas a 50 Hz durante un segundo y medio, con un hueco de 80 ms
+    uint32_t now = START_US;
+    for (int i = 0; i < 75; i++) {
+        now += (i == 40) ? 80000 : 20000;
+        link.onFrame(now);
+        link.update(now);
+        TEST_ASSERT_EQUAL_INT(FAILSAFE_IDLE,
+                              failsafe.update(now, link.getLastFrameTime(), link.isActive(), true, 40.0f));
+    }
+    TEST_ASSERT_TRUE(link.isActive());
+    TEST_ASSERT_EQUAL_UINT32(75, link.getFrameCount());
+    TEST_ASSERT_EQUAL_UINT32(80000, link.getMaxGapUs());
+    TEST_ASSERT_EQUAL_UINT32(1, link.getDropoutCount());
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 49.0f, link.getRateHz());
+
+    // Se corta: HOLD al pasar el umbral
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_HOLD,
+                          failsafe.update(now + HOLD_US, link.getLastFrameTime(), link.isActive(), true, 40.0f));
+
+    link.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, link.getMaxGapUs());
+    TEST_ASSERT_EQUAL_UINT32(0, link.getDropoutCount());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_fresh_link_stays_idle);
+    RUN_TEST(test_keyboard_only_never_triggers);
+    RUN_TEST(test_disarmed_gap_only_flags_link_lost);
+    RUN_TEST(test_hold_keeps_last_throttle);
+    RUN_TEST(test_hold_recovers_when_link_returns);
+    RUN_TEST(test_landing_ramps_throttle_to_zero_then_disarms);
+    RUN_TEST(test_disarming_during_landing_ends_it);
+    RUN_TEST(test_disarmed_needs_link_and_disarm_to_clear);
+    RUN_TEST(test_frame_newer_than_clock_counts_as_fresh);
+    RUN_TEST(test_clock_wraparound);
+    RUN_TEST(test_land_threshold_is_never_before_hold);
+    RUN_TEST(test_link_monitor_feeds_failsafe);
+    return UNITY_END();
+}
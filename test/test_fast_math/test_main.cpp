@@ -0,0 +1,66 @@
+#include <unity.h>
+#include <math.h>
+#include "FastMath.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_inv_sqrt_relative_error(void) {
+    double worst = 0.0;
+    for (int i = 1; i < 200000; i++) {
+        float x = i * 1e-3f * (1 + i % 7);
+        double error = fabs(fastInvSqrt(x) * sqrt((double)x) - 1.0);
+        if (error > worst) worst = error;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(5e-6, 0.0, worst);
+}
+
+void test_sqrt_handles_zero_and_negative(void) {
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, fastSqrt(0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, fastSqrt(-4.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 3.0f, fastSqrt(9.0f));
+}
+
+void test_atan2_all_quadrants(void) {
+    double worst = 0.0;
+    for (int i = -200; i <= 200; i++) {
+        for (int j = -200; j <= 200; j++) {
+            if (i == 0 && j == 0) continue;
+            float y = i * 0.05f;
+            float x = j * 0.05f;
+            double error = fabs(fastAtan2(y, x) - atan2((double)y, (double)x));
+            if (error > worst) worst = error;
+        }
+    }
+    TEST_ASSERT_FLOAT_WITHIN(2e-5, 0.0, worst);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, fastAtan2(0.0f, 0.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, FAST_HALF_PI, fastAtan2(1.0f, 0.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, -FAST_HALF_PI, fastAtan2(-1.0f, 0.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, FAST_PI, fastAtan2(0.0f, -1.0f));
+}
+
+void test_asin_range_and_saturation(void) {
+    double worst = 0.0;
+    for (int i = -10000; i <= 10000; i++) {
+        float x = i * 1e-4f;
+        double error = fabs(fastAsin(x) - asin((double)x));
+        if (error > worst) worst = error;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.0, worst);
+    TEST_ASSERT_EQUAL_FLOAT(FAST_HALF_PI, fastAsin(1.5f));
+    TEST_ASSERT_EQUAL_FLOAT(-FAST_HALF_PI, fastAsin(-1.5f));
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_inv_sqrt_relative_error);
+    RUN_TEST(test_sqrt_handles_zero_and_negative);
+    RUN_TEST(test_atan2_all_quadrants);
+    RUN_TEST(test_asin_range_and_saturation);
+    return UNITY_END();
+}
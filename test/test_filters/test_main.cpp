@@ -0,0 +1,179 @@
+#include <unity.h>
+#include <math.h>
+#include "Filters.h"
+
+static const float SAMPLE_RATE = 1000.0f;
+
+// Amplitud de salida en régimen permanente para un seno unitario de `hz`
+static float measureGain(Biquad& filter, float hz) {
+    filter.reset();
+    const int samples = 8000;
+    float peak = 0.0f;
+    for (int n = 0; n < samples; n++) {
+        float y = filter.apply(sinf(2.0f * (float)M_PI * hz * n / SAMPLE_RATE));
+        if (n >= samples / 2 && fabsf(y) > peak) peak = fabsf(y);
+    }
+    return peak;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_lowpass_response(void) {
+    Biquad lowpass;
+    lowpass.setLowpass(100.0f, SAMPLE_RATE);
+
+    float y = 0.0f;
+    for (int n = 0; n < 500; n++) y = lowpass.apply(1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.0f, y);
+
+    // Butterworth (Q = 0.707) con prewarping: -3 dB justo en el corte
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 1.0f, measureGain(lowpass, 10.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.7071f, measureGain(lowpass, 100.0f));
+    TEST_ASSERT_TRUE(measureGain(lowpass, 400.0f) < 0.05f);
+}
+
+void test_notch_response(void) {
+    Biquad notch;
+    notch.setNotch(200.0f, SAMPLE_RATE, 3.0f);
+
+    TEST_ASSERT_TRUE(measureGain(notch, 200.0f) < 0.01f);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 1.0f, measureGain(notch, 40.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 1.0f, measureGain(notch, 450.0f));
+
+    float y = 0.0f;
+    for (int n = 0; n < 500; n++) y = notch.apply(1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.0f, y);
+}
+
+void test_invalid_settings_pass_through(void) {
+    Biquad filter;
+    const float inputs[] = { 0.3f, -1.0f, 7.5f };
+
+    filter.setLowpass(0.0f, SAMPLE_RATE);
+    for (float x : inputs) TEST_ASSERT_EQUAL_FLOAT(x, filter.apply(x));
+
+    filter.setLowpass(SAMPLE_RATE / 2.0f, SAMPLE_RATE);
+    for (float x : inputs) TEST_ASSERT_EQUAL_FLOAT(x, filter.apply(x));
+
+    filter.setNotch(100.0f, SAMPLE_RATE, 0.0f);
+    for (float x : inputs) TEST_ASSERT_EQUAL_FLOAT(x, filter.apply(x));
+}
+
+void test_bank_matches_single_biquads(void) {
+    BiquadBank bank;
+    bank.init(SAMPLE_RATE);
+    TEST_ASSERT_EQUAL_INT(0, bank.addLowpass(120.0f));
+    TEST_ASSERT_EQUAL_INT(1, bank.addNotch(250.0f, 4.0f));
+    TEST_ASSERT_EQUAL_INT(2, bank.getStageCount());
+
+    Biquad reference[FILTER_AXES][2];
+    for (int axis = 0; axis < FILTER_AXES; axis++) {
+        reference[axis][0].setLowpass(120.0f, SAMPLE_RATE);
+        reference[axis][1].setNotch(250.0f, SAMPLE_RATE, 4.0f);
+    }
+
+    uint32_t state = 12345;
+    for (int n = 0; n < 1000; n++) {
+        float values[FILTER_AXES];
+        float expected[FILTER_AXES];
+        for (int axis = 0; axis < FILTER_AXES; axis++) {
+            state = state * 1664525u + 1013904223u;
+            values[axis] = (float)(state >> 8) / 16777216.0f - 0.5f;
+            expected[axis] = reference[axis][1].apply(reference[axis][0].apply(values[axis]));
+        }
+        bank.apply(values);
+        for (int axis = 0; axis < FILTER_AXES; axis++) {
+            TEST_ASSERT_EQUAL_FLOAT(expected[axis], values[axis]);
+        }
+    }
+}
+
+void test_bank_rejects_disabled_and_extra_stages(void) {
+    BiquadBank bank;
+    bank.init(SAMPLE_RATE);
+    TEST_ASSERT_EQUAL_INT(-1, bank.addLowpass(0.0f));
+    TEST_ASSERT_EQUAL_INT(-1, bank.addNotch(600.0f, 3.0f));
+    TEST_ASSERT_EQUAL_INT(0, bank.getStageCount());
+
+    // Sin etapas la señal pasa intacta
+    float values[FILTER_AXES] = { 1.5f, -2.0f, 0.25f };
+    bank.apply(values);
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, values[0]);
+    TEST_ASSERT_EQUAL_FLOAT(-2.0f, values[1]);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, values[2]);
+
+    for (int i = 0; i < FILTER_MAX_STAGES; i++) {
+        TEST_ASSERT_EQUAL_INT(i, bank.addNotch(100.0f + 50.0f * i, 3.0f));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, bank.addLowpass(100.0f));
+    TEST_ASSERT_EQUAL_INT(FILTER_MAX_STAGES, bank.getStageCount());
+}
+
+void test_bank_set_notch_retunes_one_axis(void) {
+    BiquadBank bank;
+    bank.init(SAMPLE_RATE);
+    int stage = bank.addNotch(150.0f, 3.0f);
+    TEST_ASSERT_EQUAL_INT(0, stage);
+
+    // Se mueve la muesca del eje 1 a 300 Hz; índices inválidos no hacen nada
+    bank.setNotch(stage, 1, 300.0f, 3.0f);
+    bank.setNotch(stage, FILTER_AXES, 50.0f, 3.0f);
+    bank.setNotch(stage + 1, 0, 50.0f, 3.0f);
+
+    float peak[FILTER_AXES] = { 0.0f, 0.0f, 0.0f };
+    const int samples = 8000;
+    for (int n = 0; n < samples; n++) {
+        float x = sinf(2.0f * (float)M_PI * 150.0f * n / SAMPLE_RATE);
+        float values[FILTER_AXES] = { x, x, x };
+        bank.apply(values);
+        if (n < samples / 2) continue;
+        for (int axis = 0; axis < FILTER_AXES; axis++) {
+            if (fabsf(values[axis]) > peak[axis]) peak[axis] = fabsf(values[axis]);
+        }
+    }
+    TEST_ASSERT_TRUE(peak[0] < 0.01f);
+    TEST_ASSERT_TRUE(peak[1] > 0.5f);
+    TEST_ASSERT_TRUE(peak[2] < 0.01f);
+}
+
+void test_bank_retune_keeps_state_and_reset_clears_it(void) {
+    BiquadBank bank;
+    bank.init(SAMPLE_RATE);
+    bank.addLowpass(50.0f);
+
+    for (int n = 0; n < 20; n++) {
+        float values[FILTER_AXES] = { 1.0f, 1.0f, 1.0f };
+        bank.apply(values);
+    }
+
+    // Retocar la frecuencia no vacía la memoria: la salida sigue cerca de
+    // la anterior en vez de volver a arrancar desde cero
+    bank.setNotch(0, 0, 50.0f, 0.7071f);
+    float held[FILTER_AXES] = { 1.0f, 1.0f, 1.0f };
+    bank.apply(held);
+    TEST_ASSERT_TRUE(held[0] > 0.5f);
+
+    bank.reset();
+    float fresh[FILTER_AXES] = { 1.0f, 1.0f, 1.0f };
+    bank.apply(fresh);
+    TEST_ASSERT_TRUE(fresh[1] < 0.1f);
+    TEST_ASSERT_TRUE(fresh[2] < 0.1f);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_lowpass_response);
+    RUN_TEST(test_notch_response);
+    RUN_TEST(test_invalid_settings_pass_through);
+    RUN_TEST(test_bank_matches_single_biquads);
+    RUN_TEST(test_bank_rejects_disabled_and_extra_stages);
+    RUN_TEST(test_bank_set_notch_retunes_one_axis);
+    RUN_TEST(test_bank_retune_keeps_state_and_reset_clears_it);
+    return UNITY_END();
+}
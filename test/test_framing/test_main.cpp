@@ -0,0 +1,171 @@
+#include <unity.h>
+#include <string.h>
+#include "Framing.h"
+
+// Generador congruencial: las mismas entradas en cada ejecución
+static uint32_t randomState;
+
+static uint32_t nextRandom() {
+    randomState = randomState * 1664525u + 1013904223u;
+    return randomState >> 8;
+}
+
+// Datos con muchos ceros y rachas largas sin ellos, los casos frontera de COBS
+static void randomBytes(uint8_t* data, size_t length) {
+    bool zeroHeavy = nextRandom() & 1;
+    for (size_t i = 0; i < length; i++) {
+        uint32_t r = nextRandom();
+        data[i] = zeroHeavy && (r & 3) == 0 ? 0 : (uint8_t)(r >> 4);
+        if (!zeroHeavy && data[i] == 0) data[i] = 1;
+    }
+}
+
+void setUp(void) {
+    randomState = 12345;
+}
+
+void tearDown(void) {
+}
+
+void test_crc16_ccitt_check_value(void) {
+    const uint8_t check[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, crc16(check, sizeof(check)));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, crc16(check, 0));
+
+    // Se puede calcular por partes
+    uint16_t partial = crc16(check, 4);
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, crc16(check + 4, 5, partial));
+}
+
+void test_cobs_known_vectors(void) {
+    uint8_t output[8];
+    const uint8_t zero[] = { 0x00 };
+    const uint8_t expectedZero[] = { 0x01, 0x01 };
+    TEST_ASSERT_EQUAL_size_t(2, cobsEncode(zero, 1, output));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedZero, output, 2);
+
+    const uint8_t mixed[] = { 0x11, 0x22, 0x00, 0x33 };
+    const uint8_t expectedMixed[] = { 0x03, 0x11, 0x22, 0x02, 0x33 };
+    TEST_ASSERT_EQUAL_size_t(5, cobsEncode(mixed, sizeof(mixed), output));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expectedMixed, output, 5);
+
+    uint8_t decoded[8];
+    TEST_ASSERT_EQUAL_size_t(4, cobsDecode(expectedMixed, 5, decoded, sizeof(decoded)));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(mixed, decoded, 4);
+}
+
+void test_cobs_round_trip_fuzz(void) {
+    static uint8_t input[700];
+    static uint8_t encoded[COBS_MAX_ENCODED(700)];
+    static uint8_t decoded[700];
+    for (int trial = 0; trial < 3000; trial++) {
+        size_t length = 1 + nextRandom() % sizeof(input);
+        randomBytes(input, length);
+
+        size_t encodedLength = cobsEncode(input, length, encoded);
+        TEST_ASSERT_LESS_OR_EQUAL(COBS_MAX_ENCODED(length), encodedLength);
+        TEST_ASSERT_NULL(memchr(encoded, 0, encodedLength));
+
+        size_t decodedLength = cobsDecode(encoded, encodedLength, decoded, sizeof(decoded));
+        TEST_ASSERT_EQUAL_size_t(length, decodedLength);
+        TEST_ASSERT_EQUAL_MEMORY(input, decoded, length);
+    }
+}
+
+void test_cobs_decode_rejects_embedded_zero_and_overrun(void) {
+    uint8_t decoded[8];
+    const uint8_t embeddedZero[] = { 0x03, 0x11, 0x00 };
+    TEST_ASSERT_EQUAL_size_t(0, cobsDecode(embeddedZero, sizeof(embeddedZero), decoded, sizeof(decoded)));
+
+    const uint8_t truncated[] = { 0x05, 0x11, 0x22 };
+    TEST_ASSERT_EQUAL_size_t(0, cobsDecode(truncated, sizeof(truncated), decoded, sizeof(decoded)));
+
+    const uint8_t tooLong[] = { 0x05, 0x11, 0x22, 0x33, 0x44 };
+    TEST_ASSERT_EQUAL_size_t(0, cobsDecode(tooLong, sizeof(tooLong), decoded, 3));
+}
+
+void test_frame_round_trip_fuzz(void) {
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+    uint8_t frame[COBS_MAX_ENCODED(FRAME_MAX_PAYLOAD + FRAME_CRC_BYTES) + 1];
+    uint8_t decoded[FRAME_MAX_PAYLOAD];
+    for (int trial = 0; trial < 3000; trial++) {
+        size_t length = 1 + nextRandom() % FRAME_MAX_PAYLOAD;
+        randomBytes(payload, length);
+
+        size_t frameLength = encodeFrame(payload, length, frame);
+        TEST_ASSERT_GREATER_THAN(length + FRAME_CRC_BYTES, frameLength);
+        TEST_ASSERT_LESS_OR_EQUAL(sizeof(frame), frameLength);
+        TEST_ASSERT_EQUAL_HEX8(FRAME_DELIMITER, frame[frameLength - 1]);
+        TEST_ASSERT_NULL(memchr(frame, FRAME_DELIMITER, frameLength - 1));
+
+        TEST_ASSERT_EQUAL_size_t(length, decodeFrame(frame, frameLength - 1, decoded, sizeof(decoded)));
+        TEST_ASSERT_EQUAL_MEMORY(payload, decoded, length);
+    }
+}
+
+void test_encode_rejects_oversized_payload(void) {
+    static uint8_t payload[FRAME_MAX_PAYLOAD + 1];
+    static uint8_t frame[COBS_MAX_ENCODED(FRAME_MAX_PAYLOAD + 1 + FRAME_CRC_BYTES) + 1];
+    TEST_ASSERT_EQUAL_size_t(0, encodeFrame(payload, sizeof(payload), frame));
+}
+
+void test_corrupted_frames_are_rejected(void) {
+    uint8_t payload[64];
+    uint8_t frame[COBS_MAX_ENCODED(64 + FRAME_CRC_BYTES) + 1];
+    uint8_t corrupted[sizeof(frame)];
+    uint8_t decoded[64];
+    int accepted = 0;
+    for (int trial = 0; trial < 20000; trial++) {
+        size_t length = 1 + nextRandom() % sizeof(payload);
+        randomBytes(payload, length);
+        size_t frameLength = encodeFrame(payload, length, frame) - 1;  // Sin delimitador
+
+        // Un bit cambiado, un byte perdido o la trama cortada
+        memcpy(corrupted, frame, frameLength);
+        size_t corruptedLength = frameLength;
+        uint32_t kind = nextRandom() % 3;
+        size_t position = nextRandom() % frameLength;
+        if (kind == 0) {
+            corrupted[position] ^= (uint8_t)(1 << (nextRandom() & 7));
+        } else if (kind == 1) {
+            memmove(corrupted + position, corrupted + position + 1, frameLength - position - 1);
+            corruptedLength--;
+        } else {
+            corruptedLength = position;
+        }
+
+        if (decodeFrame(corrupted, corruptedLength, decoded, sizeof(decoded)) != 0) accepted++;
+    }
+    TEST_ASSERT_EQUAL_INT(0, accepted);
+}
+
+void test_random_garbage_never_overruns_payload(void) {
+    uint8_t garbage[300];
+    uint8_t decoded[32 + 4];
+    for (int trial = 0; trial < 20000; trial++) {
+        size_t length = nextRandom() % sizeof(garbage);
+        for (size_t i = 0; i < length; i++) garbage[i] = (uint8_t)nextRandom();
+        memset(decoded, 0xA5, sizeof(decoded));
+
+        size_t result = decodeFrame(garbage, length, decoded, 32);
+        TEST_ASSERT_LESS_OR_EQUAL(32, result);
+        for (size_t i = 32; i < sizeof(decoded); i++) {
+            TEST_ASSERT_EQUAL_HEX8(0xA5, decoded[i]);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_crc16_ccitt_check_value);
+    RUN_TEST(test_cobs_known_vectors);
+    RUN_TEST(test_cobs_round_trip_fuzz);
+    RUN_TEST(test_cobs_decode_rejects_embedded_zero_and_overrun);
+    RUN_TEST(test_frame_round_trip_fuzz);
+    RUN_TEST(test_encode_rejects_oversized_payload);
+    RUN_TEST(test_corrupted_frames_are_rejected);
+    RUN_TEST(test_random_garbage_never_overruns_payload);
+    return UNITY_END();
+}
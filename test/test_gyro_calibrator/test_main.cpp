@@ -0,0 +1,161 @@
+#include <unity.h>
+#include "GyroCalibrator.h"
+
+static const uint16_t BLOCK = 50;
+static const uint16_t BLOCKS = 4;
+static const int16_t STILL_RANGE = 8;
+static const int32_t ONE_COUNT = 1 << GYRO_OFFSET_FRACTION_BITS;  // Offsets en punto fijo
+static const int32_t TOLERANCE = 2 * ONE_COUNT;
+
+// Generador congruencial: el mismo ruido en cada ejecución
+static uint32_t randomState;
+
+static int16_t noise(int16_t amplitude) {
+    randomState = randomState * 1664525u + 1013904223u;
+    return (int16_t)((int32_t)((randomState >> 8) % (2 * amplitude + 1)) - amplitude);
+}
+
+// Alimenta `blocks` bloques en reposo alrededor de `bias` (cuentas) y
+// devuelve cuántas veces addSample terminó una calibración
+static int feedStill(GyroCalibrator& calibrator, const int16_t bias[3], int blocks) {
+    int finished = 0;
+    for (int n = 0; n < blocks * BLOCK; n++) {
+        int16_t gyro[3];
+        for (int axis = 0; axis < 3; axis++) gyro[axis] = bias[axis] + noise(3);
+        if (calibrator.addSample(gyro)) finished++;
+    }
+    return finished;
+}
+
+static void feedMoving(GyroCalibrator& calibrator, int blocks) {
+    for (int n = 0; n < blocks * BLOCK; n++) {
+        int16_t gyro[3] = { (int16_t)(n % 2 ? 400 : -400), 0, 0 };
+        calibrator.addSample(gyro);
+    }
+}
+
+void setUp(void) {
+    randomState = 12345;
+}
+
+void tearDown(void) {
+}
+
+void test_stillness_detector_blocks(void) {
+    StillnessDetector detector(4, 5);
+    const int16_t still[4][3] = { { 10, -3, 0 }, { 12, -1, 2 }, { 15, -3, 1 }, { 11, 2, 0 } };
+    for (int n = 0; n < 3; n++) TEST_ASSERT_FALSE(detector.addSample(still[n]));
+    TEST_ASSERT_TRUE(detector.addSample(still[3]));
+    TEST_ASSERT_TRUE(detector.wasStill());
+    TEST_ASSERT_EQUAL_INT32(48, detector.getBlockSum()[0]);
+    TEST_ASSERT_EQUAL_INT32(-5, detector.getBlockSum()[1]);
+    TEST_ASSERT_EQUAL_INT32(3, detector.getBlockSum()[2]);
+
+    // Un rango de 6 cuentas en un solo eje ya es movimiento
+    const int16_t moving[4][3] = { { 0, 0, 0 }, { 0, 0, 6 }, { 0, 0, 0 }, { 0, 0, 0 } };
+    for (int n = 0; n < 4; n++) detector.addSample(moving[n]);
+    TEST_ASSERT_FALSE(detector.wasStill());
+
+    // Cada bloque empieza de cero
+    for (int n = 0; n < 4; n++) detector.addSample(still[n]);
+    TEST_ASSERT_TRUE(detector.wasStill());
+}
+
+void test_full_calibration_without_stored_offsets(void) {
+    GyroCalibrator calibrator(BLOCK, BLOCKS, STILL_RANGE, TOLERANCE);
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_IDLE, calibrator.getState());
+    calibrator.begin(nullptr);
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_RUNNING, calibrator.getState());
+    TEST_ASSERT_FALSE(calibrator.hasOffsets());
+
+    const int16_t bias[3] = { 37, -120, 5 };
+    TEST_ASSERT_EQUAL_INT(0, feedStill(calibrator, bias, BLOCKS - 1));
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_RUNNING, calibrator.getState());
+    TEST_ASSERT_EQUAL_INT(1, feedStill(calibrator, bias, 1));
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_DONE, calibrator.getState());
+    TEST_ASSERT_TRUE(calibrator.hasOffsets());
+
+    // Media en punto fijo con el ruido (±3) casi anulado
+    for (int axis = 0; axis < 3; axis++) {
+        TEST_ASSERT_INT32_WITHIN(ONE_COUNT / 2, bias[axis] * ONE_COUNT, calibrator.getOffsets()[axis]);
+    }
+
+    // Terminada, ignora muestras nuevas
+    const int16_t other[3] = { 0, 0, 0 };
+    TEST_ASSERT_EQUAL_INT(0, feedStill(calibrator, other, BLOCKS));
+    TEST_ASSERT_INT32_WITHIN(ONE_COUNT / 2, 37 * ONE_COUNT, calibrator.getOffsets()[0]);
+}
+
+void test_fixed_point_mean_rounds_to_nearest(void) {
+    GyroCalibrator calibrator(3, 1, STILL_RANGE, TOLERANCE);
+    calibrator.begin(nullptr);
+
+    // Medias -7/3, 1/3 y 5/3 cuentas: -37.3, 5.3 y 26.7 en punto fijo
+    const int16_t samples[3][3] = { { -2, 0, 1 }, { -2, 1, 2 }, { -3, 0, 2 } };
+    for (int n = 0; n < 2; n++) TEST_ASSERT_FALSE(calibrator.addSample(samples[n]));
+    TEST_ASSERT_TRUE(calibrator.addSample(samples[2]));
+    TEST_ASSERT_EQUAL_INT32(-37, calibrator.getOffsets()[0]);
+    TEST_ASSERT_EQUAL_INT32(5, calibrator.getOffsets()[1]);
+    TEST_ASSERT_EQUAL_INT32(27, calibrator.getOffsets()[2]);
+}
+
+void test_movement_restarts_accumulation(void) {
+    GyroCalibrator calibrator(BLOCK, BLOCKS, STILL_RANGE, TOLERANCE);
+    calibrator.begin(nullptr);
+    const int16_t bias[3] = { 10, 10, 10 };
+
+    TEST_ASSERT_EQUAL_INT(0, feedStill(calibrator, bias, BLOCKS - 1));
+    feedMoving(calibrator, 1);
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_RUNNING, calibrator.getState());
+
+    // Los bloques de antes del movimiento no cuentan
+    TEST_ASSERT_EQUAL_INT(0, feedStill(calibrator, bias, BLOCKS - 1));
+    TEST_ASSERT_EQUAL_INT(1, feedStill(calibrator, bias, 1));
+}
+
+void test_stored_offsets_verified_with_one_block(void) {
+    GyroCalibrator calibrator(BLOCK, BLOCKS, STILL_RANGE, TOLERANCE);
+    const int32_t stored[3] = { 37 * ONE_COUNT, -120 * ONE_COUNT, 5 * ONE_COUNT };
+    calibrator.begin(stored);
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_VERIFYING, calibrator.getState());
+    TEST_ASSERT_TRUE(calibrator.hasOffsets());
+
+    // Moverse durante la verificación sólo la retrasa
+    feedMoving(calibrator, 2);
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_VERIFYING, calibrator.getState());
+
+    // Un bloque en reposo que coincide basta, sin offsets nuevos que guardar
+    const int16_t bias[3] = { 38, -119, 4 };
+    TEST_ASSERT_EQUAL_INT(0, feedStill(calibrator, bias, 1));
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_DONE, calibrator.getState());
+    TEST_ASSERT_EQUAL_INT32_ARRAY(stored, calibrator.getOffsets(), 3);
+}
+
+void test_stale_offsets_trigger_recalibration(void) {
+    GyroCalibrator calibrator(BLOCK, BLOCKS, STILL_RANGE, TOLERANCE);
+    const int32_t stored[3] = { 0, 0, 0 };
+    calibrator.begin(stored);
+
+    // El primer bloque no coincide y ya cuenta para la calibración completa
+    const int16_t bias[3] = { 20, -6, 3 };
+    TEST_ASSERT_EQUAL_INT(0, feedStill(calibrator, bias, 1));
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_RUNNING, calibrator.getState());
+    TEST_ASSERT_EQUAL_INT(0, feedStill(calibrator, bias, BLOCKS - 2));
+    TEST_ASSERT_EQUAL_INT(1, feedStill(calibrator, bias, 1));
+    TEST_ASSERT_EQUAL_INT(CALIBRATION_DONE, calibrator.getState());
+    TEST_ASSERT_INT32_WITHIN(ONE_COUNT / 2, 20 * ONE_COUNT, calibrator.getOffsets()[0]);
+    TEST_ASSERT_INT32_WITHIN(ONE_COUNT / 2, -6 * ONE_COUNT, calibrator.getOffsets()[1]);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_stillness_detector_blocks);
+    RUN_TEST(test_full_calibration_without_stored_offsets);
+    RUN_TEST(test_fixed_point_mean_rounds_to_nearest);
+    RUN_TEST(test_movement_restarts_accumulation);
+    RUN_TEST(test_stored_offsets_verified_with_one_block);
+    RUN_TEST(test_stale_offsets_trigger_recalibration);
+    return UNITY_END();
+}
@@ -0,0 +1,195 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "Log.h"
+
+static uint32_t fakeNowUs;
+
+static uint32_t fakeClock() {
+    return fakeNowUs;
+}
+
+// Entrada con argumentos distintos para cada tipo declarado del mensaje
+static LogEntry makeEntry(uint16_t id, uint32_t timestampUs) {
+    LogEntry entry = {};
+    entry.timestampUs = timestampUs;
+    entry.id = id;
+    const char* types = Logger::getMessage(id).types;
+    entry.argCount = (uint16_t)strlen(types);
+    for (uint16_t i = 0; i < entry.argCount; i++) {
+        if (types[i] == 'f') entry.args[i] = LogArg(12.25f * (i + 1));
+        else if (types[i] == 'i') entry.args[i] = LogArg((int)(-1000 - (int)i));
+        else entry.args[i] = LogArg((unsigned)(4000000000u + i));
+    }
+    return entry;
+}
+
+// Lo mismo que daría printf con la lista de argumentos completa
+static bool formatWithPrintf(const LogEntry& entry, char* output, size_t size) {
+    const LogMessageInfo& message = Logger::getMessage(entry.id);
+    const LogArg* a = entry.args;
+    if (strspn(message.types, "f") == strlen(message.types)) {
+        snprintf(output, size, message.format, (double)a[0].f, (double)a[1].f, (double)a[2].f, (double)a[3].f);
+    } else if (strcmp(message.types, "u") == 0) {
+        snprintf(output, size, message.format, (unsigned)a[0].u);
+    } else if (strcmp(message.types, "i") == 0) {
+        snprintf(output, size, message.format, (int)a[0].i);
+    } else {
+        return false;  // Combinación nueva: añadirla aquí
+    }
+    return true;
+}
+
+void setUp(void) {
+    fakeNowUs = 5000;
+}
+
+void tearDown(void) {
+}
+
+void test_types_match_format_conversions(void) {
+    for (uint16_t id = 0; id < LOG_MESSAGE_COUNT; id++) {
+        const LogMessageInfo& message = Logger::getMessage(id);
+        size_t conversions = 0;
+        for (const char* c = message.format; *c; c++) {
+            if (*c != '%') continue;
+            if (c[1] == '%') {
+                c++;
+                continue;
+            }
+            conversions++;
+        }
+        TEST_ASSERT_EQUAL_INT_MESSAGE((int)strlen(message.types), (int)conversions, message.name);
+        TEST_ASSERT_TRUE_MESSAGE(strlen(message.types) <= LOG_MAX_ARGS, message.name);
+    }
+}
+
+void test_every_message_formats_like_printf(void) {
+    for (uint16_t id = 0; id < LOG_MESSAGE_COUNT; id++) {
+        LogEntry entry = makeEntry(id, 0);
+        char expected[LOG_LINE_MAX];
+        char actual[LOG_LINE_MAX];
+        TEST_ASSERT_TRUE_MESSAGE(formatWithPrintf(entry, expected, sizeof(expected)), Logger::getMessage(id).name);
+        size_t length = Logger::format(entry, actual, sizeof(actual));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+        TEST_ASSERT_EQUAL_size_t(strlen(expected), length);
+    }
+}
+
+void test_format_edge_cases(void) {
+    char line[LOG_LINE_MAX];
+
+    LogEntry entry = makeEntry(LOG_ARMED, 0);
+    entry.args[0] = LogArg(3.0f);
+    Logger::format(entry, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("MOTORES ARMADOS! Throttle actual: 3.0%", line);
+
+    // Argumento que falta: marcador en lugar de basura
+    entry.argCount = 0;
+    Logger::format(entry, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("MOTORES ARMADOS! Throttle actual: ?%", line);
+
+    entry.id = LOG_MESSAGE_COUNT;
+    Logger::format(entry, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("Mensaje desconocido", line);
+    TEST_ASSERT_EQUAL_STRING("LOG_UNKNOWN", Logger::getMessage(0xFFFF).name);
+}
+
+void test_format_truncates_to_buffer(void) {
+    LogEntry entry = makeEntry(LOG_KEY_STATUS_ANGLE, 0);
+    char full[LOG_LINE_MAX];
+    size_t fullLength = Logger::format(entry, full, sizeof(full));
+
+    // Cada tamaño corta en el mismo sitio que el texto completo, siempre terminado
+    for (size_t size = 1; size <= fullLength + 1; size++) {
+        char line[LOG_LINE_MAX];
+        memset(line, 'x', sizeof(line));
+        size_t length = Logger::format(entry, line, size);
+        TEST_ASSERT_EQUAL_size_t(size - 1, length);
+        TEST_ASSERT_EQUAL_INT('\0', line[length]);
+        TEST_ASSERT_EQUAL_MEMORY(full, line, length);
+    }
+    TEST_ASSERT_EQUAL_size_t(0, Logger::format(entry, full, 0));
+}
+
+void test_binary_frame_round_trip(void) {
+    // Mismo diseño que LOG_FORMAT en tools/telemetry_decode.py ("<BHI4I")
+    TEST_ASSERT_EQUAL_size_t(23, sizeof(LogFrame));
+
+    for (uint16_t id = 0; id < LOG_MESSAGE_COUNT; id++) {
+        LogEntry entry = makeEntry(id, 0x89ABCDEFu - id);
+        uint8_t encoded[LOG_FRAME_MAX_ENCODED];
+        size_t encodedLength = Logger::encode(entry, encoded);
+        TEST_ASSERT_TRUE(encodedLength <= LOG_FRAME_MAX_ENCODED);
+        TEST_ASSERT_EQUAL_HEX8(FRAME_DELIMITER, encoded[encodedLength - 1]);
+        TEST_ASSERT_NULL(memchr(encoded, FRAME_DELIMITER, encodedLength - 1));
+
+        LogFrame frame;
+        TEST_ASSERT_EQUAL_size_t(sizeof(frame),
+                                 decodeFrame(encoded, encodedLength - 1, (uint8_t*)&frame, sizeof(frame)));
+        TEST_ASSERT_EQUAL_HEX8(LOG_FRAME_TYPE, frame.type);
+
+        // Lo que haría el decodificador del host: texto idéntico al de la placa
+        LogEntry decoded;
+        decoded.timestampUs = frame.timestampUs;
+        decoded.id = frame.id;
+        decoded.argCount = (uint16_t)strlen(Logger::getMessage(frame.id).types);
+        for (uint16_t i = 0; i < LOG_MAX_ARGS; i++) {
+            decoded.args[i].u = frame.args[i];
+            if (i >= entry.argCount) TEST_ASSERT_EQUAL_UINT32(0, frame.args[i]);
+        }
+        TEST_ASSERT_EQUAL_UINT32(entry.timestampUs, decoded.timestampUs);
+
+        char expected[LOG_LINE_MAX];
+        char actual[LOG_LINE_MAX];
+        Logger::format(entry, expected, sizeof(expected));
+        Logger::format(decoded, actual, sizeof(actual));
+        TEST_ASSERT_EQUAL_STRING(expected, actual);
+    }
+}
+
+void test_logger_queues_in_order_and_counts_drops(void) {
+    static Logger logger(fakeClock);
+    TEST_ASSERT_EQUAL_size_t(0, logger.pending());
+
+    logger.log(LOG_FC_INIT);
+    fakeNowUs = 6000;
+    logger.log(LOG_KEY_STATUS_ACRO, 1.0f, 2.0f, 3.0f, 4.0f);
+
+    LogEntry entry;
+    TEST_ASSERT_TRUE(logger.pop(entry));
+    TEST_ASSERT_EQUAL_UINT16(LOG_FC_INIT, entry.id);
+    TEST_ASSERT_EQUAL_UINT16(0, entry.argCount);
+    TEST_ASSERT_EQUAL_UINT32(5000, entry.timestampUs);
+    TEST_ASSERT_TRUE(logger.pop(entry));
+    TEST_ASSERT_EQUAL_UINT16(LOG_KEY_STATUS_ACRO, entry.id);
+    TEST_ASSERT_EQUAL_UINT16(4, entry.argCount);
+    TEST_ASSERT_EQUAL_FLOAT(4.0f, entry.args[3].f);
+    TEST_ASSERT_EQUAL_UINT32(6000, entry.timestampUs);
+    TEST_ASSERT_FALSE(logger.pop(entry));
+
+    // Cola llena: se descarta y se cuenta, sin bloquear
+    for (int i = 0; i < LOG_RING_SIZE + 10; i++) {
+        logger.log(LOG_KEY_THROTTLE, (float)i);
+    }
+    size_t accepted = logger.pending();
+    TEST_ASSERT_EQUAL_UINT32(LOG_RING_SIZE + 10 - accepted, logger.takeDropped());
+    TEST_ASSERT_EQUAL_UINT32(0, logger.takeDropped());
+    for (size_t i = 0; i < accepted; i++) {
+        TEST_ASSERT_TRUE(logger.pop(entry));
+        TEST_ASSERT_EQUAL_FLOAT((float)i, entry.args[0].f);
+    }
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_types_match_format_conversions);
+    RUN_TEST(test_every_message_formats_like_printf);
+    RUN_TEST(test_format_edge_cases);
+    RUN_TEST(test_format_truncates_to_buffer);
+    RUN_TEST(test_binary_frame_round_trip);
+    RUN_TEST(test_logger_queues_in_order_and_counts_drops);
+    return UNITY_END();
+}
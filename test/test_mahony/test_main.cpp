@@ -0,0 +1,250 @@
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "ComplementaryFilter.h"
+#include "FastMath.h"
+#include "MahonyAHRS.h"
+#include "config.h"
+
+static const float DT = 0.004f;  // Lazo de ángulo a 250 Hz
+
+// Ganancias de vuelo (config.h) y las mismas con término integral
+static const MahonyAHRS::Config FLIGHT_GAINS = { MAHONY_KP, MAHONY_KI };
+static const MahonyAHRS::Config INTEGRAL_GAINS = { MAHONY_KP, 0.3f };
+
+// Gravedad medida con el marco girado `rollDeg` y `pitchDeg`
+static void gravity(float rollDeg, float pitchDeg, float& ax, float& ay, float& az) {
+    float roll = rollDeg * DEG_TO_RAD_F;
+    float pitch = pitchDeg * DEG_TO_RAD_F;
+    ax = -sinf(pitch);
+    ay = cosf(pitch) * sinf(roll);
+    az = cosf(pitch) * cosf(roll);
+}
+
+static void run(MahonyAHRS& ahrs, float gx, float gy, float gz, float rollDeg, float pitchDeg, float seconds) {
+    float ax, ay, az;
+    gravity(rollDeg, pitchDeg, ax, ay, az);
+    for (int i = 0; i < (int)(seconds / DT); i++) {
+        ahrs.update(gx, gy, gz, ax, ay, az, DT);
+    }
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_level_at_rest(void) {
+    MahonyAHRS ahrs(1.0f, 0.0f);
+    run(ahrs, 0, 0, 0, 0, 0, 1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, ahrs.getRoll());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, ahrs.getPitch());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, ahrs.getYaw());
+}
+
+void test_first_sample_initializes_from_accelerometer(void) {
+    MahonyAHRS ahrs(1.0f, 0.0f);
+    float ax, ay, az;
+    gravity(30.0f, -20.0f, ax, ay, az);
+    ahrs.update(0, 0, 0, ax * 9.81f, ay * 9.81f, az * 9.81f, DT);  // Cualquier unidad
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 30.0f, ahrs.getRoll());
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, -20.0f, ahrs.getPitch());
+}
+
+void test_integrates_gyro_without_accelerometer(void) {
+    MahonyAHRS ahrs(1.0f, 0.0f);
+    // 90 grados/s de yaw durante un segundo, sin gravedad (caída libre)
+    for (int i = 0; i < 250; i++) {
+        ahrs.update(0, 0, 90.0f * DEG_TO_RAD_F, 0, 0, 0, DT);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 90.0f, ahrs.getYaw());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, ahrs.getRoll());
+}
+
+void test_yaw_wraps_to_positive_range(void) {
+    MahonyAHRS ahrs(1.0f, 0.0f);
+    run(ahrs, 0, 0, -45.0f * DEG_TO_RAD_F, 0, 0, 1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.2f, 315.0f, ahrs.getYaw());
+}
+
+void test_converges_to_gravity_after_disturbance(void) {
+    MahonyAHRS ahrs(1.0f, 0.0f);
+    run(ahrs, 0, 0, 0, 0, 0, 0.1f);
+
+    // El marco se inclina 25 grados de roll sin que el giroscopio lo vea
+    run(ahrs, 0, 0, 0, 25.0f, 0, 0.5f);
+    float early = ahrs.getRoll();
+    run(ahrs, 0, 0, 0, 25.0f, 0, 10.0f);
+    TEST_ASSERT_TRUE(early > 1.0f && early < 24.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 25.0f, ahrs.getRoll());
+}
+
+void test_integral_term_cancels_gyro_bias(void) {
+    const float bias = 2.0f * DEG_TO_RAD_F;
+    MahonyAHRS proportional(1.0f, 0.0f);
+    MahonyAHRS integral(1.0f, 0.3f);
+    run(proportional, bias, 0, 0, 0, 0, 30.0f);
+    run(integral, bias, 0, 0, 0, 0, 30.0f);
+
+    // Sólo con Kp queda un error fijo de bias / (2·Kp); Ki lo elimina
+    TEST_ASSERT_GREATER_THAN(0.5f, fabsf(proportional.getRoll()));
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 0.0f, integral.getRoll());
+}
+
+void test_reset_returns_to_identity(void) {
+    MahonyAHRS ahrs(1.0f, 0.1f);
+    run(ahrs, 0.3f, 0.2f, 0.1f, 10.0f, 5.0f, 1.0f);
+    ahrs.reset();
+    run(ahrs, 0, 0, 0, 0, 0, DT);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, ahrs.getRoll());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, ahrs.getPitch());
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, ahrs.getYaw());
+}
+
+// Trayectoria sintética con verdad conocida: cada ángulo de Euler (ZYX) es
+// una senoide y las velocidades del cuerpo salen de sus derivadas
+struct Trace {
+    float rollAmplitude, rollHz;
+    float pitchAmplitude, pitchHz;
+    float yawAmplitude, yawHz;
+    float gyroBias[3];      // Grados/s
+    float accelNoise;       // Fracción de g, uniforme por eje
+};
+
+struct TraceErrors {
+    float rms;              // Grados de inclinación (dirección de la gravedad)
+    float max;
+};
+
+static uint32_t rngState;
+
+static float noise(float amplitude) {
+    rngState = rngState * 1664525u + 1013904223u;
+    return amplitude * ((float)(rngState >> 8) / 8388608.0f - 1.0f);
+}
+
+// Ángulo entre la gravedad de la estimación y la real: bien definido también
+// cerca de ±90 grados de pitch, donde el roll de Euler deja de tenerlo
+static float tiltError(float rollDeg, float pitchDeg, float trueAx, float trueAy, float trueAz) {
+    float ax, ay, az;
+    gravity(rollDeg, pitchDeg, ax, ay, az);
+    float dot = ax * trueAx + ay * trueAy + az * trueAz;
+    return acosf(fminf(1.0f, fmaxf(-1.0f, dot))) * RAD_TO_DEG_F;
+}
+
+// Pasa la misma traza por los dos estimadores y mide el error tras 2 s
+static void runTrace(const Trace& trace, const MahonyAHRS::Config& mahonyConfig, float seconds,
+                     TraceErrors& mahonyErrors, TraceErrors& complementaryErrors) {
+    MahonyAHRS mahony(mahonyConfig);
+    ComplementaryFilter complementary(ComplementaryFilter::Config{ GYRO_FILTER_ALPHA });
+    double mahonySum = 0, complementarySum = 0;
+    int measured = 0;
+    mahonyErrors = { 0, 0 };
+    complementaryErrors = { 0, 0 };
+    rngState = 1234;
+
+    for (int i = 0; i < (int)(seconds / DT); i++) {
+        float t = i * DT;
+        float wr = 2.0f * (float)M_PI * trace.rollHz;
+        float wp = 2.0f * (float)M_PI * trace.pitchHz;
+        float wy = 2.0f * (float)M_PI * trace.yawHz;
+        float roll = trace.rollAmplitude * sinf(wr * t) * DEG_TO_RAD_F;
+        float pitch = trace.pitchAmplitude * sinf(wp * t) * DEG_TO_RAD_F;
+        float rollRate = trace.rollAmplitude * wr * cosf(wr * t) * DEG_TO_RAD_F;
+        float pitchRate = trace.pitchAmplitude * wp * cosf(wp * t) * DEG_TO_RAD_F;
+        float yawRate = trace.yawAmplitude * wy * cosf(wy * t) * DEG_TO_RAD_F;
+
+        float gx = rollRate - yawRate * sinf(pitch);
+        float gy = pitchRate * cosf(roll) + yawRate * cosf(pitch) * sinf(roll);
+        float gz = -pitchRate * sinf(roll) + yawRate * cosf(pitch) * cosf(roll);
+        gx += trace.gyroBias[0] * DEG_TO_RAD_F;
+        gy += trace.gyroBias[1] * DEG_TO_RAD_F;
+        gz += trace.gyroBias[2] * DEG_TO_RAD_F;
+
+        float trueAx, trueAy, trueAz;
+        gravity(roll * RAD_TO_DEG_F, pitch * RAD_TO_DEG_F, trueAx, trueAy, trueAz);
+        float ax = trueAx + noise(trace.accelNoise);
+        float ay = trueAy + noise(trace.accelNoise);
+        float az = trueAz + noise(trace.accelNoise);
+
+        mahony.update(gx, gy, gz, ax, ay, az, DT);
+        complementary.update(gx, gy, gz, ax, ay, az, DT);
+        if (t < 2.0f) continue;
+
+        float mahonyError = tiltError(mahony.getRoll(), mahony.getPitch(), trueAx, trueAy, trueAz);
+        float complementaryError =
+            tiltError(complementary.getRoll(), complementary.getPitch(), trueAx, trueAy, trueAz);
+        mahonySum += mahonyError * mahonyError;
+        complementarySum += complementaryError * complementaryError;
+        mahonyErrors.max = fmaxf(mahonyErrors.max, mahonyError);
+        complementaryErrors.max = fmaxf(complementaryErrors.max, complementaryError);
+        measured++;
+    }
+    mahonyErrors.rms = (float)sqrt(mahonySum / measured);
+    complementaryErrors.rms = (float)sqrt(complementarySum / measured);
+}
+
+static void reportTrace(const char* name, const TraceErrors& mahony, const TraceErrors& complementary) {
+    char message[128];
+    snprintf(message, sizeof(message), "%s: Mahony rms %.2f max %.2f | complementario rms %.2f max %.2f (grados)",
+             name, mahony.rms, mahony.max, complementary.rms, complementary.max);
+    TEST_MESSAGE(message);
+}
+
+void test_large_rotations_near_vertical_pitch(void) {
+    // Pitch hasta 88 grados con roll y yaw amplios a la vez. El complementario
+    // integra cada eje por separado y se pierde; Mahony sigue la gravedad
+    const Trace trace = { 60.0f, 0.4f, 88.0f, 0.25f, 120.0f, 0.15f, { 0, 0, 0 }, 0.0f };
+    TraceErrors mahony, complementary;
+    runTrace(trace, FLIGHT_GAINS, 20.0f, mahony, complementary);
+    reportTrace("rotaciones", mahony, complementary);
+    TEST_ASSERT_TRUE(mahony.rms < 1.0f);
+    TEST_ASSERT_TRUE(mahony.max < 1.5f);
+    TEST_ASSERT_TRUE(mahony.rms < complementary.rms);
+}
+
+void test_gyro_bias_and_accel_noise(void) {
+    const Trace hover = { 10.0f, 0.3f, 10.0f, 0.2f, 30.0f, 0.1f, { 3.0f, -2.0f, 1.5f }, 0.1f };
+    const Trace aggressive = { 60.0f, 0.4f, 88.0f, 0.25f, 120.0f, 0.15f, { 3.0f, -2.0f, 1.5f }, 0.1f };
+    TraceErrors mahony, complementary;
+
+    // Con las ganancias de config.h (sin Ki) el sesgo deja un error fijo
+    // acotado por el término proporcional
+    runTrace(hover, FLIGHT_GAINS, 20.0f, mahony, complementary);
+    reportTrace("sesgo y ruido", mahony, complementary);
+    TEST_ASSERT_TRUE(mahony.rms < 4.5f);
+    TEST_ASSERT_TRUE(mahony.max < 5.0f);
+    runTrace(aggressive, FLIGHT_GAINS, 20.0f, mahony, complementary);
+    reportTrace("rotaciones con sesgo y ruido", mahony, complementary);
+    TEST_ASSERT_TRUE(mahony.rms < 2.5f);
+    TEST_ASSERT_TRUE(mahony.max < 4.0f);
+    TEST_ASSERT_TRUE(mahony.rms < complementary.rms);
+
+    // El término integral aprende el sesgo: queda el ruido del acelerómetro
+    runTrace(hover, INTEGRAL_GAINS, 20.0f, mahony, complementary);
+    reportTrace("sesgo y ruido con Ki", mahony, complementary);
+    TEST_ASSERT_TRUE(mahony.rms < 1.5f);
+    TEST_ASSERT_TRUE(mahony.max < 3.0f);
+    runTrace(aggressive, INTEGRAL_GAINS, 20.0f, mahony, complementary);
+    reportTrace("rotaciones con sesgo, ruido y Ki", mahony, complementary);
+    TEST_ASSERT_TRUE(mahony.rms < 1.5f);
+    TEST_ASSERT_TRUE(mahony.max < 3.0f);
+    TEST_ASSERT_TRUE(mahony.rms < complementary.rms);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_level_at_rest);
+    RUN_TEST(test_first_sample_initializes_from_accelerometer);
+    RUN_TEST(test_integrates_gyro_without_accelerometer);
+    RUN_TEST(test_yaw_wraps_to_positive_range);
+    RUN_TEST(test_converges_to_gravity_after_disturbance);
+    RUN_TEST(test_integral_term_cancels_gyro_bias);
+    RUN_TEST(test_reset_returns_to_identity);
+    RUN_TEST(test_large_rotations_near_vertical_pitch);
+    RUN_TEST(test_gyro_bias_and_accel_noise);
+    return UNITY_END();
+}
@@ -0,0 +1,142 @@
+#include <unity.h>
+#include "Mixer.h"
+
+static Mixer mixer;
+static float outputs[MIXER_MAX_MOTORS];
+
+static uint32_t rngState;
+
+static float randomUnit() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return (float)(rngState >> 8) / 16777216.0f;
+}
+
+void setUp(void) {
+    mixer = Mixer();
+    rngState = 2024;
+}
+
+void tearDown(void) {
+}
+
+void test_unsaturated_mix_adds_corrections(void) {
+    mixer.mix(0.5f, 0.1f, 0.0f, 0.0f, outputs);
+    TEST_ASSERT_FALSE(mixer.isSaturated());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.6f, outputs[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.6f, outputs[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.4f, outputs[2]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.4f, outputs[3]);
+    TEST_ASSERT_EQUAL_UINT32(0, mixer.getSaturationCount());
+}
+
+void test_high_throttle_is_lowered_to_keep_authority(void) {
+    mixer.mix(0.95f, 0.2f, 0.0f, 0.0f, outputs);
+    TEST_ASSERT_TRUE(mixer.isSaturated());
+    TEST_ASSERT_EQUAL_UINT32(1, mixer.getSaturationCount());
+
+    // El motor más cargado toca 1 y la diferencia entre lados se conserva
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, outputs[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.4f, outputs[0] - outputs[3]);
+}
+
+void test_oversized_corrections_are_scaled(void) {
+    // Rango de correcciones 2 * (0.6 + 0.3) = 1.8 > 1
+    mixer.mix(0.5f, 0.6f, 0.3f, 0.0f, outputs);
+    TEST_ASSERT_TRUE(mixer.isSaturated());
+
+    float minOutput = 1.0f, maxOutput = 0.0f;
+    for (int i = 0; i < 4; i++) {
+        if (outputs[i] < minOutput) minOutput = outputs[i];
+        if (outputs[i] > maxOutput) maxOutput = outputs[i];
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, minOutput);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, maxOutput);
+
+    // Roll y pitch conservan su proporción (2:1)
+    float rollEffect = (outputs[0] + outputs[1]) - (outputs[2] + outputs[3]);
+    float pitchEffect = (outputs[1] + outputs[2]) - (outputs[0] + outputs[3]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, 2.0f, rollEffect / pitchEffect);
+}
+
+void test_airmode_raises_throttle_at_idle(void) {
+    mixer.mix(0.0f, 0.1f, 0.0f, 0.0f, outputs);
+    TEST_ASSERT_TRUE(mixer.isSaturated());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.1f, outputs[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, outputs[2]);
+
+    mixer.setAirmode(true);
+    mixer.mix(0.0f, 0.1f, 0.0f, 0.0f, outputs);
+    TEST_ASSERT_TRUE(mixer.isSaturated());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.2f, outputs[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, outputs[2]);
+}
+
+void test_frames_are_balanced(void) {
+    const int frames[] = { FRAME_QUAD_X, FRAME_QUAD_PLUS, FRAME_HEX_X, FRAME_OCTO_X };
+    const int motors[] = { 4, 4, 6, 8 };
+
+    for (int f = 0; f < 4; f++) {
+        TEST_ASSERT_TRUE(mixer.setFrame(frames[f]));
+        TEST_ASSERT_EQUAL_INT(motors[f], mixer.getMotorCount());
+
+        // Cada eje por separado no cambia el empuje total
+        const float commands[3][3] = { { 0.2f, 0.0f, 0.0f }, { 0.0f, 0.2f, 0.0f }, { 0.0f, 0.0f, 0.2f } };
+        for (int c = 0; c < 3; c++) {
+            mixer.mix(0.5f, commands[c][0], commands[c][1], commands[c][2], outputs);
+            float total = 0.0f;
+            for (int i = 0; i < motors[f]; i++) total += outputs[i];
+            TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.5f * motors[f], total);
+        }
+    }
+
+    TEST_ASSERT_FALSE(mixer.setFrame(-1));
+    TEST_ASSERT_FALSE(mixer.setRules(nullptr, 0));
+    TEST_ASSERT_EQUAL_INT(8, mixer.getMotorCount());
+}
+
+void test_random_commands_stay_in_range(void) {
+    mixer.setFrame(FRAME_HEX_X);
+    mixer.setAirmode(true);
+
+    for (int n = 0; n < 20000; n++) {
+        float throttle = randomUnit() * 1.2f - 0.1f;
+        float roll = randomUnit() * 2.0f - 1.0f;
+        float pitch = randomUnit() * 2.0f - 1.0f;
+        float yaw = randomUnit() - 0.5f;
+        mixer.mix(throttle, roll, pitch, yaw, outputs);
+
+        for (int i = 0; i < 6; i++) {
+            TEST_ASSERT_TRUE(outputs[i] >= 0.0f && outputs[i] <= 1.0f);
+        }
+
+        // Con airmode, si las correcciones caben, las diferencias entre
+        // motores son exactamente las pedidas
+        float c0 = roll * 0.5f - pitch * 0.866025f - yaw;
+        float c1 = roll + yaw;
+        float minC = 0.0f, maxC = 0.0f;
+        const float corrections[6] = {
+            c0, c1, roll * 0.5f + pitch * 0.866025f - yaw,
+            -roll * 0.5f + pitch * 0.866025f + yaw, -roll - yaw, -roll * 0.5f - pitch * 0.866025f + yaw
+        };
+        for (int i = 0; i < 6; i++) {
+            if (corrections[i] < minC) minC = corrections[i];
+            if (corrections[i] > maxC) maxC = corrections[i];
+        }
+        if (maxC - minC <= 1.0f) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5f, c0 - c1, outputs[0] - outputs[1]);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_unsaturated_mix_adds_corrections);
+    RUN_TEST(test_high_throttle_is_lowered_to_keep_authority);
+    RUN_TEST(test_oversized_corrections_are_scaled);
+    RUN_TEST(test_airmode_raises_throttle_at_idle);
+    RUN_TEST(test_frames_are_balanced);
+    RUN_TEST(test_random_commands_stay_in_range);
+    return UNITY_END();
+}
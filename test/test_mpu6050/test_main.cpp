@@ -0,0 +1,207 @@
+#include <unity.h>
+#include "FakeI2CBus.h"
+#include "MPU6050Driver.h"
+
+static FakeI2CBus* bus;
+static MPU6050Driver* imu;
+
+void setUp(void) {
+    bus = new FakeI2CBus();
+    imu = new MPU6050Driver(*bus);
+}
+
+void tearDown(void) {
+    delete imu;
+    delete bus;
+}
+
+static void pushSample(int16_t base) {
+    int16_t accel[3] = { base, (int16_t)(base + 1), (int16_t)(base + 2) };
+    int16_t gyro[3] = { (int16_t)-base, (int16_t)(-base - 1), (int16_t)(-base - 2) };
+    bus->pushFifoSample(accel, gyro);
+}
+
+void test_begin_wakes_sensor_with_fixed_ranges(void) {
+    TEST_ASSERT_TRUE(imu->begin());
+    TEST_ASSERT_EQUAL_HEX8(0x01, bus->lastWriteValue[MPU6050_REG_PWR_MGMT_1]);
+    TEST_ASSERT_EQUAL_INT(1, bus->writeCount[MPU6050_REG_GYRO_CONFIG]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, bus->lastWriteValue[MPU6050_REG_GYRO_CONFIG]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, bus->lastWriteValue[MPU6050_REG_ACCEL_CONFIG]);
+}
+
+void test_begin_rejects_wrong_device(void) {
+    bus->registers[MPU6050_REG_WHO_AM_I] = 0x70;
+    TEST_ASSERT_FALSE(imu->begin());
+    TEST_ASSERT_EQUAL_INT(0, bus->writeCount[MPU6050_REG_PWR_MGMT_1]);
+}
+
+void test_begin_fails_when_bus_fails(void) {
+    bus->failAfter = 1;
+    TEST_ASSERT_FALSE(imu->begin());
+}
+
+void test_configure_sets_divider_and_period(void) {
+    // DLPF activo: base de 1 kHz
+    TEST_ASSERT_TRUE(imu->configure(3, 500));
+    TEST_ASSERT_EQUAL_HEX8(3, bus->lastWriteValue[MPU6050_REG_CONFIG]);
+    TEST_ASSERT_EQUAL_UINT8(1, bus->lastWriteValue[MPU6050_REG_SMPLRT_DIV]);
+    TEST_ASSERT_EQUAL_UINT32(2000, imu->getSamplePeriodUs());
+
+    // DLPF desactivado: base de 8 kHz
+    TEST_ASSERT_TRUE(imu->configure(0, 1000));
+    TEST_ASSERT_EQUAL_UINT8(7, bus->lastWriteValue[MPU6050_REG_SMPLRT_DIV]);
+    TEST_ASSERT_EQUAL_UINT32(1000, imu->getSamplePeriodUs());
+
+    // Divisor limitado a 1..256
+    TEST_ASSERT_TRUE(imu->configure(1, 2000));
+    TEST_ASSERT_EQUAL_UINT8(0, bus->lastWriteValue[MPU6050_REG_SMPLRT_DIV]);
+    TEST_ASSERT_TRUE(imu->configure(1, 1));
+    TEST_ASSERT_EQUAL_UINT8(255, bus->lastWriteValue[MPU6050_REG_SMPLRT_DIV]);
+}
+
+void test_read_raw_skips_temperature(void) {
+    bus->setWord(MPU6050_REG_ACCEL_XOUT_H + 0, 100);
+    bus->setWord(MPU6050_REG_ACCEL_XOUT_H + 2, -200);
+    bus->setWord(MPU6050_REG_ACCEL_XOUT_H + 4, 16384);
+    bus->setWord(MPU6050_REG_ACCEL_XOUT_H + 6, 1234);  // Temperatura
+    bus->setWord(MPU6050_REG_ACCEL_XOUT_H + 8, -1);
+    bus->setWord(MPU6050_REG_ACCEL_XOUT_H + 10, 32767);
+    bus->setWord(MPU6050_REG_ACCEL_XOUT_H + 12, -32768);
+
+    ImuSample sample;
+    TEST_ASSERT_TRUE(imu->readRaw(sample));
+    TEST_ASSERT_EQUAL_size_t(14, bus->lastReadLength);
+    TEST_ASSERT_EQUAL_INT16(100, sample.accel[0]);
+    TEST_ASSERT_EQUAL_INT16(-200, sample.accel[1]);
+    TEST_ASSERT_EQUAL_INT16(16384, sample.accel[2]);
+    TEST_ASSERT_EQUAL_INT16(-1, sample.gyro[0]);
+    TEST_ASSERT_EQUAL_INT16(32767, sample.gyro[1]);
+    TEST_ASSERT_EQUAL_INT16(-32768, sample.gyro[2]);
+}
+
+void test_enable_fifo_resets_and_enables_interrupts(void) {
+    imu->handleDataReady(10);
+    TEST_ASSERT_TRUE(imu->enableFifo());
+    TEST_ASSERT_EQUAL_HEX8(0x78, bus->lastWriteValue[MPU6050_REG_FIFO_EN]);
+    TEST_ASSERT_EQUAL_HEX8(0x11, bus->lastWriteValue[MPU6050_REG_INT_ENABLE]);
+    TEST_ASSERT_EQUAL_HEX8(0x44, bus->lastWriteValue[MPU6050_REG_USER_CTRL]);
+    TEST_ASSERT_EQUAL_UINT32(0, imu->pendingSamples());
+}
+
+void test_fifo_burst_decodes_and_timestamps(void) {
+    TEST_ASSERT_TRUE(imu->configure(1, 1000));
+    TEST_ASSERT_TRUE(imu->enableFifo());
+    for (int i = 0; i < 4; i++) {
+        pushSample((int16_t)(i * 10));
+        imu->handleDataReady(5000 + i * 1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(4, imu->pendingSamples());
+
+    ImuSample samples[8];
+    size_t count = imu->readFifo(samples, 8);
+    TEST_ASSERT_EQUAL_size_t(4, count);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT16(i * 10, samples[i].accel[0]);
+        TEST_ASSERT_EQUAL_INT16(i * 10 + 2, samples[i].accel[2]);
+        TEST_ASSERT_EQUAL_INT16(-i * 10 - 1, samples[i].gyro[1]);
+        // La más reciente coincide con el último flanco de INT
+        TEST_ASSERT_EQUAL_UINT32(5000 + i * 1000, samples[i].timestampUs);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, imu->pendingSamples());
+    TEST_ASSERT_EQUAL_size_t(0, bus->fifoSamples());
+}
+
+void test_fifo_reads_in_chunks_and_respects_max(void) {
+    TEST_ASSERT_TRUE(imu->configure(1, 1000));
+    TEST_ASSERT_TRUE(imu->enableFifo());
+    for (int i = 0; i < 25; i++) pushSample((int16_t)i);
+
+    ImuSample samples[32];
+    size_t count = imu->readFifo(samples, 23);
+    TEST_ASSERT_EQUAL_size_t(23, count);
+    // Ningún bloque supera el buffer de 128 bytes de Wire
+    TEST_ASSERT_LESS_OR_EQUAL(128, bus->lastReadLength);
+    TEST_ASSERT_EQUAL_size_t(2, bus->fifoSamples());
+    TEST_ASSERT_EQUAL_INT16(22, samples[22].accel[0]);
+
+    count = imu->readFifo(samples, 32);
+    TEST_ASSERT_EQUAL_size_t(2, count);
+    TEST_ASSERT_EQUAL_INT16(23, samples[0].accel[0]);
+}
+
+void test_fifo_timestamps_stay_continuous_across_bursts(void) {
+    TEST_ASSERT_TRUE(imu->configure(1, 1000));
+    TEST_ASSERT_TRUE(imu->enableFifo());
+    ImuSample samples[4];
+
+    pushSample(0);
+    pushSample(1);
+    imu->handleDataReady(2000);
+    TEST_ASSERT_EQUAL_size_t(2, imu->readFifo(samples, 4));
+    TEST_ASSERT_EQUAL_UINT32(2000, samples[1].timestampUs);
+
+    // Flanco de INT con 300 us de jitter: se mantiene la rejilla del sensor
+    pushSample(2);
+    pushSample(3);
+    imu->handleDataReady(4300);
+    TEST_ASSERT_EQUAL_size_t(2, imu->readFifo(samples, 4));
+    TEST_ASSERT_EQUAL_UINT32(3000, samples[0].timestampUs);
+    TEST_ASSERT_EQUAL_UINT32(4000, samples[1].timestampUs);
+
+    // Deriva mayor que un periodo: se reancla al flanco
+    pushSample(4);
+    imu->handleDataReady(8000);
+    TEST_ASSERT_EQUAL_size_t(1, imu->readFifo(samples, 4));
+    TEST_ASSERT_EQUAL_UINT32(8000, samples[0].timestampUs);
+}
+
+void test_fifo_overflow_discards_and_counts(void) {
+    TEST_ASSERT_TRUE(imu->configure(1, 1000));
+    TEST_ASSERT_TRUE(imu->enableFifo());
+    for (int i = 0; i < 5; i++) pushSample((int16_t)i);
+    bus->registers[MPU6050_REG_INT_STATUS] = 0x10;
+
+    ImuSample samples[8];
+    TEST_ASSERT_EQUAL_size_t(0, imu->readFifo(samples, 8));
+    TEST_ASSERT_EQUAL_UINT32(1, imu->getOverflowCount());
+    TEST_ASSERT_EQUAL_size_t(0, bus->fifoSamples());
+}
+
+void test_fifo_read_failure_resets_fifo(void) {
+    TEST_ASSERT_TRUE(imu->configure(1, 1000));
+    TEST_ASSERT_TRUE(imu->enableFifo());
+    for (int i = 0; i < 3; i++) pushSample((int16_t)i);
+    int resets = bus->writeCount[MPU6050_REG_USER_CTRL];
+
+    // Estado y contador se leen bien, la ráfaga falla: no se puede confiar
+    // en la alineación y el FIFO se vacía
+    bus->failFifoReads = true;
+    ImuSample samples[8];
+    TEST_ASSERT_EQUAL_size_t(0, imu->readFifo(samples, 8));
+    TEST_ASSERT_EQUAL_INT(resets + 1, bus->writeCount[MPU6050_REG_USER_CTRL]);
+    TEST_ASSERT_EQUAL_size_t(0, bus->fifoSamples());
+
+    // Tras recuperarse el bus se vuelven a leer muestras nuevas
+    bus->failFifoReads = false;
+    pushSample(7);
+    TEST_ASSERT_EQUAL_size_t(1, imu->readFifo(samples, 8));
+    TEST_ASSERT_EQUAL_INT16(7, samples[0].accel[0]);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_begin_wakes_sensor_with_fixed_ranges);
+    RUN_TEST(test_begin_rejects_wrong_device);
+    RUN_TEST(test_begin_fails_when_bus_fails);
+    RUN_TEST(test_configure_sets_divider_and_period);
+    RUN_TEST(test_read_raw_skips_temperature);
+    RUN_TEST(test_enable_fifo_resets_and_enables_interrupts);
+    RUN_TEST(test_fifo_burst_decodes_and_timestamps);
+    RUN_TEST(test_fifo_reads_in_chunks_and_respects_max);
+    RUN_TEST(test_fifo_timestamps_stay_continuous_across_bursts);
+    RUN_TEST(test_fifo_overflow_discards_and_counts);
+    RUN_TEST(test_fifo_read_failure_resets_fifo);
+    return UNITY_END();
+}
@@ -0,0 +1,126 @@
+#include <unity.h>
+#include <math.h>
+#include "OutputShaping.h"
+
+static constexpr OutputShapingConfig LINEAR = { 0.5f, 0.0f, 0.0f };
+static constexpr OutputShapingConfig SHAPED = { THROTTLE_CURVE_MID, THROTTLE_CURVE_EXPO, THRUST_LINEARIZATION };
+static constexpr OutputShapingConfig STRONG = { 0.35f, 1.0f, 0.9f };
+
+// Las tablas se construyen al compilar, como en FlightPipeline
+static constexpr OutputShaper linearShaper(LINEAR);
+static constexpr OutputShaper shapedShaper(SHAPED);
+static constexpr OutputShaper strongShaper(STRONG);
+static_assert(linearShaper.isValid(), "tabla lineal no monótona");
+static_assert(shapedShaper.isValid(), "tablas de config.h no monótonas");
+static_assert(strongShaper.isValid(), "tablas extremas no monótonas");
+
+// Una curva que se da la vuelta se detecta en tiempo de compilación
+static_assert(!OutputShaper(OutputShapingConfig{ 0.5f, 3.0f, 0.0f }).isValid(), "expo > 1 debería invertir");
+
+// Error de la interpolación entre puntos de la tabla. Con la configuración
+// de config.h queda por debajo de un microsegundo de ESC; con una
+// linealización casi cuadrática la inversa es muy curva cerca de cero y el
+// error en el primer tramo llega al 1%
+static const float LUT_TOLERANCE = 1e-3f;
+static const float STRONG_LUT_TOLERANCE = 1.5e-2f;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_constexpr_sqrt(void) {
+    const float values[] = { 1e-6f, 0.01f, 0.36f, 1.0f, 2.0f, 100.0f, 12345.0f };
+    for (float value : values) {
+        TEST_ASSERT_FLOAT_WITHIN(sqrtf(value) * 1e-6f, sqrtf(value), constexprSqrt(value));
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, constexprSqrt(0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, constexprSqrt(-4.0f));
+}
+
+void test_linear_config_is_identity(void) {
+    float outputs[3] = { 0.0f, 0.37f, 1.0f };
+    linearShaper.linearizeThrust(outputs, 3);
+    for (int i = 0; i <= 100; i++) {
+        float x = i / 100.0f;
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, x, linearShaper.shapeThrottle(x));
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.37f, outputs[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, outputs[2]);
+}
+
+void test_throttle_curve_fixed_points(void) {
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, throttleCurve(STRONG, 0.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, STRONG.throttleMid, throttleCurve(STRONG, STRONG.throttleMid));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, throttleCurve(STRONG, 1.0f));
+
+    // Con expo la pendiente en el punto medio es 1 - expo: más fina en hover
+    const float h = 1e-3f;
+    float slope =
+        (throttleCurve(SHAPED, SHAPED.throttleMid + h) - throttleCurve(SHAPED, SHAPED.throttleMid - h)) / (2 * h);
+    TEST_ASSERT_FLOAT_WITHIN(1e-2f, 1.0f - SHAPED.throttleExpo, slope);
+}
+
+void test_thrust_command_inverts_the_thrust_model(void) {
+    const float a = STRONG.thrustLinearization;
+    for (int i = 0; i <= 100; i++) {
+        float thrust = i / 100.0f;
+        float command = thrustToCommand(STRONG, thrust);
+        TEST_ASSERT_FLOAT_WITHIN(1e-5f, thrust, (1.0f - a) * command + a * command * command);
+    }
+}
+
+void test_tables_match_the_exact_curves(void) {
+    const OutputShapingConfig* configs[] = { &SHAPED, &STRONG };
+    const OutputShaper* shapers[] = { &shapedShaper, &strongShaper };
+    const float tolerances[] = { LUT_TOLERANCE, STRONG_LUT_TOLERANCE };
+    for (int c = 0; c < 2; c++) {
+        float maxThrottleError = 0.0f, maxThrustError = 0.0f;
+        for (int i = 0; i <= 1000; i++) {
+            float x = i / 1000.0f;
+            float output = x;
+            shapers[c]->linearizeThrust(&output, 1);
+            float throttle = shapers[c]->shapeThrottle(x);
+            maxThrottleError = fmaxf(maxThrottleError, fabsf(throttle - throttleCurve(*configs[c], x)));
+            maxThrustError = fmaxf(maxThrustError, fabsf(output - thrustToCommand(*configs[c], x)));
+        }
+        TEST_ASSERT_TRUE(maxThrottleError < tolerances[c]);
+        TEST_ASSERT_TRUE(maxThrustError < tolerances[c]);
+    }
+}
+
+void test_lookup_is_monotonic_and_clamped(void) {
+    float previousThrottle = -1.0f, previousCommand = -1.0f;
+    for (int i = 0; i <= 1000; i++) {
+        float x = i / 1000.0f;
+        float command = x;
+        strongShaper.linearizeThrust(&command, 1);
+        float throttle = strongShaper.shapeThrottle(x);
+        TEST_ASSERT_TRUE(throttle >= previousThrottle);
+        TEST_ASSERT_TRUE(command >= previousCommand);
+        previousThrottle = throttle;
+        previousCommand = command;
+    }
+
+    // Fuera de [0, 1] se usan los extremos de la tabla
+    float outputs[2] = { -0.2f, 1.3f };
+    strongShaper.linearizeThrust(outputs, 2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, outputs[0]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1.0f, outputs[1]);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.0f, strongShaper.shapeThrottle(-1.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 1.0f, strongShaper.shapeThrottle(2.0f));
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_constexpr_sqrt);
+    RUN_TEST(test_linear_config_is_identity);
+    RUN_TEST(test_throttle_curve_fixed_points);
+    RUN_TEST(test_thrust_command_inverts_the_thrust_model);
+    RUN_TEST(test_tables_match_the_exact_curves);
+    RUN_TEST(test_lookup_is_monotonic_and_clamped);
+    return UNITY_END();
+}
@@ -0,0 +1,198 @@
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include <atomic>
+#include <thread>
+#include "Parameters.h"
+#include "SpscChannel.h"
+
+static ParameterRegistry registry;
+
+void setUp(void) {
+    registry = ParameterRegistry();
+}
+
+void tearDown(void) {
+}
+
+void test_descriptors_are_valid_nvs_keys(void) {
+    for (int id = 0; id < ParameterRegistry::getCount(); id++) {
+        const char* name = ParameterRegistry::getDescriptor(id).name;
+        TEST_ASSERT_TRUE(strlen(name) > 0);
+        TEST_ASSERT_TRUE_MESSAGE(strlen(name) <= 15, name);
+        for (int other = id + 1; other < ParameterRegistry::getCount(); other++) {
+            TEST_ASSERT_TRUE_MESSAGE(strcmp(name, ParameterRegistry::getDescriptor(other).name) != 0, name);
+        }
+    }
+}
+
+void test_defaults_are_within_range(void) {
+    for (int id = 0; id < ParameterRegistry::getCount(); id++) {
+        const ParameterDescriptor& descriptor = ParameterRegistry::getDescriptor(id);
+        float value = registry.get(id);
+        TEST_ASSERT_TRUE_MESSAGE(descriptor.minValue <= descriptor.maxValue, descriptor.name);
+        TEST_ASSERT_TRUE_MESSAGE(value >= descriptor.minValue && value <= descriptor.maxValue, descriptor.name);
+    }
+}
+
+void test_find_by_name(void) {
+    TEST_ASSERT_EQUAL_INT(PARAMETER_ID_rollP, ParameterRegistry::find("roll_p"));
+    TEST_ASSERT_EQUAL_INT(PARAMETER_ID_airmode, ParameterRegistry::find("airmode"));
+    TEST_ASSERT_EQUAL_INT(-1, ParameterRegistry::find("roll"));
+    TEST_ASSERT_EQUAL_INT(-1, ParameterRegistry::find(""));
+}
+
+void test_set_writes_the_snapshot_field(void) {
+    TEST_ASSERT_EQUAL_INT(PARAMETER_OK, registry.set("pitch_d", 0.25f));
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, registry.getValues().pitchD);
+    TEST_ASSERT_EQUAL_FLOAT(0.25f, registry.get(PARAMETER_ID_pitchD));
+
+    // Los vecinos no cambian
+    TEST_ASSERT_EQUAL_FLOAT(DEFAULT_FLIGHT_PARAMETERS.pitchI, registry.getValues().pitchI);
+    TEST_ASSERT_EQUAL_FLOAT(DEFAULT_FLIGHT_PARAMETERS.pitchMax, registry.getValues().pitchMax);
+}
+
+void test_out_of_range_and_unknown_are_rejected(void) {
+    uint32_t revision = registry.getRevision();
+    TEST_ASSERT_EQUAL_INT(PARAMETER_OUT_OF_RANGE, registry.set("roll_p", 10.5f));
+    TEST_ASSERT_EQUAL_INT(PARAMETER_OUT_OF_RANGE, registry.set("roll_p", -0.1f));
+    TEST_ASSERT_EQUAL_INT(PARAMETER_OUT_OF_RANGE, registry.set("roll_p", NAN));
+    TEST_ASSERT_EQUAL_INT(PARAMETER_UNKNOWN, registry.set("nope", 1.0f));
+    TEST_ASSERT_EQUAL_INT(PARAMETER_UNKNOWN, registry.set(PARAMETER_COUNT, 1.0f));
+    TEST_ASSERT_EQUAL_INT(PARAMETER_UNKNOWN, registry.set(-1, 1.0f));
+    TEST_ASSERT_EQUAL_UINT32(revision, registry.getRevision());
+    TEST_ASSERT_EQUAL_FLOAT(DEFAULT_FLIGHT_PARAMETERS.rollP, registry.getValues().rollP);
+
+    // Los extremos del rango son válidos
+    TEST_ASSERT_EQUAL_INT(PARAMETER_OK, registry.set("roll_p", 0.0f));
+    TEST_ASSERT_EQUAL_INT(PARAMETER_OK, registry.set("roll_p", 10.0f));
+}
+
+void test_integer_parameters_round(void) {
+    TEST_ASSERT_EQUAL_INT(PARAMETER_OK, registry.set("airmode", 0.6f));
+    TEST_ASSERT_EQUAL_INT32(1, registry.getValues().airmode);
+    TEST_ASSERT_EQUAL_INT(PARAMETER_OK, registry.set("airmode", 0.4f));
+    TEST_ASSERT_EQUAL_INT32(0, registry.getValues().airmode);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, registry.get(PARAMETER_ID_airmode));
+    TEST_ASSERT_EQUAL_INT(PARAMETER_OUT_OF_RANGE, registry.set("airmode", 2.0f));
+}
+
+void test_revision_counts_accepted_writes(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, registry.getRevision());
+    registry.set("yaw_p", 1.0f);
+    registry.set("yaw_p", 1.0f);  // Mismo valor: también es una escritura
+    TEST_ASSERT_EQUAL_UINT32(2, registry.getRevision());
+    registry.resetToDefaults();
+    TEST_ASSERT_EQUAL_UINT32(3, registry.getRevision());
+}
+
+void test_reset_returns_to_airframe_defaults(void) {
+    FlightParameters defaults = DEFAULT_FLIGHT_PARAMETERS;
+    defaults.rollP = 2.5f;
+    defaults.airmode = 0;
+    ParameterRegistry custom(defaults);
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, custom.get(PARAMETER_ID_rollP));
+
+    custom.set("roll_p", 7.0f);
+    custom.set("airmode", 1.0f);
+    custom.resetToDefaults();
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, custom.getValues().rollP);
+    TEST_ASSERT_EQUAL_INT32(0, custom.getValues().airmode);
+    TEST_ASSERT_EQUAL_MEMORY(&defaults, &custom.getValues(), sizeof(FlightParameters));
+    TEST_ASSERT_EQUAL_MEMORY(&defaults, &custom.getDefaults(), sizeof(FlightParameters));
+}
+
+void test_every_parameter_round_trips(void) {
+    for (int id = 0; id < ParameterRegistry::getCount(); id++) {
+        const ParameterDescriptor& descriptor = ParameterRegistry::getDescriptor(id);
+        float value = descriptor.type == PARAMETER_INT ? descriptor.maxValue
+                                                       : 0.5f * (descriptor.minValue + descriptor.maxValue);
+        TEST_ASSERT_EQUAL_INT_MESSAGE(PARAMETER_OK, registry.set(descriptor.name, value), descriptor.name);
+        TEST_ASSERT_EQUAL_FLOAT(value, registry.get(id));
+    }
+}
+
+// Valor de cada parámetro en la revisión `sequence` del escritor. roll_max y
+// pitch_max llevan la propia secuencia (dígitos en base 1000) para que el
+// lector sepa qué esperar en los demás campos
+static float revisionValue(int id, uint32_t sequence) {
+    if (id == PARAMETER_ID_rollMax) return (float)(sequence % 1000);
+    if (id == PARAMETER_ID_pitchMax) return (float)(sequence / 1000 % 1000);
+    const ParameterDescriptor& descriptor = ParameterRegistry::getDescriptor(id);
+    if (descriptor.type == PARAMETER_INT) return (float)((sequence + id) % 2);
+    float fraction = ((sequence * (uint32_t)(id + 1) * 37u) % 1000) / 1000.0f;
+    return descriptor.minValue + (descriptor.maxValue - descriptor.minValue) * fraction;
+}
+
+static uint32_t snapshotSequence(const FlightParameters& snapshot) {
+    return (uint32_t)snapshot.rollMax + 1000u * (uint32_t)snapshot.pitchMax;
+}
+
+static bool isConsistent(const FlightParameters& snapshot) {
+    uint32_t sequence = snapshotSequence(snapshot);
+    ParameterRegistry view(snapshot);  // Lectura por descriptor, como get()
+    for (int id = 0; id < ParameterRegistry::getCount(); id++) {
+        if (view.get(id) != revisionValue(id, sequence)) return false;
+    }
+    return true;
+}
+
+// Como en main.cpp: la tarea de comunicaciones escribe en el registro campo
+// a campo y publica la instantánea; la de control la consume en otro hilo y
+// nunca debe ver una mezcla de dos revisiones
+void test_published_snapshots_are_never_mixed(void) {
+    static SpscChannel<FlightParameters> channel;
+    const uint32_t revisions = 200000;
+    std::atomic<bool> done(false);
+    uint32_t reads = 0, torn = 0, backwards = 0, last = 0;
+
+    std::thread consumer([&]() {
+        FlightParameters snapshot;
+        for (;;) {
+            bool finished = done.load(std::memory_order_acquire);
+            if (channel.consume(snapshot)) {
+                uint32_t sequence = snapshotSequence(snapshot);
+                reads++;
+                if (!isConsistent(snapshot)) torn++;
+                if (sequence <= last) backwards++;
+                last = sequence;
+            }
+            if (finished) break;
+        }
+    });
+
+    uint32_t rejected = 0;
+    for (uint32_t sequence = 1; sequence <= revisions; sequence++) {
+        for (int id = 0; id < ParameterRegistry::getCount(); id++) {
+            if (registry.set(id, revisionValue(id, sequence)) != PARAMETER_OK) rejected++;
+        }
+        channel.publish(registry.getValues());
+    }
+    done.store(true, std::memory_order_release);
+    consumer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, rejected);
+    TEST_ASSERT_EQUAL_UINT32(revisions * PARAMETER_COUNT, registry.getRevision());
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, backwards);
+    TEST_ASSERT_GREATER_THAN(0, reads);
+    // La última instantánea publicada llega siempre
+    TEST_ASSERT_EQUAL_UINT32(revisions, last);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_descriptors_are_valid_nvs_keys);
+    RUN_TEST(test_defaults_are_within_range);
+    RUN_TEST(test_find_by_name);
+    RUN_TEST(test_set_writes_the_snapshot_field);
+    RUN_TEST(test_out_of_range_and_unknown_are_rejected);
+    RUN_TEST(test_integer_parameters_round);
+    RUN_TEST(test_revision_counts_accepted_writes);
+    RUN_TEST(test_reset_returns_to_airframe_defaults);
+    RUN_TEST(test_every_parameter_round_trips);
+    RUN_TEST(test_published_snapshots_are_never_mixed);
+    return UNITY_END();
+}
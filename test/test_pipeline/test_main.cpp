@@ -0,0 +1,210 @@
+#include <unity.h>
+#include <string.h>
+#include "ComplementaryFilter.h"
+#include "FlightPipeline.h"
+#include "MahonyAHRS.h"
+#include "Mixer.h"
+#include "PID.h"
+
+// FlightPipeline instanciado en el host con políticas de prueba: un sensor
+// en reposo y una salida que guarda los pulsos. El tamaño de la salida es
+// parte de su tipo, así un marco con otro número de motores no compila.
+
+static uint32_t nowUs;
+
+static uint32_t testClock() {
+    return nowUs;
+}
+
+struct LevelSensor {
+    static constexpr bool usesFifo = false;
+    ImuSample sample;
+    bool initialized = false;
+
+    bool init(const ImuConfig& config) {
+        memset(&sample, 0, sizeof(sample));
+        sample.accel[2] = (int16_t)config.accelSensitivity;  // 1 g en Z
+        initialized = true;
+        return true;
+    }
+    bool startFifo() { return true; }
+    size_t read(ImuSample* samples, size_t maxSamples) {
+        if (maxSamples == 0) return 0;
+        samples[0] = sample;
+        samples[0].timestampUs = nowUs;
+        return 1;
+    }
+    uint32_t pendingSamples() const { return 1; }
+    uint32_t getSamplePeriodUs() const { return 1000; }
+};
+
+template <int MotorCount>
+class RecordingOutput final : public MotorOutput<MotorCount> {
+public:
+    uint8_t pins[MotorCount];
+    int pulses[MotorCount];
+    int writes = 0;
+
+    bool init(const uint8_t* motorPins) override {
+        memcpy(pins, motorPins, sizeof(pins));
+        return true;
+    }
+    void write(const int (&pulsesUs)[MotorCount]) override {
+        memcpy(pulses, pulsesUs, sizeof(pulses));
+        writes++;
+    }
+};
+
+constexpr AirframeConfig hexConfig() {
+    AirframeConfig config = DEFAULT_AIRFRAME_CONFIG;
+    config.frame = FRAME_HEX_X;
+    config.esc.motorCount = 6;
+    config.esc.armTimeUs = 1000;
+    config.parameters.rollP = 0.125f;
+    config.parameters.yawMax = 123.0f;
+    config.shaping.thrustLinearization = 0.0f;
+    return config;
+}
+
+struct QuadAirframe {
+    static constexpr AirframeConfig config = DEFAULT_AIRFRAME_CONFIG;
+
+    using Sensor = LevelSensor;
+    using Estimator = MahonyAHRS;
+    using Controller = PIDController;
+    using MotorMixer = Mixer;
+    using Output = RecordingOutput<config.esc.motorCount>;
+
+    static constexpr MahonyAHRS::Config estimatorConfig = { MAHONY_KP, MAHONY_KI };
+};
+
+struct HexAirframe {
+    static constexpr AirframeConfig config = hexConfig();
+
+    using Sensor = LevelSensor;
+    using Estimator = ComplementaryFilter;
+    using Controller = PIDController;
+    using MotorMixer = Mixer;
+    using Output = RecordingOutput<config.esc.motorCount>;
+
+    static constexpr ComplementaryFilter::Config estimatorConfig = { GYRO_FILTER_ALPHA };
+};
+
+template class FlightPipeline<QuadAirframe>;
+template class FlightPipeline<HexAirframe>;
+
+static const int32_t zeroOffsets[3] = { 0, 0, 0 };
+
+template <typename Airframe>
+struct Rig {
+    typename Airframe::Sensor sensor;
+    typename Airframe::Output output;
+    Logger logger;
+    StateBus stateBus;
+    FlightPipeline<Airframe> pipeline;
+
+    Rig() : logger(testClock), pipeline(sensor, output, testClock, logger, stateBus) {}
+
+    void tick(int count) {
+        for (int i = 0; i < count; i++) {
+            nowUs += 1000;
+            pipeline.update();
+        }
+    }
+
+    void command(float throttle, bool arm) {
+        ControlInputs inputs;
+        memset(&inputs, 0, sizeof(inputs));
+        inputs.throttle = throttle;
+        inputs.armCmd = arm;
+        pipeline.setInputs(inputs);
+    }
+
+    void arm() {
+        tick(Airframe::config.esc.armTimeUs / 1000 + 1);
+        command(0, true);
+        tick(1);
+    }
+};
+
+void setUp(void) {
+    nowUs = 1000;
+}
+
+void tearDown(void) {
+}
+
+void test_quad_init_writes_arm_pulse_to_four_motors(void) {
+    static Rig<QuadAirframe> rig;
+    TEST_ASSERT_TRUE(rig.pipeline.init(zeroOffsets));
+    TEST_ASSERT_TRUE(rig.sensor.initialized);
+    TEST_ASSERT_EQUAL_INT(4, FlightPipeline<QuadAirframe>::motorCount);
+    TEST_ASSERT_EQUAL_UINT8(PIN_ESC_4, rig.output.pins[3]);
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(ESC_ARM_PULSE, rig.output.pulses[i]);
+    }
+}
+
+void test_hex_drives_six_motors(void) {
+    static Rig<HexAirframe> rig;
+    TEST_ASSERT_TRUE(rig.pipeline.init(zeroOffsets));
+    TEST_ASSERT_EQUAL_INT(6, FlightPipeline<HexAirframe>::motorCount);
+    TEST_ASSERT_EQUAL_INT(6, rig.pipeline.getMixer().getMotorCount());
+    TEST_ASSERT_EQUAL_UINT8(PIN_ESC_6, rig.output.pins[5]);
+
+    rig.arm();
+    TEST_ASSERT_TRUE(rig.pipeline.isArmed());
+    rig.command(50, false);
+    rig.tick(50);
+
+    // Sin linealización, en reposo y nivelado los seis motores van a medio gas
+    const int* outputs = rig.pipeline.getMotorOutputs();
+    int middle = (HexAirframe::config.esc.minPulse + HexAirframe::config.esc.maxPulse) / 2;
+    for (int i = 0; i < 6; i++) {
+        TEST_ASSERT_INT_WITHIN(5, middle, rig.output.pulses[i]);
+        TEST_ASSERT_EQUAL_INT(outputs[i], rig.output.pulses[i]);
+    }
+
+    // El bus de estado publica exactamente los motores del marco
+    MotorState motors;
+    TEST_ASSERT_TRUE(rig.stateBus.motors.read(motors) != 0);
+    TEST_ASSERT_EQUAL_UINT8(6, motors.count);
+    TEST_ASSERT_EQUAL_UINT16(0, motors.outputs[6]);
+}
+
+void test_parameters_come_from_airframe_config(void) {
+    static Rig<HexAirframe> rig;
+    TEST_ASSERT_EQUAL_FLOAT(0.125f, rig.pipeline.getParameters().rollP);
+    TEST_ASSERT_TRUE(rig.pipeline.init(zeroOffsets));
+    TEST_ASSERT_EQUAL_FLOAT(0.125f, rig.pipeline.getParameters().rollP);
+    TEST_ASSERT_EQUAL_FLOAT(123.0f, rig.pipeline.getParameters().yawMax);
+
+    // El registro parte de los mismos valores y vuelve a ellos con $defaults
+    ParameterRegistry registry(HexAirframe::config.parameters);
+    TEST_ASSERT_EQUAL_FLOAT(0.125f, registry.getValues().rollP);
+    TEST_ASSERT_EQUAL(PARAMETER_OK, registry.set("roll_p", 2.0f));
+    registry.resetToDefaults();
+    TEST_ASSERT_EQUAL_FLOAT(0.125f, registry.getValues().rollP);
+}
+
+void test_disarmed_outputs_stay_at_minimum(void) {
+    static Rig<QuadAirframe> rig;
+    TEST_ASSERT_TRUE(rig.pipeline.init(zeroOffsets));
+    rig.command(60, false);
+    rig.tick(20);
+    TEST_ASSERT_FALSE(rig.pipeline.isArmed());
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(ESC_MIN_PULSE, rig.output.pulses[i]);
+    }
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_quad_init_writes_arm_pulse_to_four_motors);
+    RUN_TEST(test_hex_drives_six_motors);
+    RUN_TEST(test_parameters_come_from_airframe_config);
+    RUN_TEST(test_disarmed_outputs_stay_at_minimum);
+    return UNITY_END();
+}
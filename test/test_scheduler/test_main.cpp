@@ -0,0 +1,223 @@
+#include <unity.h>
+#include "Scheduler.h"
+
+static const uint32_t TICK_US = 1000;
+
+// Reloj simulado: sólo avanza cuando lo mueve la prueba o un trabajo
+static uint32_t fakeNowUs;
+
+static uint32_t fakeClock() {
+    return fakeNowUs;
+}
+
+// Trabajo simulado: ocupa `durationUs` del reloj y apunta su turno
+struct FakeJob {
+    int id;
+    uint32_t durationUs;
+    uint32_t runs;
+};
+
+static int runOrder[32];
+static int runOrderCount;
+
+static void fakeJob(void* context) {
+    FakeJob* job = (FakeJob*)context;
+    job->runs++;
+    if (runOrderCount < 32) runOrder[runOrderCount++] = job->id;
+    fakeNowUs += job->durationUs;
+}
+
+// Avanza el reloj a pasos de `stepUs` llamando a poll(); devuelve los ticks
+static uint32_t pollFor(Scheduler& scheduler, uint32_t durationUs, uint32_t stepUs) {
+    uint32_t ticks = 0;
+    uint32_t end = fakeNowUs + durationUs;
+    while ((int32_t)(end - fakeNowUs) > 0) {
+        if (scheduler.poll()) ticks++;
+        fakeNowUs += stepUs;
+    }
+    return ticks;
+}
+
+void setUp(void) {
+    fakeNowUs = 0;
+    runOrderCount = 0;
+}
+
+void tearDown(void) {
+}
+
+void test_add_task_fails_when_full(void) {
+    Scheduler scheduler(fakeClock, TICK_US);
+    FakeJob job = { 0, 0, 0 };
+    for (int i = 0; i < SCHEDULER_MAX_TASKS; i++) {
+        TEST_ASSERT_TRUE(scheduler.addTask("trabajo", fakeJob, &job, 0, 1, 0) >= 0);
+    }
+    TEST_ASSERT_EQUAL_INT(-1, scheduler.addTask("sobra", fakeJob, &job, 0, 1, 0));
+    TEST_ASSERT_EQUAL_INT(SCHEDULER_MAX_TASKS, scheduler.getTaskCount());
+
+    Scheduler empty(fakeClock, TICK_US);
+    TEST_ASSERT_EQUAL_INT(-1, empty.addTask("nulo", nullptr, nullptr, 0, 1, 0));
+    TEST_ASSERT_EQUAL_INT(0, empty.getTaskCount());
+}
+
+void test_tasks_run_in_priority_order(void) {
+    Scheduler scheduler(fakeClock, TICK_US);
+    FakeJob jobs[5] = { { 0, 0, 0 }, { 1, 0, 0 }, { 2, 0, 0 }, { 3, 0, 0 }, { 4, 0, 0 } };
+    // Registradas desordenadas; a igual prioridad se respeta el orden de alta
+    scheduler.addTask("d", fakeJob, &jobs[3], 0, 3, 0);
+    scheduler.addTask("b", fakeJob, &jobs[1], 0, 1, 0);
+    scheduler.addTask("e", fakeJob, &jobs[4], 0, 3, 0);
+    scheduler.addTask("a", fakeJob, &jobs[0], 0, SCHEDULER_PRIORITY_CRITICAL, 0);
+    scheduler.addTask("c", fakeJob, &jobs[2], 0, 2, 0);
+
+    scheduler.runTick(fakeNowUs);
+    const int expected[5] = { 0, 1, 2, 3, 4 };
+    TEST_ASSERT_EQUAL_INT(5, runOrderCount);
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, runOrder, 5);
+    TEST_ASSERT_EQUAL_STRING("a", scheduler.getTask(0).name);
+    TEST_ASSERT_EQUAL_STRING("e", scheduler.getTask(4).name);
+}
+
+void test_poll_keeps_the_tick_period(void) {
+    Scheduler scheduler(fakeClock, TICK_US);
+    TEST_ASSERT_EQUAL_UINT32(1000, pollFor(scheduler, 1000000, 50));
+    TEST_ASSERT_EQUAL_UINT32(1000, scheduler.getTickCount());
+
+    // Antes de tiempo no hay tick
+    fakeNowUs = 1000000 + 10;
+    TEST_ASSERT_TRUE(scheduler.poll());
+    fakeNowUs += TICK_US - 20;
+    TEST_ASSERT_FALSE(scheduler.poll());
+
+    // Ticks perdidos: uno solo, no una ráfaga, y el siguiente a un periodo
+    fakeNowUs += 5500;
+    TEST_ASSERT_TRUE(scheduler.poll());
+    TEST_ASSERT_FALSE(scheduler.poll());
+    fakeNowUs += TICK_US - 1;
+    TEST_ASSERT_FALSE(scheduler.poll());
+    fakeNowUs += 1;
+    TEST_ASSERT_TRUE(scheduler.poll());
+}
+
+void test_periodic_tasks_run_at_their_rate(void) {
+    Scheduler scheduler(fakeClock, TICK_US);
+    FakeJob fast = { 0, 0, 0 };    // 250 Hz
+    FakeJob slow = { 1, 0, 0 };    // 100 Hz
+    FakeJob odd = { 2, 0, 0 };     // 333 Hz, periodo fuera de la rejilla
+    FakeJob every = { 3, 0, 0 };   // periodo 0: en cada tick
+    scheduler.addTask("rapida", fakeJob, &fast, 4000, 1, 100);
+    scheduler.addTask("lenta", fakeJob, &slow, 10000, 2, 100);
+    scheduler.addTask("impar", fakeJob, &odd, 3000, 2, 100);
+    scheduler.addTask("siempre", fakeJob, &every, 0, 3, 100);
+
+    pollFor(scheduler, 1000000, 50);
+    TEST_ASSERT_EQUAL_UINT32(250, fast.runs);
+    TEST_ASSERT_EQUAL_UINT32(100, slow.runs);
+    TEST_ASSERT_EQUAL_UINT32(334, odd.runs);
+    TEST_ASSERT_EQUAL_UINT32(1000, every.runs);
+    TEST_ASSERT_EQUAL_UINT32(250, scheduler.getTask(0).runCount);
+}
+
+void test_clock_wraparound(void) {
+    Scheduler scheduler(fakeClock, TICK_US);
+    fakeNowUs = 0xFFFFFFFFu - 5000;
+    FakeJob job = { 0, 0, 0 };
+    scheduler.addTask("periodica", fakeJob, &job, 2000, 1, 100);
+    TEST_ASSERT_EQUAL_UINT32(20, pollFor(scheduler, 20000, 50));
+    TEST_ASSERT_EQUAL_UINT32(10, job.runs);
+}
+
+void test_low_priority_is_deferred_when_the_tick_is_full(void) {
+    Scheduler scheduler(fakeClock, TICK_US);
+    FakeJob control = { 0, 900, 0 };
+    FakeJob background = { 1, 0, 0 };
+    scheduler.addTask("control", fakeJob, &control, 0, SCHEDULER_PRIORITY_CRITICAL, 950);
+    scheduler.addTask("fondo", fakeJob, &background, 2000, 1, 200);
+
+    // El control deja 100 us y el trabajo de fondo necesita 200: se aplaza
+    for (int tick = 0; tick < 10; tick++) {
+        fakeNowUs = tick * TICK_US;
+        scheduler.runTick(fakeNowUs);
+    }
+    const SchedulerTask& task = scheduler.getTask(1);
+    TEST_ASSERT_EQUAL_UINT32(10, control.runs);
+    TEST_ASSERT_EQUAL_UINT32(0, background.runs);
+    TEST_ASSERT_EQUAL_UINT32(10, task.deferCount);
+    // Tras un periodo entero esperando, cada periodo se da por perdido
+    TEST_ASSERT_TRUE(task.skipCount >= 3 && task.skipCount <= 5);
+
+    // Con margen vuelve a correr en el siguiente tick
+    control.durationUs = 100;
+    fakeNowUs = 10 * TICK_US;
+    scheduler.runTick(fakeNowUs);
+    TEST_ASSERT_EQUAL_UINT32(1, background.runs);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getTask(0).overrunCount);
+}
+
+void test_critical_tasks_are_never_skipped(void) {
+    Scheduler scheduler(fakeClock, TICK_US);
+    // Un control que se pasa del tick: aun así corre en todos
+    FakeJob control = { 0, 1500, 0 };
+    FakeJob input = { 1, 0, 0 };
+    FakeJob background = { 2, 0, 0 };
+    scheduler.addTask("control", fakeJob, &control, 0, SCHEDULER_PRIORITY_CRITICAL, TICK_US);
+    scheduler.addTask("entrada", fakeJob, &input, 5000, SCHEDULER_PRIORITY_CRITICAL, 10);
+    scheduler.addTask("fondo", fakeJob, &background, 2000, 1, 100);
+
+    uint32_t ticks = pollFor(scheduler, 100000, 50);
+    TEST_ASSERT_TRUE(ticks > 0);
+    TEST_ASSERT_EQUAL_UINT32(ticks, control.runs);
+    TEST_ASSERT_EQUAL_UINT32(ticks, input.runs);  // Crítica: ignora su periodo
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getTask(0).deferCount);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getTask(0).skipCount);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getTask(1).skipCount);
+    TEST_ASSERT_EQUAL_UINT32(ticks, scheduler.getTask(0).overrunCount);
+
+    // El de fondo no cabe nunca: aplazado y con periodos perdidos
+    TEST_ASSERT_EQUAL_UINT32(0, background.runs);
+    TEST_ASSERT_TRUE(scheduler.getTask(2).skipCount > 0);
+}
+
+void test_run_and_overrun_counters(void) {
+    Scheduler scheduler(fakeClock, TICK_US);
+    FakeJob job = { 0, 0, 0 };
+    scheduler.addTask("medido", fakeJob, &job, 0, 1, 300);
+
+    // Duraciones alternas por debajo y por encima del presupuesto
+    for (int tick = 0; tick < 20; tick++) {
+        job.durationUs = (tick % 2) ? 400 : 200;
+        fakeNowUs = tick * TICK_US;
+        scheduler.runTick(fakeNowUs);
+    }
+    const SchedulerTask& task = scheduler.getTask(0);
+    TEST_ASSERT_EQUAL_UINT32(20, task.runCount);
+    TEST_ASSERT_EQUAL_UINT32(10, task.overrunCount);
+    TEST_ASSERT_EQUAL_UINT32(400, task.maxDurationUs);
+    TEST_ASSERT_EQUAL_UINT32(20, scheduler.getTickCount());
+
+    scheduler.resetStats();
+    TEST_ASSERT_EQUAL_UINT32(0, task.runCount);
+    TEST_ASSERT_EQUAL_UINT32(0, task.overrunCount);
+    TEST_ASSERT_EQUAL_UINT32(0, task.maxDurationUs);
+
+    // Presupuesto 0: sin límite, nunca cuenta como exceso
+    Scheduler unbudgeted(fakeClock, TICK_US);
+    unbudgeted.addTask("libre", fakeJob, &job, 0, 1, 0);
+    unbudgeted.runTick(fakeNowUs);
+    TEST_ASSERT_EQUAL_UINT32(0, unbudgeted.getTask(0).overrunCount);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_add_task_fails_when_full);
+    RUN_TEST(test_tasks_run_in_priority_order);
+    RUN_TEST(test_poll_keeps_the_tick_period);
+    RUN_TEST(test_periodic_tasks_run_at_their_rate);
+    RUN_TEST(test_clock_wraparound);
+    RUN_TEST(test_low_priority_is_deferred_when_the_tick_is_full);
+    RUN_TEST(test_critical_tasks_are_never_skipped);
+    RUN_TEST(test_run_and_overrun_counters);
+    return UNITY_END();
+}
@@ -0,0 +1,177 @@
+#include <unity.h>
+#include <string.h>
+#include "ComplementaryFilter.h"
+#include "FakeI2CBus.h"
+#include "FlightPipeline.h"
+#include "Mixer.h"
+#include "PID.h"
+
+// Camino entero de los sensores: registros del MPU6050 en big endian ->
+// cuentas int16 -> offsets en punto fijo -> una sola conversión a unidades.
+// Con los filtros desactivados la salida se compara con el cálculo exacto.
+
+static uint32_t nowUs;
+
+static uint32_t testClock() {
+    return nowUs;
+}
+
+// Lectura de registros del driver real sobre el bus simulado
+struct FakeBusSensor {
+    static constexpr bool usesFifo = false;
+    FakeI2CBus bus;
+    MPU6050Driver imu;
+
+    FakeBusSensor() : imu(bus) {}
+
+    bool init(const ImuConfig& config) { return imu.begin() && imu.configure(config.dlpfConfig, config.sampleRateHz); }
+    bool startFifo() { return true; }
+    size_t read(ImuSample* samples, size_t maxSamples) {
+        if (maxSamples == 0 || !imu.readRaw(samples[0])) return 0;
+        return 1;
+    }
+    uint32_t pendingSamples() const { return 1; }
+    uint32_t getSamplePeriodUs() const { return imu.getSamplePeriodUs(); }
+
+    void setGyro(int16_t x, int16_t y, int16_t z) {
+        bus.setWord(MPU6050_REG_ACCEL_XOUT_H + 8, x);
+        bus.setWord(MPU6050_REG_ACCEL_XOUT_H + 10, y);
+        bus.setWord(MPU6050_REG_ACCEL_XOUT_H + 12, z);
+    }
+    void setAccel(int16_t x, int16_t y, int16_t z) {
+        bus.setWord(MPU6050_REG_ACCEL_XOUT_H + 0, x);
+        bus.setWord(MPU6050_REG_ACCEL_XOUT_H + 2, y);
+        bus.setWord(MPU6050_REG_ACCEL_XOUT_H + 4, z);
+    }
+};
+
+class NullOutput final : public MotorOutput<4> {
+public:
+    bool init(const uint8_t* motorPins) override { (void)motorPins; return true; }
+    void write(const int (&pulsesUs)[4]) override { (void)pulsesUs; }
+};
+
+constexpr AirframeConfig unfilteredConfig() {
+    AirframeConfig config = DEFAULT_AIRFRAME_CONFIG;
+    config.esc.motorCount = 4;
+    config.frame = FRAME_QUAD_X;
+    config.dynamicNotch.enable = false;
+    config.parameters.gyroLpfHz = 0;
+    config.parameters.gyroNotchHz = 0;
+    config.parameters.accelLpfHz = 0;
+    return config;
+}
+
+struct UnfilteredAirframe {
+    static constexpr AirframeConfig config = unfilteredConfig();
+
+    using Sensor = FakeBusSensor;
+    using Estimator = ComplementaryFilter;
+    using Controller = PIDController;
+    using MotorMixer = Mixer;
+    using Output = NullOutput;
+
+    static constexpr ComplementaryFilter::Config estimatorConfig = { GYRO_FILTER_ALPHA };
+};
+
+static FakeBusSensor* sensor;
+static NullOutput* output;
+static Logger* logger;
+static StateBus* stateBus;
+static FlightPipeline<UnfilteredAirframe>* pipeline;
+
+static const float GYRO_LSB = UnfilteredAirframe::config.imu.gyroSensitivity;
+static const float ACCEL_LSB = UnfilteredAirframe::config.imu.accelSensitivity;
+
+void setUp(void) {
+    nowUs = 1000;
+    sensor = new FakeBusSensor();
+    output = new NullOutput();
+    logger = new Logger(testClock);
+    stateBus = new StateBus();
+    pipeline = new FlightPipeline<UnfilteredAirframe>(*sensor, *output, testClock, *logger, *stateBus);
+}
+
+void tearDown(void) {
+    delete pipeline;
+    delete stateBus;
+    delete logger;
+    delete output;
+    delete sensor;
+}
+
+static void tick() {
+    nowUs += 1000;
+    pipeline->update();
+}
+
+void test_counts_convert_to_degrees_and_ms2(void) {
+    const int32_t offsets[3] = { 0, 0, 0 };
+    TEST_ASSERT_TRUE(pipeline->init(offsets));
+    sensor->setGyro(1310, -262, 0);
+    sensor->setAccel(0, 8192, 16384);
+    tick();
+
+    const FlightData& data = pipeline->getFlightData();
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 1310 / GYRO_LSB, data.rollRate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, -262 / GYRO_LSB, data.pitchRate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 0.0f, data.yawRate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 9.80665f * 8192 / ACCEL_LSB, data.accelY);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 9.80665f, data.accelZ);
+}
+
+void test_fractional_offsets_are_subtracted_in_fixed_point(void) {
+    // 100.5, -3.25 y 0.0625 cuentas con 4 bits fraccionarios
+    const int32_t offsets[3] = { 1608, -52, 1 };
+    TEST_ASSERT_TRUE(pipeline->init(offsets));
+    sensor->setGyro(100, -3, 0);
+    sensor->setAccel(0, 0, 16384);
+    tick();
+
+    const FlightData& data = pipeline->getFlightData();
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -0.5f / GYRO_LSB, data.rollRate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.25f / GYRO_LSB, data.pitchRate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, -0.0625f / GYRO_LSB, data.yawRate);
+}
+
+void test_full_scale_counts_do_not_overflow(void) {
+    const int32_t offsets[3] = { -16 * 100, 16 * 100, 0 };
+    TEST_ASSERT_TRUE(pipeline->init(offsets));
+    sensor->setGyro(32767, -32768, -32768);
+    sensor->setAccel(-32768, 32767, 0);
+    tick();
+
+    const FlightData& data = pipeline->getFlightData();
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, 32867 / GYRO_LSB, data.rollRate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, -32868 / GYRO_LSB, data.pitchRate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, -32768 / GYRO_LSB, data.yawRate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, -2.0f * 9.80665f, data.accelX);
+}
+
+void test_raw_counts_are_published_unchanged(void) {
+    const int32_t offsets[3] = { 1608, 0, 0 };
+    TEST_ASSERT_TRUE(pipeline->init(offsets));
+    sensor->setGyro(-1234, 567, 89);
+    sensor->setAccel(11, -22, 16000);
+    tick();
+
+    ImuState imu;
+    TEST_ASSERT_TRUE(stateBus->imu.read(imu) != 0);
+    TEST_ASSERT_EQUAL_INT16(-1234, imu.rawGyro[0]);
+    TEST_ASSERT_EQUAL_INT16(567, imu.rawGyro[1]);
+    TEST_ASSERT_EQUAL_INT16(89, imu.rawGyro[2]);
+    TEST_ASSERT_EQUAL_INT16(11, imu.rawAccel[0]);
+    TEST_ASSERT_EQUAL_INT16(16000, imu.rawAccel[2]);
+    TEST_ASSERT_EQUAL_INT16(-1234, pipeline->getRawSample().gyro[0]);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_counts_convert_to_degrees_and_ms2);
+    RUN_TEST(test_fractional_offsets_are_subtracted_in_fixed_point);
+    RUN_TEST(test_full_scale_counts_do_not_overflow);
+    RUN_TEST(test_raw_counts_are_published_unchanged);
+    return UNITY_END();
+}
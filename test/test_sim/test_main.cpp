@@ -0,0 +1,187 @@
+#include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "SimHarness.h"
+
+// Escenarios de vuelo completos: el FlightPipeline real (filtros, estimador,
+// PID, mezclador, failsafe) contra el modelo de SimQuad.h. Las métricas se
+// imprimen para comparar ajustes; los límites sólo detectan regresiones.
+
+static const float LOOP_DT = 1.0f / SimRunner<>::config.loop.rateHz;
+
+// Maniobras con el acelerómetro ideal: con la fuerza específica real el
+// filtro complementario se va a nivel en un alabeo sostenido y lo que se
+// mide es el estimador, no el lazo de control
+static SimQuadParams idealAccelQuad() {
+    SimQuadParams params = SIM_QUAD_DEFAULT;
+    params.idealAccel = true;
+    return params;
+}
+
+static void reportStep(const char* label, const StepMetrics& metrics) {
+    char message[128];
+    snprintf(message, sizeof(message), "%s: subida %.3f s, sobreimpulso %.1f%%, asentamiento %.3f s, error %.2f",
+             label, metrics.riseTimeS, metrics.overshootPct, metrics.settlingTimeS, metrics.finalError);
+    TEST_MESSAGE(message);
+}
+
+static float meanOf(const std::vector<float>& trace) {
+    float sum = 0.0f;
+    for (float value : trace) sum += value;
+    return sum / trace.size();
+}
+
+static float peakOf(const std::vector<float>& trace) {
+    float peak = 0.0f;
+    for (float value : trace) {
+        if (fabsf(value) > peak) peak = fabsf(value);
+    }
+    return peak;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_calibration_removes_gyro_bias(void) {
+    SimRunner<> sim;
+    TEST_ASSERT_TRUE(sim.start());
+
+    // El sesgo del modelo es de casi 1 grado/s; tras calibrar queda el ruido
+    auto rollRate = sim.record(0.5f, [](SimRunner<>& s) { return s.pipeline.getFlightData().rollRate; });
+    auto pitchRate = sim.record(0.5f, [](SimRunner<>& s) { return s.pipeline.getFlightData().pitchRate; });
+    auto yawRate = sim.record(0.5f, [](SimRunner<>& s) { return s.pipeline.getFlightData().yawRate; });
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, meanOf(rollRate));
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, meanOf(pitchRate));
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 0.0f, meanOf(yawRate));
+}
+
+void test_arming_waits_for_calibration(void) {
+    SimRunner<> sim;
+    TEST_ASSERT_TRUE(sim.pipeline.init(nullptr));
+    sim.pilot.armCmd = true;
+    sim.runFor(0.05f);
+    TEST_ASSERT_FALSE(sim.pipeline.isArmed());
+    TEST_ASSERT_TRUE(sim.quad.isGrounded());
+}
+
+void test_hover_stays_level(void) {
+    SimRunner<> sim;
+    TEST_ASSERT_TRUE(sim.start());
+    TEST_ASSERT_TRUE(sim.takeOff(50.0f));
+
+    auto roll = sim.record(2.0f, [](SimRunner<>& s) { return s.quad.getRoll(); });
+    auto pitch = sim.record(2.0f, [](SimRunner<>& s) { return s.quad.getPitch(); });
+    TEST_ASSERT_TRUE(peakOf(roll) < 1.0f);
+    TEST_ASSERT_TRUE(peakOf(pitch) < 1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, sim.quad.getRoll(), sim.pipeline.getFlightData().roll);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, sim.quad.getPitch(), sim.pipeline.getFlightData().pitch);
+    TEST_ASSERT_FALSE(sim.quad.isGrounded());
+}
+
+void test_angle_step_response(void) {
+    SimRunner<> sim(idealAccelQuad());
+    TEST_ASSERT_TRUE(sim.start());
+    TEST_ASSERT_TRUE(sim.takeOff(50.0f));
+
+    // Medio stick = la mitad del ángulo máximo
+    const float target = 0.5f * sim.pipeline.getParameters().maxAngleRoll;
+    sim.pilot.rollCmd = 50.0f;
+    auto roll = sim.record(1.0f, [](SimRunner<>& s) { return s.quad.getRoll(); });
+    StepMetrics metrics = measureStep(roll, LOOP_DT, 0.0f, target, 0.05f * target);
+    reportStep("Escalón de ángulo", metrics);
+
+    TEST_ASSERT_TRUE(metrics.riseTimeS > 0.0f && metrics.riseTimeS < 0.35f);
+    TEST_ASSERT_TRUE(metrics.overshootPct < 3.0f);
+    TEST_ASSERT_TRUE(metrics.settlingTimeS > 0.0f && metrics.settlingTimeS < 0.5f);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, metrics.finalError);
+
+    // Al soltar el stick vuelve a nivel
+    sim.pilot.rollCmd = 0.0f;
+    sim.runFor(1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 0.0f, sim.quad.getRoll());
+}
+
+void test_acro_rate_step_response(void) {
+    SimRunner<> sim(idealAccelQuad());
+    TEST_ASSERT_TRUE(sim.start());
+    TEST_ASSERT_TRUE(sim.takeOff(50.0f));
+
+    const float target = 0.5f * sim.pipeline.getParameters().acroMaxRate;
+    sim.pilot.acroMode = true;
+    sim.pilot.rollCmd = 50.0f;
+    auto rate = sim.record(0.3f, [](SimRunner<>& s) { return s.quad.getRate(0); });
+    StepMetrics metrics = measureStep(rate, LOOP_DT, 0.0f, target, 0.05f * target);
+    reportStep("Escalón de velocidad (acro)", metrics);
+
+    TEST_ASSERT_TRUE(metrics.riseTimeS > 0.0f && metrics.riseTimeS < 0.1f);
+    TEST_ASSERT_TRUE(metrics.overshootPct < 3.0f);
+    TEST_ASSERT_TRUE(metrics.settlingTimeS > 0.0f && metrics.settlingTimeS < 0.15f);
+
+    // Parar el giro en acro y recuperar en ángulo sin perder el quad
+    sim.pilot.rollCmd = 0.0f;
+    sim.runFor(0.3f);
+    sim.pilot.acroMode = false;
+    sim.runFor(1.5f);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, sim.quad.getRoll());
+    TEST_ASSERT_FALSE(sim.quad.isGrounded());
+}
+
+void test_disturbance_rejection(void) {
+    SimRunner<> sim(idealAccelQuad());
+    TEST_ASSERT_TRUE(sim.start());
+    TEST_ASSERT_TRUE(sim.takeOff(50.0f));
+
+    // Par constante en roll (ráfaga lateral): el integral debe absorberlo
+    sim.quad.setDisturbance(0.03f, 0.0f, 0.0f);
+    auto roll = sim.record(4.0f, [](SimRunner<>& s) { return s.quad.getRoll(); });
+
+    char message[96];
+    snprintf(message, sizeof(message), "Perturbación: pico %.2f grados, final %.2f grados", peakOf(roll), roll.back());
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(peakOf(roll) < 12.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, roll.back());
+}
+
+void test_failsafe_levels_lands_and_disarms(void) {
+    SimRunner<> sim(idealAccelQuad());
+    TEST_ASSERT_TRUE(sim.start());
+    TEST_ASSERT_TRUE(sim.takeOff(50.0f));
+    sim.pilot.rollCmd = 30.0f;
+    sim.runFor(0.3f);
+
+    // Se corta el enlace con el stick inclinado: nivelar y mantener altura
+    sim.linkUp = false;
+    sim.runFor(FAILSAFE_LAND_US / 1000000.0f - 0.1f);
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_HOLD, sim.pipeline.getFlightData().failsafe);
+    TEST_ASSERT_TRUE(sim.pipeline.isArmed());
+    TEST_ASSERT_FLOAT_WITHIN(3.0f, 0.0f, sim.quad.getRoll());
+    TEST_ASSERT_FALSE(sim.quad.isGrounded());
+
+    // Rampa de throttle hasta el suelo y desarmado al terminarla
+    sim.runFor(0.2f);
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_LANDING, sim.pipeline.getFlightData().failsafe);
+    sim.runFor(FAILSAFE_RAMP_US / 1000000.0f);
+    TEST_ASSERT_TRUE(sim.quad.isGrounded());
+    TEST_ASSERT_FALSE(sim.pipeline.isArmed());
+    TEST_ASSERT_EQUAL_INT(FAILSAFE_DISARMED, sim.pipeline.getFlightData().failsafe);
+    for (int i = 0; i < SimQuad::motorCount; i++) {
+        TEST_ASSERT_EQUAL_INT(SimRunner<>::config.esc.minPulse, sim.motors.pulses[i]);
+    }
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_calibration_removes_gyro_bias);
+    RUN_TEST(test_arming_waits_for_calibration);
+    RUN_TEST(test_hover_stays_level);
+    RUN_TEST(test_angle_step_response);
+    RUN_TEST(test_acro_rate_step_response);
+    RUN_TEST(test_disturbance_rejection);
+    RUN_TEST(test_failsafe_levels_lands_and_disarms);
+    return UNITY_END();
+}
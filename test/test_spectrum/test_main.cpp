@@ -0,0 +1,171 @@
+#include <unity.h>
+#include <math.h>
+#include "SpectrumAnalyzer.h"
+
+static const float SAMPLE_RATE = 1000.0f;
+static const float MIN_HZ = 60.0f;
+static const float MAX_HZ = 400.0f;
+
+static SpectrumAnalyzer analyzer;
+static uint32_t rngState;
+static uint32_t sampleIndex;
+
+static float noise(float amplitude) {
+    rngState = rngState * 1664525u + 1013904223u;
+    return amplitude * ((float)(rngState >> 8) / 8388608.0f - 1.0f);
+}
+
+struct Tone {
+    float hz;
+    float amplitude;
+};
+
+// Alimenta `count` muestras con tonos distintos por eje y ruido blanco
+static void feed(const Tone (&tones)[FILTER_AXES][2], int count, float noiseAmplitude) {
+    for (int n = 0; n < count; n++, sampleIndex++) {
+        float t = sampleIndex / SAMPLE_RATE;
+        float values[FILTER_AXES];
+        for (int axis = 0; axis < FILTER_AXES; axis++) {
+            values[axis] = noise(noiseAmplitude);
+            for (int k = 0; k < 2; k++) {
+                values[axis] += tones[axis][k].amplitude * sinf(2.0f * (float)M_PI * tones[axis][k].hz * t);
+            }
+        }
+        analyzer.addSample(values);
+    }
+}
+
+// Un análisis completo: un step() por eje
+static void analyzeAll() {
+    for (int axis = 0; axis < FILTER_AXES; axis++) analyzer.step();
+}
+
+void setUp(void) {
+    analyzer.init(SAMPLE_RATE, MIN_HZ, MAX_HZ, 2, DYN_NOTCH_THRESHOLD, 1.0f);
+    rngState = 777;
+    sampleIndex = 0;
+}
+
+void tearDown(void) {
+}
+
+void test_single_tone_per_axis(void) {
+    analyzer.init(SAMPLE_RATE, MIN_HZ, MAX_HZ, 1, DYN_NOTCH_THRESHOLD, 1.0f);
+    const Tone tones[FILTER_AXES][2] = {
+        { { 97.0f, 20.0f }, { 0, 0 } },
+        { { 180.0f, 20.0f }, { 0, 0 } },
+        { { 333.3f, 20.0f }, { 0, 0 } },
+    };
+    feed(tones, DYN_NOTCH_SDFT_SIZE * 2, 1.0f);
+    analyzeAll();
+
+    // La interpolación parabólica resuelve mejor que la anchura de bin
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), 97.0f, analyzer.getPeak(0, 0));
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), 180.0f, analyzer.getPeak(1, 0));
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), 333.3f, analyzer.getPeak(2, 0));
+}
+
+void test_two_peaks_sorted_by_frequency(void) {
+    // El pico alto es el de más frecuencia: aun así queda segundo. El umbral
+    // es relativo a la media del rango, que sube con el propio pico alto.
+    const Tone tones[FILTER_AXES][2] = {
+        { { 250.0f, 25.0f }, { 110.0f, 20.0f } },
+        { { 0, 0 }, { 0, 0 } },
+        { { 0, 0 }, { 0, 0 } },
+    };
+    feed(tones, DYN_NOTCH_SDFT_SIZE * 2, 0.5f);
+    analyzeAll();
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), 110.0f, analyzer.getPeak(0, 0));
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), 250.0f, analyzer.getPeak(0, 1));
+}
+
+void test_noise_and_out_of_range_tones_are_ignored(void) {
+    const Tone tones[FILTER_AXES][2] = {
+        { { 0, 0 }, { 0, 0 } },           // Sólo ruido
+        { { 20.0f, 50.0f }, { 0, 0 } },   // Por debajo del rango vigilado
+        { { 470.0f, 50.0f }, { 0, 0 } },  // Por encima
+    };
+    feed(tones, DYN_NOTCH_SDFT_SIZE * 4, 2.0f);
+    analyzeAll();
+    for (int axis = 0; axis < FILTER_AXES; axis++) {
+        for (int peak = 0; peak < 2; peak++) {
+            float hz = analyzer.getPeak(axis, peak);
+            // Sin pico (0) o, como mucho, la cola del tono en el borde del rango
+            TEST_ASSERT_TRUE(hz == 0.0f || (axis > 0 && (hz < MIN_HZ + 2 * analyzer.getBinWidth() ||
+                                                         hz > MAX_HZ - 2 * analyzer.getBinWidth())));
+        }
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, analyzer.getPeak(0, 0));
+}
+
+void test_peaks_are_kept_when_the_tone_stops(void) {
+    const Tone tone[FILTER_AXES][2] = { { { 150.0f, 20.0f }, { 0, 0 } }, {}, {} };
+    const Tone silence[FILTER_AXES][2] = {};
+    analyzer.init(SAMPLE_RATE, MIN_HZ, MAX_HZ, 1, DYN_NOTCH_THRESHOLD, 1.0f);
+    feed(tone, DYN_NOTCH_SDFT_SIZE * 2, 0.0f);
+    analyzeAll();
+    feed(silence, DYN_NOTCH_SDFT_SIZE * 2, 1.0f);
+    analyzeAll();
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), 150.0f, analyzer.getPeak(0, 0));
+}
+
+void test_smoothing_tracks_frequency_changes(void) {
+    analyzer.init(SAMPLE_RATE, MIN_HZ, MAX_HZ, 1, DYN_NOTCH_THRESHOLD, 0.2f);
+    const Tone low[FILTER_AXES][2] = { { { 120.0f, 20.0f }, { 0, 0 } }, {}, {} };
+    const Tone high[FILTER_AXES][2] = { { { 240.0f, 20.0f }, { 0, 0 } }, {}, {} };
+    feed(low, DYN_NOTCH_SDFT_SIZE * 2, 0.5f);
+    analyzeAll();
+    float start = analyzer.getPeak(0, 0);
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), 120.0f, start);
+
+    // El primer análisis tras el cambio sólo recorre un 20% del salto
+    feed(high, DYN_NOTCH_SDFT_SIZE * 2, 0.5f);
+    analyzeAll();
+    float expected = start + 0.2f * (240.0f - start);
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), expected, analyzer.getPeak(0, 0));
+    for (int i = 0; i < 40; i++) {
+        feed(high, 3, 0.5f);
+        analyzeAll();
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), 240.0f, analyzer.getPeak(0, 0));
+}
+
+void test_step_round_robins_axes(void) {
+    TEST_ASSERT_EQUAL_INT(0, analyzer.step());
+    TEST_ASSERT_EQUAL_INT(1, analyzer.step());
+    TEST_ASSERT_EQUAL_INT(2, analyzer.step());
+    TEST_ASSERT_EQUAL_INT(0, analyzer.step());
+
+    // Sin picos pedidos o sin bins no analiza nada
+    analyzer.init(SAMPLE_RATE, MIN_HZ, MAX_HZ, 0, DYN_NOTCH_THRESHOLD, 1.0f);
+    TEST_ASSERT_EQUAL_INT(-1, analyzer.step());
+    analyzer.init(SAMPLE_RATE, 300.0f, 200.0f, 2, DYN_NOTCH_THRESHOLD, 1.0f);
+    TEST_ASSERT_EQUAL_INT(-1, analyzer.step());
+    TEST_ASSERT_EQUAL_FLOAT(SAMPLE_RATE / DYN_NOTCH_SDFT_SIZE, analyzer.getBinWidth());
+}
+
+void test_recursion_stays_stable(void) {
+    // Muchas ventanas de un tono fuerte y luego una ventana de uno débil: si
+    // el redondeo se acumulara, el resto del primero taparía al segundo
+    analyzer.init(SAMPLE_RATE, MIN_HZ, MAX_HZ, 1, DYN_NOTCH_THRESHOLD, 1.0f);
+    const Tone strong[FILTER_AXES][2] = { { { 205.0f, 500.0f }, { 0, 0 } }, {}, {} };
+    const Tone weak[FILTER_AXES][2] = { { { 120.0f, 5.0f }, { 0, 0 } }, {}, {} };
+    feed(strong, 200000, 10.0f);
+    feed(weak, DYN_NOTCH_SDFT_SIZE, 0.0f);
+    analyzeAll();
+    TEST_ASSERT_FLOAT_WITHIN(0.25f * analyzer.getBinWidth(), 120.0f, analyzer.getPeak(0, 0));
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_single_tone_per_axis);
+    RUN_TEST(test_two_peaks_sorted_by_frequency);
+    RUN_TEST(test_noise_and_out_of_range_tones_are_ignored);
+    RUN_TEST(test_peaks_are_kept_when_the_tone_stops);
+    RUN_TEST(test_smoothing_tracks_frequency_changes);
+    RUN_TEST(test_step_round_robins_axes);
+    RUN_TEST(test_recursion_stays_stable);
+    return UNITY_END();
+}
@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include "SpscChannel.h"
+
+// Valor grande para que una copia a medias se note: todos los campos se
+// derivan de la secuencia
+struct Snapshot {
+    uint32_t sequence;
+    uint32_t words[31];
+};
+
+static void fill(Snapshot& snapshot, uint32_t sequence) {
+    snapshot.sequence = sequence;
+    for (int i = 0; i < 31; i++) {
+        snapshot.words[i] = sequence * 2654435761u + (uint32_t)i;
+    }
+}
+
+static bool isConsistent(const Snapshot& snapshot) {
+    for (int i = 0; i < 31; i++) {
+        if (snapshot.words[i] != snapshot.sequence * 2654435761u + (uint32_t)i) return false;
+    }
+    return true;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_consume_without_publish_returns_false(void) {
+    SpscChannel<int> channel;
+    int value = 7;
+    TEST_ASSERT_FALSE(channel.hasNew());
+    TEST_ASSERT_FALSE(channel.consume(value));
+    TEST_ASSERT_EQUAL_INT(7, value);
+}
+
+void test_consume_returns_latest_value_once(void) {
+    SpscChannel<int> channel;
+    channel.publish(1);
+    channel.publish(2);
+    channel.publish(3);
+    TEST_ASSERT_TRUE(channel.hasNew());
+
+    int value = 0;
+    TEST_ASSERT_TRUE(channel.consume(value));
+    TEST_ASSERT_EQUAL_INT(3, value);
+    TEST_ASSERT_FALSE(channel.consume(value));
+
+    channel.publish(4);
+    TEST_ASSERT_TRUE(channel.consume(value));
+    TEST_ASSERT_EQUAL_INT(4, value);
+}
+
+void test_interleaved_publish_and_consume(void) {
+    SpscChannel<int> channel;
+    int value = 0;
+    for (int i = 1; i <= 100; i++) {
+        channel.publish(i);
+        if (i % 3 == 0) {
+            TEST_ASSERT_TRUE(channel.consume(value));
+            TEST_ASSERT_EQUAL_INT(i, value);
+        }
+    }
+}
+
+void test_concurrent_snapshots_are_never_torn(void) {
+    static SpscChannel<Snapshot> channel;
+    const uint32_t publishes = 200000;
+    std::atomic<bool> done(false);
+
+    std::thread producer([&]() {
+        Snapshot snapshot;
+        for (uint32_t sequence = 1; sequence <= publishes; sequence++) {
+            fill(snapshot, sequence);
+            channel.publish(snapshot);
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    uint32_t torn = 0;
+    uint32_t backwards = 0;
+    uint32_t received = 0;
+    uint32_t last = 0;
+    Snapshot snapshot;
+    for (;;) {
+        bool finished = done.load(std::memory_order_acquire);
+        while (channel.consume(snapshot)) {
+            received++;
+            if (!isConsistent(snapshot)) torn++;
+            if (snapshot.sequence <= last) backwards++;
+            last = snapshot.sequence;
+        }
+        if (finished) break;
+    }
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, torn);
+    TEST_ASSERT_EQUAL_UINT32(0, backwards);
+    TEST_ASSERT_GREATER_THAN(0, received);
+    // El consumidor siempre acaba viendo el último valor publicado
+    TEST_ASSERT_EQUAL_UINT32(publishes, last);
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_consume_without_publish_returns_false);
+    RUN_TEST(test_consume_returns_latest_value_once);
+    RUN_TEST(test_interleaved_publish_and_consume);
+    RUN_TEST(test_concurrent_snapshots_are_never_torn);
+    return UNITY_END();
+}
@@ -0,0 +1,109 @@
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include "SpscRing.h"
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_push_is_all_or_nothing(void) {
+    SpscRing<int, 8> ring;
+    int items[6] = { 1, 2, 3, 4, 5, 6 };
+    TEST_ASSERT_TRUE(ring.push(items, 6));
+    TEST_ASSERT_FALSE(ring.push(items, 3));  // Sólo quedan 2 huecos
+    TEST_ASSERT_EQUAL_size_t(6, ring.size());
+    TEST_ASSERT_TRUE(ring.push(items, 2));
+    TEST_ASSERT_EQUAL_size_t(0, ring.space());
+
+    int out[8];
+    TEST_ASSERT_EQUAL_size_t(8, ring.pop(out, 8));
+    const int expected[8] = { 1, 2, 3, 4, 5, 6, 1, 2 };
+    TEST_ASSERT_EQUAL_INT_ARRAY(expected, out, 8);
+}
+
+void test_wraps_around_in_order(void) {
+    SpscRing<uint16_t, 4> ring;
+    uint16_t next = 0;
+    uint16_t expected = 0;
+    for (int round = 0; round < 1000; round++) {
+        while (ring.push(next)) next++;
+        uint16_t value;
+        for (int i = 0; i < 3 && ring.pop(value); i++) {
+            TEST_ASSERT_EQUAL_UINT16(expected, value);
+            expected++;
+        }
+    }
+}
+
+void test_byte_ring_requires_power_of_two_storage(void) {
+    static uint8_t storage[64];
+    SpscByteRing ring;
+    TEST_ASSERT_EQUAL_size_t(0, ring.capacity());
+    TEST_ASSERT_FALSE(ring.push(storage, 1));
+    TEST_ASSERT_FALSE(ring.attach(storage, 48));
+    TEST_ASSERT_FALSE(ring.attach(nullptr, 64));
+    TEST_ASSERT_TRUE(ring.attach(storage, 64));
+    TEST_ASSERT_EQUAL_size_t(64, ring.capacity());
+}
+
+void test_concurrent_frames_arrive_whole_and_in_order(void) {
+    static uint8_t storage[256];
+    static SpscByteRing ring;
+    TEST_ASSERT_TRUE(ring.attach(storage, sizeof(storage)));
+    const uint32_t frames = 100000;
+
+    // Trama: longitud, número de trama (4 bytes) y relleno derivado de ambos
+    std::thread producer([&]() {
+        uint8_t frame[40];
+        for (uint32_t sequence = 0; sequence < frames; sequence++) {
+            uint8_t length = (uint8_t)(5 + sequence % 35);
+            frame[0] = length;
+            for (int b = 0; b < 4; b++) frame[1 + b] = (uint8_t)(sequence >> (8 * b));
+            for (uint8_t i = 5; i < length; i++) frame[i] = (uint8_t)(sequence * 31 + i);
+            while (!ring.push(frame, length)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint8_t frame[40];
+    uint32_t expected = 0;
+    uint32_t corrupted = 0;
+    while (expected < frames) {
+        if (ring.pop(frame, 1) == 0) {
+            std::this_thread::yield();
+            continue;
+        }
+        // La trama entera ya está en la cola: el resto sale sin esperar
+        uint8_t length = frame[0];
+        if (length < 5 || length > 39 || ring.pop(frame + 1, length - 1) != (size_t)(length - 1)) {
+            corrupted++;
+            break;
+        }
+        uint32_t sequence = frame[1] | (frame[2] << 8) | (frame[3] << 16) | ((uint32_t)frame[4] << 24);
+        if (sequence != expected) corrupted++;
+        for (uint8_t i = 5; i < length; i++) {
+            if (frame[i] != (uint8_t)(sequence * 31 + i)) corrupted++;
+        }
+        expected++;
+    }
+    producer.join();
+
+    TEST_ASSERT_EQUAL_UINT32(0, corrupted);
+    TEST_ASSERT_EQUAL_UINT32(frames, expected);
+    TEST_ASSERT_EQUAL_size_t(0, ring.size());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_push_is_all_or_nothing);
+    RUN_TEST(test_wraps_around_in_order);
+    RUN_TEST(test_byte_ring_requires_power_of_two_storage);
+    RUN_TEST(test_concurrent_frames_arrive_whole_and_in_order);
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+#include <unity.h>
+#include <atomic>
+#include <thread>
+#include "StateBus.h"
+
+// Valor grande y de tamaño no múltiplo de 4: todos los campos se derivan
+// de `sequence`, así que una copia a medias se nota
+struct Snapshot {
+    uint32_t sequence;
+    uint32_t words[24];
+    uint8_t tail[3];
+};
+
+static void fill(Snapshot& snapshot, uint32_t sequence) {
+    snapshot.sequence = sequence;
+    for (int i = 0; i < 24; i++) snapshot.words[i] = sequence * 2654435761u + (uint32_t)i;
+    for (int i = 0; i < 3; i++) snapshot.tail[i] = (uint8_t)(sequence + i);
+}
+
+static bool isConsistent(const Snapshot& snapshot) {
+    for (int i = 0; i < 24; i++) {
+        if (snapshot.words[i] != snapshot.sequence * 2654435761u + (uint32_t)i) return false;
+    }
+    for (int i = 0; i < 3; i++) {
+        if (snapshot.tail[i] != (uint8_t)(snapshot.sequence + i)) return false;
+    }
+    return true;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+void test_unpublished_topic_reads_zero(void) {
+    Topic<AttitudeState> topic;
+    AttitudeState state = { 1.0f, 2.0f, 3.0f };
+    uint32_t stamp = 99;
+    TEST_ASSERT_EQUAL_UINT32(0, topic.read(state, &stamp));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, state.roll);
+    TEST_ASSERT_EQUAL_UINT32(0, stamp);
+}
+
+void test_read_returns_latest_snapshot_and_timestamp(void) {
+    Topic<Snapshot> topic;
+    Snapshot value;
+    fill(value, 7);
+    topic.publish(value, 1000);
+    fill(value, 8);
+    topic.publish(value, 2000);
+
+    Snapshot out;
+    uint32_t stamp = 0;
+    uint32_t sequence = topic.read(out, &stamp);
+    TEST_ASSERT_EQUAL_UINT32(4, sequence);  // Dos escrituras, siempre par
+    TEST_ASSERT_EQUAL_UINT32(topic.getSequence(), sequence);
+    TEST_ASSERT_EQUAL_UINT32(2000, stamp);
+    TEST_ASSERT_EQUAL_UINT32(8, out.sequence);
+    TEST_ASSERT_TRUE(isConsistent(out));
+}
+
+void test_subscriber_reports_new_snapshots(void) {
+    Topic<StatusState> topic;
+    Subscriber<StatusState> subscriber(topic);
+    StatusState status;
+    TEST_ASSERT_FALSE(subscriber.hasChanged());
+    TEST_ASSERT_FALSE(subscriber.read(status));
+
+    StatusState published = { true, true, 2 };
+    topic.publish(published, 10);
+    TEST_ASSERT_TRUE(subscriber.hasChanged());
+    TEST_ASSERT_TRUE(subscriber.read(status));
+    TEST_ASSERT_TRUE(status.armed);
+    TEST_ASSERT_EQUAL_UINT8(2, status.failsafe);
+
+    // Sin publicaciones nuevas sigue copiando la última
+    status.armed = false;
+    TEST_ASSERT_FALSE(subscriber.hasChanged());
+    TEST_ASSERT_FALSE(subscriber.read(status));
+    TEST_ASSERT_TRUE(status.armed);
+}
+
+// Un publicador y dos lectores sin pausas: ninguna instantánea rota, las
+// secuencias nunca retroceden y la marca de tiempo es la de esa publicación
+void test_concurrent_readers_never_see_torn_snapshots(void) {
+    static Topic<Snapshot> topic;
+    const uint32_t publishes = 200000;
+    std::atomic<bool> done(false);
+
+    struct ReaderStats {
+        uint32_t reads = 0;
+        uint32_t torn = 0;
+        uint32_t backwards = 0;
+        uint32_t wrongStamp = 0;
+        uint32_t last = 0;
+    };
+    ReaderStats stats[2];
+
+    auto reader = [&](ReaderStats& result) {
+        Subscriber<Snapshot> subscriber(topic);
+        Snapshot snapshot;
+        uint32_t stamp;
+        for (;;) {
+            bool finished = done.load(std::memory_order_acquire);
+            if (subscriber.read(snapshot, &stamp) && snapshot.sequence != 0) {
+                result.reads++;
+                if (!isConsistent(snapshot)) result.torn++;
+                if (snapshot.sequence < result.last) result.backwards++;
+                if (stamp != snapshot.sequence * 10u) result.wrongStamp++;
+                result.last = snapshot.sequence;
+            }
+            if (finished) break;
+        }
+    };
+
+    std::thread first(reader, std::ref(stats[0]));
+    std::thread second(reader, std::ref(stats[1]));
+
+    Snapshot snapshot;
+    for (uint32_t sequence = 1; sequence <= publishes; sequence++) {
+        fill(snapshot, sequence);
+        topic.publish(snapshot, sequence * 10u);
+    }
+    done.store(true, std::memory_order_release);
+    first.join();
+    second.join();
+
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL_UINT32(0, stats[i].torn);
+        TEST_ASSERT_EQUAL_UINT32(0, stats[i].backwards);
+        TEST_ASSERT_EQUAL_UINT32(0, stats[i].wrongStamp);
+        TEST_ASSERT_GREATER_THAN(0, stats[i].reads);
+        // La última lectura es posterior al final del publicador
+        TEST_ASSERT_EQUAL_UINT32(publishes, stats[i].last);
+    }
+    TEST_ASSERT_EQUAL_UINT32(2 * publishes, topic.getSequence());
+}
+
+int main(int argc, char** argv) {
+    (void)argc;
+    (void)argv;
+    UNITY_BEGIN();
+    RUN_TEST(test_unpublished_topic_reads_zero);
+    RUN_TEST(test_read_returns_latest_snapshot_and_timestamp);
+    RUN_TEST(test_subscriber_reports_new_snapshots);
+    RUN_TEST(test_concurrent_readers_never_see_torn_snapshots);
+    return UNITY_END();
+}
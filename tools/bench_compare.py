@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""Compara dos ejecuciones de los benchmarks del lazo de control.
+
+Uso:
+    bench_compare.py base.log nuevo.log [--threshold 10]
+
+Los ficheros pueden ser capturas del puerto serie o la salida de
+"pio run -e native_bench -t exec": sólo se leen las líneas JSON con "bench"
+(ver src/Benchmark.cpp). Se comparan ciclos si las dos ejecuciones los
+tienen (placa) y ns por llamada si no (host). Sale con código 1 si algún
+núcleo es más lento que la base en más del umbral (en %).
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    results = {}
+    suite = {}
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                entry = json.loads(line)
+            except ValueError:
+                continue
+            if "bench" in entry:
+                results[entry["bench"]] = entry
+            elif "suite" in entry:
+                suite = entry
+    return suite, results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("base")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="regresión máxima admitida en %% (por defecto 10)")
+    args = parser.parse_args()
+
+    base_suite, base = load(args.base)
+    current_suite, current = load(args.current)
+    base_target = base_suite.get("target", "esp32")
+    current_target = current_suite.get("target", "esp32")
+    if base_target != current_target:
+        print(f"aviso: se compara {base_target} con {current_target}", file=sys.stderr)
+    metric = "cycles_per_op" if base_target == current_target == "esp32" else "ns_per_op"
+    if metric == "cycles_per_op" and base_suite.get("cpu_mhz") != current_suite.get("cpu_mhz"):
+        print("aviso: frecuencias de CPU distintas, se comparan ciclos", file=sys.stderr)
+
+    regressions = 0
+    print(f"{'núcleo':<18} {'base':>10} {'actual':>10} {'cambio':>8}")
+    for name in sorted(set(base) | set(current)):
+        if name not in base or name not in current:
+            state = "nuevo" if name not in base else "eliminado"
+            print(f"{name:<18} {'':>10} {'':>10} {state:>8}")
+            continue
+        before = base[name][metric]
+        after = current[name][metric]
+        change = (after - before) / before * 100.0 if before else 0.0
+        mark = ""
+        if change > args.threshold:
+            mark = "  REGRESIÓN"
+            regressions += 1
+        print(f"{name:<18} {before:>10.1f} {after:>10.1f} {change:>+7.1f}%{mark}")
+
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+"""Decodifica el registro de vuelo (blackbox) a CSV.
+
+Uso:
+    esptool.py read_flash 0x310000 0xF0000 blackbox.bin
+    blackbox_decode.py blackbox.bin > vuelo.csv
+    blackbox_decode.py blackbox.bin --session 2 -o vuelo2.csv
+
+La imagen es la partición "blackbox" de partitions.csv. Cada armado abre una
+sesión con su propia cabecera (ver include/BlackboxEncoder.h); se decodifican
+todas salvo que se elija una con --session. La columna "session" las separa.
+"""
+
+import argparse
+import csv
+import sys
+
+MAGIC = b"BBX1"
+VERSION = 1
+KEYFRAME = ord("I")
+DELTA = ord("P")
+SECTOR_SIZE = 4096
+
+
+def read_varint(data, pos):
+    value = shift = 0
+    while True:
+        if pos >= len(data) or shift > 28:
+            raise ValueError("varint truncado")
+        byte = data[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def zigzag_decode(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def to_int32(value):
+    value &= 0xFFFFFFFF
+    return value - (1 << 32) if value & 0x80000000 else value
+
+
+def parse_header(data, pos):
+    if data[pos:pos + 4] != MAGIC or pos + 8 > len(data):
+        return None
+    version, count = data[pos + 4], data[pos + 5]
+    rate = data[pos + 6] | (data[pos + 7] << 8)
+    if version != VERSION or count == 0:
+        return None
+    pos += 8
+    fields = []
+    for _ in range(count):
+        end = data.find(b"\x00", pos)
+        if end < 0:
+            return None
+        name, _, scale = data[pos:end].decode("ascii", "replace").partition(":")
+        fields.append((name, int(scale) if scale.isdigit() else 1))
+        pos = end + 1
+    return fields, rate, pos
+
+
+def parse_records(data, pos, count):
+    """Genera (valores, es_keyframe) hasta el final de la sesión."""
+    values = None
+    while pos < len(data):
+        kind = data[pos]
+        if kind not in (KEYFRAME, DELTA) or (kind == DELTA and values is None):
+            break
+        try:
+            cursor = pos + 1
+            raw = []
+            for _ in range(count):
+                varint, cursor = read_varint(data, cursor)
+                raw.append(zigzag_decode(varint))
+        except ValueError:
+            break  # Registro cortado (corte de alimentación o partición llena)
+        if kind == KEYFRAME:
+            values = raw
+        else:
+            values = [to_int32(prev + delta) for prev, delta in zip(values, raw)]
+        pos = cursor
+        yield values, kind == KEYFRAME, pos
+
+
+def sessions(data):
+    """Recorre la imagen y genera (campos, frecuencia, inicio de registros)."""
+    pos = 0
+    while pos < len(data):
+        header = parse_header(data, pos)
+        if header is None:
+            # Fin de la zona escrita o basura: saltar al siguiente sector
+            pos = (pos // SECTOR_SIZE + 1) * SECTOR_SIZE
+            continue
+        fields, rate, start = header
+        end = start
+        for _, _, end in parse_records(data, start, len(fields)):
+            pass
+        yield fields, rate, start
+        pos = end if end > pos else pos + 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("image", help="imagen de la partición blackbox")
+    parser.add_argument("--session", type=int, help="decodificar sólo esta sesión (desde 1)")
+    parser.add_argument("-o", "--output", help="fichero CSV (por defecto stdout)")
+    args = parser.parse_args()
+
+    with open(args.image, "rb") as f:
+        data = f.read()
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    header_written = None
+    total = 0
+    try:
+        for index, (fields, rate, start) in enumerate(sessions(data), 1):
+            if args.session is not None and index != args.session:
+                continue
+            names = [name for name, _ in fields]
+            if header_written != names:
+                writer.writerow(["session"] + names)
+                header_written = names
+            count = keyframes = 0
+            for values, keyframe, _ in parse_records(data, start, len(fields)):
+                row = [index] + [v if scale == 1 else v / scale
+                                 for v, (_, scale) in zip(values, fields)]
+                writer.writerow(row)
+                count += 1
+                keyframes += keyframe
+            total += count
+            print(f"sesión {index}: {count} registros ({keyframes} keyframes) a {rate} Hz",
+                  file=sys.stderr)
+    finally:
+        if out is not sys.stdout:
+            out.close()
+    print(f"total: {total} registros", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
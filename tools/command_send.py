@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Envía mandos absolutos al controlador de vuelo por el enlace serie.
+
+Uso:
+    command_send.py /dev/ttyUSB0 --throttle 20 --arm --rate 50 --duration 5
+    command_send.py mandos.bin --throttle 0 --count 10   # a fichero, para pruebas
+
+Cada trama es COBS con CRC16-CCITT (ver include/Framing.h) y va precedida
+y seguida de 0x00 (ver include/CommandParser.h). Los bytes fuera de tramas
+se siguen interpretando como teclas, así que se puede mezclar con el teclado.
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+FRAME_STICKS = 0x10
+FLAG_ARM = 0x01
+FLAG_ACRO = 0x02
+FLAG_KILL = 0x04
+COMMAND_FORMAT = struct.Struct("<BHhhhhB")
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index = 0
+    code = 1
+    for byte in data:
+        if byte == 0:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+        else:
+            out.append(byte)
+            code += 1
+            if code == 0xFF:
+                out[code_index] = code
+                code_index = len(out)
+                out.append(0)
+                code = 1
+    out[code_index] = code
+    return bytes(out)
+
+
+def encode_command(seq, throttle, roll, pitch, yaw, flags):
+    def fixed(value, low, high):
+        return int(round(max(low, min(high, value)) * 10))
+    payload = COMMAND_FORMAT.pack(FRAME_STICKS, seq & 0xFFFF,
+                                  fixed(throttle, 0, 100), fixed(roll, -100, 100),
+                                  fixed(pitch, -100, 100), fixed(yaw, -100, 100), flags)
+    crc = crc16(payload)
+    return b"\x00" + cobs_encode(payload + bytes([crc & 0xFF, crc >> 8])) + b"\x00"
+
+
+def open_sink(path, baud):
+    if path.startswith("/dev/") or path.upper().startswith("COM"):
+        import serial  # pyserial, sólo necesario para escribir al puerto
+        return serial.Serial(path, baud)
+    return open(path, "wb")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("sink", help="puerto serie o fichero de salida")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--throttle", type=float, default=0.0, help="0-100%%")
+    parser.add_argument("--roll", type=float, default=0.0, help="-100 a 100%%")
+    parser.add_argument("--pitch", type=float, default=0.0, help="-100 a 100%%")
+    parser.add_argument("--yaw", type=float, default=0.0, help="-100 a 100%%")
+    parser.add_argument("--arm", action="store_true", help="interruptor de armado activo")
+    parser.add_argument("--acro", action="store_true")
+    parser.add_argument("--kill", action="store_true", help="parada de emergencia")
+    parser.add_argument("--rate", type=float, default=50.0, help="tramas/s")
+    parser.add_argument("--duration", type=float, default=1.0, help="segundos")
+    parser.add_argument("--count", type=int, help="número de tramas (ignora --duration)")
+    args = parser.parse_args()
+
+    flags = ((FLAG_ARM if args.arm else 0) | (FLAG_ACRO if args.acro else 0) |
+             (FLAG_KILL if args.kill else 0))
+    count = args.count if args.count is not None else max(1, int(args.rate * args.duration))
+    period = 1.0 / args.rate if args.rate > 0 else 0.0
+
+    sink = open_sink(args.sink, args.baud)
+    try:
+        for seq in range(count):
+            sink.write(encode_command(seq, args.throttle, args.roll, args.pitch, args.yaw, flags))
+            sink.flush()
+            if period and hasattr(sink, "baudrate"):
+                time.sleep(period)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sink.close()
+    print(f"tramas enviadas: {count}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+"""Decodifica la telemetría binaria del controlador de vuelo a CSV.
+
+Uso:
+    telemetry_decode.py captura.bin > vuelo.csv
+    telemetry_decode.py /dev/ttyUSB0 --baud 115200 > vuelo.csv
+
+Las tramas son COBS terminadas en 0x00 con CRC16-CCITT (ver include/Framing.h
+e include/Telemetry.h). Las tramas corruptas o el texto intercalado se descartan.
+Los mensajes de log binarios (include/Log.h) se decodifican con la lista de
+mensajes de esa cabecera y se escriben en stderr.
+"""
+
+import argparse
+import csv
+import os
+import re
+import struct
+import sys
+
+FRAME_STATE = 0x01
+STATE_FORMAT = struct.Struct("<BHIH3h3h3h4h9h8HB")
+FRAME_LOG = 0x02
+LOG_FORMAT = struct.Struct("<BHI4I")
+LOG_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "include", "Log.h")
+LOG_ENTRY = re.compile(r'X\((\w+),\s*"(\w*)",\s*"((?:[^"\\]|\\.)*)"\)')
+
+COLUMNS = [
+    "seq", "timestamp_us", "loop_time_us",
+    "roll", "pitch", "yaw",
+    "roll_rate", "pitch_rate", "yaw_rate",
+    "accel_x", "accel_y", "accel_z",
+    "throttle", "roll_cmd", "pitch_cmd", "yaw_cmd",
+    "roll_p", "roll_i", "roll_d",
+    "pitch_p", "pitch_i", "pitch_d",
+    "yaw_p", "yaw_i", "yaw_d",
+    "motor1", "motor2", "motor3", "motor4",
+    "motor5", "motor6", "motor7", "motor8",
+    "armed", "arm_cmd", "disarm_cmd", "acro", "failsafe",
+]
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        block = data[i:i + code - 1]
+        if 0 in block:
+            return None
+        out += block
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def decode_frame(encoded):
+    decoded = cobs_decode(encoded)
+    if decoded is None or len(decoded) <= 2:
+        return None
+    payload, crc = decoded[:-2], decoded[-2] | (decoded[-1] << 8)
+    if crc16(payload) != crc:
+        return None
+    return payload
+
+
+def state_row(payload):
+    fields = STATE_FORMAT.unpack(payload)
+    seq, timestamp, loop_time = fields[1:4]
+    attitude = [v / 100.0 for v in fields[4:7]]
+    rates = [v / 10.0 for v in fields[7:10]]
+    accel = [v / 100.0 for v in fields[10:13]]
+    inputs = [v / 10.0 for v in fields[13:17]]
+    pid = [v / 10.0 for v in fields[17:26]]
+    motors = list(fields[26:34])
+    flags = fields[34]
+    return ([seq, timestamp, loop_time] + attitude + rates + accel + inputs +
+            pid + motors + [flags & 1, (flags >> 1) & 1, (flags >> 2) & 1, (flags >> 3) & 1,
+                            (flags >> 4) & 3])
+
+
+def load_log_messages(path):
+    """Lista (nombre, tipos, formato) en el orden de LOG_MESSAGE_LIST."""
+    with open(path, encoding="utf-8") as header:
+        lines = header.read().splitlines()
+    start = next(i for i, line in enumerate(lines) if line.startswith("#define LOG_MESSAGE_LIST"))
+    body = []
+    for line in lines[start + 1:]:
+        body.append(line)
+        if not line.rstrip().endswith("\\"):
+            break
+    return LOG_ENTRY.findall("\n".join(body))
+
+
+def log_line(payload, messages):
+    fields = LOG_FORMAT.unpack(payload)
+    message_id, timestamp, raw = fields[1], fields[2], fields[3:]
+    if message_id >= len(messages):
+        return f"[{timestamp / 1e6:.3f}] mensaje desconocido {message_id}"
+    _, types, text = messages[message_id]
+    args = []
+    for kind, value in zip(types, raw):
+        if kind == "f":
+            args.append(struct.unpack("<f", struct.pack("<I", value))[0])
+        elif kind == "i":
+            args.append(value - (1 << 32) if value & 0x80000000 else value)
+        else:
+            args.append(value)
+    return f"[{timestamp / 1e6:.3f}] {text % tuple(args)}"
+
+
+def open_source(path, baud):
+    if os.path.exists(path) and not path.startswith("/dev/"):
+        return open(path, "rb")
+    import serial  # pyserial, sólo necesario para leer del puerto
+    return serial.Serial(path, baud, timeout=1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="fichero capturado o puerto serie")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("-o", "--output", help="fichero CSV (por defecto stdout)")
+    parser.add_argument("--log-header", default=LOG_HEADER, help="cabecera con LOG_MESSAGE_LIST")
+    args = parser.parse_args()
+
+    messages = load_log_messages(args.log_header)
+
+    out = open(args.output, "w", newline="") if args.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(COLUMNS)
+
+    source = open_source(args.source, args.baud)
+    is_serial = hasattr(source, "baudrate")
+    buffer = bytearray()
+    good = bad = lost = logs = 0
+    last_seq = None
+
+    try:
+        while True:
+            chunk = source.read(4096)
+            if not chunk:
+                if is_serial:
+                    continue  # Timeout del puerto, seguir esperando
+                break
+            buffer += chunk
+            while True:
+                end = buffer.find(b"\x00")
+                if end < 0:
+                    break
+                encoded, buffer = bytes(buffer[:end]), buffer[end + 1:]
+                if not encoded:
+                    continue
+                payload = decode_frame(encoded)
+                if payload is not None and payload[0] == FRAME_LOG and len(payload) == LOG_FORMAT.size:
+                    print(log_line(payload, messages), file=sys.stderr)
+                    logs += 1
+                    continue
+                if payload is None or payload[0] != FRAME_STATE or len(payload) != STATE_FORMAT.size:
+                    bad += 1
+                    continue
+                row = state_row(payload)
+                if last_seq is not None:
+                    lost += (row[0] - last_seq - 1) & 0xFFFF
+                last_seq = row[0]
+                writer.writerow(row)
+                good += 1
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if out is not sys.stdout:
+            out.close()
+        print(f"tramas: {good} válidas, {bad} descartadas, {lost} perdidas, {logs} mensajes",
+              file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Convierte un volcado de traza (tecla 'G') al formato JSON de Chrome trace.
+
+Uso:
+    trace_to_chrome.py captura.log [-o traza.json]
+
+El fichero puede ser una captura del puerto serie: se leen las líneas entre
+TRACE_BEGIN y TRACE_END (ver src/Trace.cpp). El resultado se abre en
+https://ui.perfetto.dev o en chrome://tracing. Los eventos con el mismo id de
+correlación se unen con flechas (flujo UART -> motores) y la latencia
+uartRx -> motorWrite se resume por stderr.
+"""
+
+import argparse
+import json
+import sys
+
+THREAD_NAMES = {0: "comms (núcleo 0)", 1: "control (núcleo 1)"}
+
+
+def load(path):
+    cpu_mhz = None
+    events = {}
+    with open(path, encoding="utf-8", errors="replace") as f:
+        for line in f:
+            line = line.strip()
+            if line.startswith("TRACE_BEGIN"):
+                fields = dict(item.split("=", 1) for item in line.split()[1:] if "=" in item)
+                cpu_mhz = float(fields.get("cpu_mhz", 240))
+                events = {}
+                continue
+            if cpu_mhz is None or not line.startswith("T,"):
+                continue
+            parts = line.split(",")
+            if len(parts) != 6:
+                continue
+            try:
+                core, cycles, phase, name, corr = int(parts[1]), int(parts[2]), parts[3], parts[4], int(parts[5])
+            except ValueError:
+                continue
+            events.setdefault(core, []).append((cycles, phase, name, corr))
+    if cpu_mhz is None:
+        raise SystemExit("no se encontró TRACE_BEGIN en la captura")
+    return cpu_mhz, events
+
+
+def to_microseconds(core_events, cpu_mhz):
+    """Deshace el desbordamiento del contador de ciclos y pasa a micros().
+
+    Cada núcleo tiene su propio contador; los eventos clockSync llevan la hora
+    común (micros()) en el campo de correlación y sirven de ancla.
+    """
+    unwrapped = []
+    offset = 0
+    previous = None
+    for cycles, phase, name, corr in core_events:
+        if previous is not None and cycles < previous:
+            offset += 1 << 32
+        previous = cycles
+        unwrapped.append((cycles + offset, phase, name, corr))
+
+    anchors = [(c, corr) for c, phase, name, corr in unwrapped if name == "clockSync"]
+    if not anchors:
+        print("aviso: núcleo sin clockSync, tiempos relativos", file=sys.stderr)
+        anchors = [(unwrapped[0][0], 0)] if unwrapped else []
+
+    result = []
+    anchor = 0
+    for cycles, phase, name, corr in unwrapped:
+        if name == "clockSync":
+            continue
+        while anchor + 1 < len(anchors) and anchors[anchor + 1][0] <= cycles:
+            anchor += 1
+        anchor_cycles, anchor_us = anchors[anchor]
+        result.append(((cycles - anchor_cycles) / cpu_mhz + anchor_us, phase, name, corr))
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture")
+    parser.add_argument("-o", "--output", default="trace.json")
+    args = parser.parse_args()
+
+    cpu_mhz, raw = load(args.capture)
+    trace = []
+    flows = {}
+    for core in sorted(raw):
+        trace.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": core,
+                      "args": {"name": THREAD_NAMES.get(core, f"núcleo {core}")}})
+        for ts, phase, name, corr in to_microseconds(raw[core], cpu_mhz):
+            event = {"name": name, "ph": phase, "ts": ts, "pid": 0, "tid": core}
+            if phase == "i":
+                event["s"] = "t"
+            if corr:
+                event["args"] = {"corr": corr}
+                # El mando se repite en cada tick hasta el siguiente: sólo
+                # la primera aparición de cada evento entra en el flujo
+                points = flows.setdefault(corr, [])
+                if phase in ("B", "i") and all(name != seen for _, _, seen in points):
+                    points.append((ts, core, name))
+            trace.append(event)
+
+    # Flechas entre eventos de la misma correlación, en orden temporal
+    latencies = []
+    for corr, points in flows.items():
+        points.sort()
+        for i, (ts, core, name) in enumerate(points):
+            phase = "s" if i == 0 else ("f" if i == len(points) - 1 else "t")
+            flow = {"name": "mando", "cat": "flow", "ph": phase, "id": corr,
+                    "ts": ts, "pid": 0, "tid": core}
+            if phase == "f":
+                flow["bp"] = "e"
+            if len(points) > 1:
+                trace.append(flow)
+        rx = [ts for ts, core, name in points if name == "uartRx"]
+        motor = [ts for ts, core, name in points if name == "motorWrite"]
+        if rx and motor:
+            latencies.append(min(motor) - min(rx))
+
+    with open(args.output, "w", encoding="utf-8") as f:
+        json.dump({"traceEvents": trace, "displayTimeUnit": "ns"}, f)
+
+    count = sum(len(events) for events in raw.values())
+    print(f"{count} eventos, {len(flows)} correlaciones -> {args.output}", file=sys.stderr)
+    if latencies:
+        latencies.sort()
+        p95 = latencies[min(len(latencies) - 1, int(len(latencies) * 0.95))]
+        print(f"latencia uartRx -> motorWrite: n={len(latencies)} "
+              f"min={latencies[0]:.1f} us mediana={latencies[len(latencies) // 2]:.1f} us "
+              f"p95={p95:.1f} us max={latencies[-1]:.1f} us", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()